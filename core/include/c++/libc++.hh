@@ -64,6 +64,7 @@
 #include <codecvt>
 #include <map>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
 #include <numeric>
 #include <optional>
@@ -182,7 +182,7 @@ class $function<Rt(Tp...)> {
     };
 
     template <typename T>
-    struct Callable : $callable {
+    struct Callable : $callable, std::Memory::SmallObject {
         alignas(alignof(libcxx::max_align_t)) T callable;
 
         constexpr Callable(typename std::Meta::reference_removed<T>
@@ -197,7 +197,7 @@ class $function<Rt(Tp...)> {
         }
 
         constexpr $callable *clone() const override {
-            return std::Memory::new_aligned<Callable<T>>(callable);
+            return new Callable<T>(callable);
         }
     };
 
@@ -218,17 +218,16 @@ class $function<Rt(Tp...)> {
     template <typename T>
     constexpr $function(
         typename std::Meta::reference_removed<T> $call_o) {  // NOLINT(google-explicit-constructor)
-        callable = std::Memory::new_aligned<Callable<libcxx::decay_t<T>>>(std::Memory::forward<T>($call_o));  // NOLINT
+        callable = new Callable<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));  // NOLINT
     }
 
     template <typename T>
     constexpr $function(T $call_o) {  // NOLINT(google-explicit-constructor)
-        callable = std::Memory::new_aligned<Callable<libcxx::decay_t<T>>>(std::Memory::forward<T>($call_o));  // NOLINT
+        callable = new Callable<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));  // NOLINT
     }
 
     constexpr $function(Rt (*func)(Tp...))  // NOLINT(google-explicit-constructor)
-        : callable(func ? std::Memory::new_aligned<Callable<Rt(*)(Tp...)>>(func)
-                        : nullptr) {}
+        : callable(func ? new Callable<Rt(*)(Tp...)>(func) : nullptr) {}
 
     ~$function() { reset(); }
 
@@ -253,16 +252,15 @@ class $function<Rt(Tp...)> {
 
     template <typename T>
     constexpr $function &operator=(T $call_o) {
-        std::Memory::delete_aligned(callable);
-        callable = std::Memory::new_aligned<Callable<libcxx::decay_t<T>>>(std::Memory::forward<T>($call_o));  // NOLINT
+        delete callable;
+        callable = new Callable<libcxx::decay_t<T>>(std::Memory::forward<T>($call_o));  // NOLINT
         return *this;
     }
 
     // Assignment for function pointers
     constexpr $function &operator=(Rt (*func)(Tp...)) {
-        std::Memory::delete_aligned(callable);
-        callable = func ? std::Memory::new_aligned<Callable<Rt(*)(Tp...)>>(func)
-                        : nullptr;
+        delete callable;
+        callable = func ? new Callable<Rt(*)(Tp...)>(func) : nullptr;
         return *this;
     }
 
@@ -279,12 +277,20 @@ class $function<Rt(Tp...)> {
 
     constexpr void reset() noexcept {
         if (callable) {
-            std::Memory::delete_aligned(callable);
+            delete callable;
             callable = nullptr;
         }
     }
 };
 
+H_STD_NAMESPACE_BEGIN
+namespace Memory {
+/// a $function is one pointer to its heap-allocated callable.
+template <typename Rt, typename... Tp>
+struct is_trivially_relocatable<$function<Rt(Tp...)>> : libcxx::true_type {};
+}  // namespace Memory
+H_STD_NAMESPACE_END
+
 H_NAMESPACE_END
 
 #endif  // _$_HX_CORE_M13FUNCTION_IMPL
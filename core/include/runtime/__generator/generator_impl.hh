@@ -136,6 +136,12 @@ class $generator {
         void                     await_transform() = delete;
         [[noreturn]] static void unhandled_exception() { throw; }
 
+        // small coroutine frames come from the small-object pool, larger ones from global new
+        static void *operator new(usize size) { return std::Memory::small_alloc(size); }
+        static void  operator delete(void *ptr, usize size) noexcept {
+            std::Memory::small_free(ptr, size);
+        }
+
         libcxx::optional<T> current_value;
     };
 
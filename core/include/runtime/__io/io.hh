@@ -18,5 +18,9 @@
 #include <include/runtime/__io/__print/endl.hh>
 #include <include/runtime/__io/__print/stringf.hh>
 #include <include/runtime/__io/system.hh>
+#include <include/runtime/__io/process_pool.hh>
+#include <include/runtime/__io/pipeline.hh>
+#include <include/runtime/__io/shared_channel.hh>
+#include <include/runtime/__io/mapped_file.hh>
 
 #endif  // _$_HX_CORE_M2IO
@@ -0,0 +1,558 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M11MAPPED_FILE
+#define _$_HX_CORE_M11MAPPED_FILE
+
+#include <include/config/config.hh>
+#include <include/runtime/__error/runtime_error.hh>
+#include <include/types/string/string.hh>
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+#   define KAIRO_MAPPED_FILE_WIN32 1
+#else
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <fcntl.h>
+#   include <unistd.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+/// a file mapped into memory, unmapped when the object goes away. the contents are read in place
+/// (no read() calls, no copies) and page in on first touch, so large read-mostly inputs cost only
+/// the pages actually looked at.
+///
+/// writers (ReadWrite / Create) can grow the mapping with resize(), reserve() and append(). the
+/// file is extended geometrically ahead of size() while it is open and trimmed back to size() by
+/// close(); on linux the mapping grows with mremap, elsewhere it is unmapped and mapped again, so
+/// pointers into the data are invalidated by any call that grows it.
+///
+/// advise() forwards access-pattern hints to the kernel (madvise). hints are best effort: a hint
+/// the platform or filesystem does not support returns false and changes nothing.
+///
+/// example:
+///   auto log = Memory::MappedFile::open(L"build.log", Memory::MappedFile::Mode::Read);
+///   log.advise(Memory::MappedFile::Advice::Sequential);
+///   usize lines = libcxx::count(log.bytes().begin(), log.bytes().end(), u8('\n'));
+///
+///   auto out = Memory::MappedFile::open(L"out.bin", Memory::MappedFile::Mode::Create);
+///   out.append(header, sizeof(header));
+///   out.close();  // file is now exactly sizeof(header) bytes
+class MappedFile {
+  public:
+    enum class Mode : u8 {
+        Read,       // read-only view of an existing file
+        ReadWrite,  // shared view of an existing file; writes reach the file
+        Create,     // like ReadWrite, but creates the file or truncates it first
+        Private     // copy-on-write view of an existing file; writes stay in this process
+    };
+
+    enum class Advice : u8 {
+        Normal,
+        Sequential,  // read ahead aggressively, drop pages soon after they are read
+        Random,      // no read-ahead
+        WillNeed,    // start reading the range in now
+        DontNeed,    // the range will not be touched again soon; private writes are discarded
+        HugePage     // back the range with transparent huge pages where the filesystem allows
+    };
+
+    struct Options {
+        bool  populate = false;  // fault every page in at open (MAP_POPULATE)
+        u64   offset   = 0;      // first byte of the file to map
+        usize length   = 0;      // bytes to map; 0 maps to the end of the file
+    };
+
+    MappedFile() = default;
+
+    MappedFile(const MappedFile &)            = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept { take(other); }
+
+    MappedFile &operator=(MappedFile &&other) noexcept {
+        if (this != &other) {
+            close();
+            take(other);
+        }
+        return *this;
+    }
+
+    ~MappedFile() { close(); }
+
+    static MappedFile open(const string &path, Mode mode) { return open(path, mode, Options()); }
+
+    /// map `path`. throws runtime_error if the file cannot be opened or mapped, or if a fixed
+    /// range lies past the end of a file that is not opened for writing (writers extend it).
+    static MappedFile open(const string &path, Mode mode, const Options &options) {
+        MappedFile file;
+        file.mode_     = mode;
+        file.offset_   = options.offset;
+        file.to_end_   = options.length == 0;
+        file.populate_ = options.populate;
+
+        file.open_file(path);
+
+        const u64 file_size = file.file_size();
+        if (options.offset > file_size && !file.shared_writable()) {
+            throw libcxx::runtime_error("MappedFile: offset " + libcxx::to_string(options.offset) +
+                                        " is past the end of '" + string_to_cstring(path) + "'");
+        }
+
+        usize length = options.length;
+        if (file.to_end_) {
+            length = options.offset < file_size ? static_cast<usize>(file_size - options.offset)
+                                                : 0;
+        }
+
+        if (options.offset + length > file_size) {
+            if (!file.shared_writable()) {
+                throw libcxx::runtime_error("MappedFile: range is past the end of '" +
+                                            string_to_cstring(path) + "'");
+            }
+            file.truncate_file(options.offset + length);
+        }
+
+        file.map(length);
+        file.size_ = length;
+
+#if !defined(MAP_POPULATE)
+        if (file.populate_) {
+            file.advise(Advice::WillNeed);
+        }
+#endif
+        return file;
+    }
+
+    bool is_open() const noexcept {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        return file_ != INVALID_HANDLE_VALUE;
+#else
+        return fd_ >= 0;
+#endif
+    }
+
+    Mode  mode() const noexcept { return mode_; }
+    bool  writable() const noexcept { return is_open() && mode_ != Mode::Read; }
+    usize size() const noexcept { return size_; }
+    usize capacity() const noexcept { return capacity_; }
+    bool  is_empty() const noexcept { return size_ == 0; }
+
+    const u8 *data() const noexcept { return base_ != nullptr ? base_ + delta_ : nullptr; }
+
+    libcxx::span<const u8> bytes() const noexcept { return {data(), size_}; }
+
+    /// throws if the mapping is read-only.
+    libcxx::span<u8> mutable_bytes() {
+        if (!writable()) {
+            throw libcxx::runtime_error("MappedFile: mapping is read-only");
+        }
+        return {base_ != nullptr ? base_ + delta_ : nullptr, size_};
+    }
+
+    nstring::slice text() const noexcept {
+        return size_ != 0 ? nstring::slice(reinterpret_cast<const char *>(data()), size_)
+                          : nstring::slice("", 0);
+    }
+
+    /// hint how [offset, offset + length) will be accessed; the range is clamped to the mapping
+    /// and widened to whole pages. returns false if the hint is not supported here.
+    bool advise(Advice advice, usize offset = 0, usize length = usize(-1)) noexcept {
+        if (base_ == nullptr || offset >= capacity_) {
+            return false;
+        }
+
+        length = libcxx::min(length, capacity_ - offset);
+
+        const usize page  = page_size();
+        u8         *first = base_ + ((delta_ + offset) & ~(page - 1));
+        u8         *last  = base_ + delta_ + offset + length;
+
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        (void)first;
+        (void)last;
+        (void)advice;
+        return false;
+#else
+        int hint = 0;
+        switch (advice) {
+            case Advice::Normal:
+                hint = MADV_NORMAL;
+                break;
+            case Advice::Sequential:
+                hint = MADV_SEQUENTIAL;
+                break;
+            case Advice::Random:
+                hint = MADV_RANDOM;
+                break;
+            case Advice::WillNeed:
+                hint = MADV_WILLNEED;
+                break;
+            case Advice::DontNeed:
+                hint = MADV_DONTNEED;
+                break;
+            case Advice::HugePage:
+#   if defined(MADV_HUGEPAGE)
+                hint = MADV_HUGEPAGE;
+                break;
+#   else
+                return false;
+#   endif
+        }
+
+        return ::madvise(first, static_cast<usize>(last - first), hint) == 0;
+#endif
+    }
+
+    /// make room for `capacity` bytes without changing size(). writers only.
+    void reserve(usize capacity) {
+        if (capacity <= capacity_) {
+            return;
+        }
+
+        require_growable();
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        unmap();  // the section has to be recreated at the new size anyway
+#endif
+        truncate_file(offset_ + capacity);
+        remap(capacity);
+    }
+
+    /// grow or shrink the data to `size` bytes; new bytes read as zero. writers only.
+    void resize(usize size) {
+        usize old   = size_;
+        usize dirty = libcxx::min(size, capacity_);  // past capacity_ the file was just extended
+        grow_to(size);
+        if (dirty > old) {
+            // a shrink only moved size_, so these bytes still hold what was there before
+            libcxx::memset(base_ + delta_ + old, 0, dirty - old);
+        }
+    }
+
+    /// copy `count` bytes to the end of the data. writers only.
+    void append(const void *src, usize count) {
+        usize at = size_;
+        grow_to(size_ + count);
+        if (count != 0) {
+            libcxx::memcpy(base_ + delta_ + at, src, count);
+        }
+    }
+
+    void append(libcxx::span<const u8> src) { append(src.data(), src.size()); }
+
+    /// flush written pages to the file. a no-op for read-only and private mappings.
+    void sync(bool wait = true) {
+        if (base_ == nullptr || !shared_writable()) {
+            return;
+        }
+
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        if (!::FlushViewOfFile(base_, mapped_) || (wait && !::FlushFileBuffers(file_))) {
+            throw libcxx::runtime_error("MappedFile: flush failed! Error: " +
+                                        libcxx::to_string(::GetLastError()));
+        }
+#else
+        if (::msync(base_, mapped_, wait ? MS_SYNC : MS_ASYNC) != 0) {
+            throw libcxx::runtime_error("MappedFile: msync failed: " +
+                                        libcxx::string(String::error(errno)));
+        }
+#endif
+    }
+
+    /// unmap and close. a writer that grew the file trims it back to size().
+    void close() noexcept {
+        if (!is_open()) {
+            return;
+        }
+
+        unmap();
+
+        if (shared_writable() && to_end_ && capacity_ != size_) {
+            try {
+                truncate_file(offset_ + size_);
+            } catch (...) {}  // nothing useful to do with it here; the data is intact
+        }
+
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        ::CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        ::close(fd_);
+        fd_ = -1;
+#endif
+        size_     = 0;
+        capacity_ = 0;
+    }
+
+  private:
+    static usize page_size() noexcept {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        static const usize page = [] {
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            return static_cast<usize>(info.dwPageSize);
+        }();
+#else
+        static const usize page = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+#endif
+        return page;
+    }
+
+    /// alignment the file offset of a mapping must have.
+    static usize granularity() noexcept {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        static const usize gran = [] {
+            SYSTEM_INFO info;
+            ::GetSystemInfo(&info);
+            return static_cast<usize>(info.dwAllocationGranularity);
+        }();
+        return gran;
+#else
+        return page_size();
+#endif
+    }
+
+    bool shared_writable() const noexcept {
+        return mode_ == Mode::ReadWrite || mode_ == Mode::Create;
+    }
+
+    void require_growable() const {
+        if (!shared_writable()) {
+            throw libcxx::runtime_error("MappedFile: only ReadWrite and Create mappings can grow");
+        }
+        if (!to_end_) {
+            throw libcxx::runtime_error("MappedFile: a fixed-length mapping cannot grow");
+        }
+    }
+
+    // set size_, extending the file first if it is past capacity_. bytes between the old and
+    // new size are left as they are.
+    void grow_to(usize size) {
+        require_growable();
+        if (size > capacity_) {
+            // geometric growth keeps a run of appends amortised O(1) in remaps
+            reserve(libcxx::max({size, capacity_ * 2, page_size() * 16}));
+        }
+        size_ = size;
+    }
+
+    void take(MappedFile &other) noexcept {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        file_    = libcxx::exchange(other.file_, INVALID_HANDLE_VALUE);
+        section_ = libcxx::exchange(other.section_, nullptr);
+#else
+        fd_ = libcxx::exchange(other.fd_, -1);
+#endif
+        base_     = libcxx::exchange(other.base_, nullptr);
+        mapped_   = libcxx::exchange(other.mapped_, 0);
+        delta_    = libcxx::exchange(other.delta_, 0);
+        size_     = libcxx::exchange(other.size_, 0);
+        capacity_ = libcxx::exchange(other.capacity_, 0);
+        offset_   = other.offset_;
+        mode_     = other.mode_;
+        to_end_   = other.to_end_;
+        populate_ = other.populate_;
+    }
+
+    void open_file(const string &path) {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        DWORD access = GENERIC_READ | (shared_writable() ? GENERIC_WRITE : 0);
+        DWORD create = (mode_ == Mode::Create) ? CREATE_ALWAYS : OPEN_EXISTING;
+
+        file_ = ::CreateFileW(path.raw(), access, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                              create, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) {
+            throw libcxx::runtime_error("MappedFile: cannot open '" + string_to_cstring(path) +
+                                        "'! Error: " + libcxx::to_string(::GetLastError()));
+        }
+#else
+        int flags = O_CLOEXEC;
+        switch (mode_) {
+            case Mode::Read:
+            case Mode::Private:
+                flags |= O_RDONLY;
+                break;
+            case Mode::ReadWrite:
+                flags |= O_RDWR;
+                break;
+            case Mode::Create:
+                flags |= O_RDWR | O_CREAT | O_TRUNC;
+                break;
+        }
+
+        const cstring narrow = string_to_cstring(path);
+        fd_                  = ::open(narrow.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            throw libcxx::runtime_error("MappedFile: cannot open '" + narrow +
+                                        "': " + libcxx::string(String::error(errno)));
+        }
+#endif
+    }
+
+    u64 file_size() const {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        LARGE_INTEGER size;
+        if (!::GetFileSizeEx(file_, &size)) {
+            throw libcxx::runtime_error("MappedFile: GetFileSizeEx failed! Error: " +
+                                        libcxx::to_string(::GetLastError()));
+        }
+        return static_cast<u64>(size.QuadPart);
+#else
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            throw libcxx::runtime_error("MappedFile: fstat failed: " +
+                                        libcxx::string(String::error(errno)));
+        }
+        return static_cast<u64>(st.st_size);
+#endif
+    }
+
+    // callers unmap first on windows, where a file with a mapped view cannot shrink
+    void truncate_file(u64 size) {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        LARGE_INTEGER to;
+        to.QuadPart = static_cast<LONGLONG>(size);
+        if (!::SetFilePointerEx(file_, to, nullptr, FILE_BEGIN) || !::SetEndOfFile(file_)) {
+            throw libcxx::runtime_error("MappedFile: cannot resize file! Error: " +
+                                        libcxx::to_string(::GetLastError()));
+        }
+#else
+        if (::ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+            throw libcxx::runtime_error("MappedFile: ftruncate failed: " +
+                                        libcxx::string(String::error(errno)));
+        }
+#endif
+    }
+
+    /// map `capacity` bytes starting at offset_. an empty range maps nothing.
+    void map(usize capacity) {
+        const u64 aligned = offset_ & ~static_cast<u64>(granularity() - 1);
+
+        delta_ = static_cast<usize>(offset_ - aligned);
+        if (capacity == 0) {
+            capacity_ = 0;
+            return;
+        }
+
+        const usize total = delta_ + capacity;
+
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        DWORD protect = PAGE_READONLY;
+        DWORD access  = FILE_MAP_READ;
+        if (shared_writable()) {
+            protect = PAGE_READWRITE;
+            access  = FILE_MAP_WRITE;
+        } else if (mode_ == Mode::Private) {
+            protect = PAGE_WRITECOPY;
+            access  = FILE_MAP_COPY;
+        }
+
+        const u64 end = aligned + total;
+        section_      = ::CreateFileMappingW(file_, nullptr, protect, DWORD(end >> 32),
+                                        DWORD(end & 0xFFFFFFFFu), nullptr);
+        if (section_ == nullptr) {
+            throw libcxx::runtime_error("MappedFile: CreateFileMapping failed! Error: " +
+                                        libcxx::to_string(::GetLastError()));
+        }
+
+        void *view = ::MapViewOfFile(section_, access, DWORD(aligned >> 32),
+                                     DWORD(aligned & 0xFFFFFFFFu), total);
+        if (view == nullptr) {
+            DWORD err = ::GetLastError();
+            ::CloseHandle(section_);
+            section_ = nullptr;
+            throw libcxx::runtime_error("MappedFile: MapViewOfFile failed! Error: " +
+                                        libcxx::to_string(err));
+        }
+#else
+        int prot  = PROT_READ | (mode_ != Mode::Read ? PROT_WRITE : 0);
+        int flags = (mode_ == Mode::Private) ? MAP_PRIVATE : MAP_SHARED;
+#   if defined(MAP_POPULATE)
+        if (populate_) {
+            flags |= MAP_POPULATE;
+        }
+#   endif
+
+        void *view = ::mmap(nullptr, total, prot, flags, fd_, static_cast<off_t>(aligned));
+        if (view == MAP_FAILED) {
+            throw libcxx::runtime_error("MappedFile: mmap failed: " +
+                                        libcxx::string(String::error(errno)));
+        }
+#endif
+
+        base_     = static_cast<u8 *>(view);
+        mapped_   = total;
+        capacity_ = capacity;
+    }
+
+    void unmap() noexcept {
+        if (base_ != nullptr) {
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+            ::UnmapViewOfFile(base_);
+#else
+            ::munmap(base_, mapped_);
+#endif
+        }
+
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+        if (section_ != nullptr) {
+            ::CloseHandle(section_);
+            section_ = nullptr;
+        }
+#endif
+        base_   = nullptr;
+        mapped_ = 0;
+    }
+
+    /// move the mapping to cover `capacity` bytes; the file is already that long.
+    void remap(usize capacity) {
+#if defined(__linux__)
+        if (base_ != nullptr) {
+            void *grown = ::mremap(base_, mapped_, delta_ + capacity, MREMAP_MAYMOVE);
+            if (grown == MAP_FAILED) {
+                throw libcxx::runtime_error("MappedFile: mremap failed: " +
+                                            libcxx::string(String::error(errno)));
+            }
+
+            base_     = static_cast<u8 *>(grown);
+            mapped_   = delta_ + capacity;
+            capacity_ = capacity;
+            return;
+        }
+#endif
+        unmap();
+        map(capacity);
+    }
+
+#if defined(KAIRO_MAPPED_FILE_WIN32)
+    HANDLE file_    = INVALID_HANDLE_VALUE;
+    HANDLE section_ = nullptr;
+#else
+    int fd_ = -1;
+#endif
+    u8   *base_     = nullptr;  // start of the mapping, at a granularity boundary
+    usize mapped_   = 0;        // bytes mapped from base_
+    usize delta_    = 0;        // offset_ minus its aligned-down value; data starts here
+    usize size_     = 0;
+    usize capacity_ = 0;  // bytes mapped from data()
+    u64   offset_   = 0;
+    Mode  mode_     = Mode::Read;
+    bool  to_end_   = true;  // the mapping runs to the end of the file, so it may grow
+    bool  populate_ = false;
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M11MAPPED_FILE
@@ -0,0 +1,283 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M8PIPELINE
+#define _$_HX_CORE_M8PIPELINE
+
+#include <include/config/config.hh>
+#include <include/runtime/__io/system.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// `cmd1 | cmd2 | cmd3` without a shell. each stage's stdout is a pipe straight into the next
+/// stage's stdin, so intermediate data never passes through this process; only the last stage
+/// is captured (same as Subprocess::spawn). intermediate stages share our stderr.
+///
+/// stdin of the first stage can come from bytes we hold (written from a writer thread, via
+/// vmsplice on linux), from an fd or from a file; fds and files are handed to the child as its
+/// stdin directly, so the kernel reads them without us copying anything.
+///
+/// example:
+///   auto out = Pipeline()
+///                  .then({L"zcat", L"access.log.gz"})
+///                  .then({L"grep", L"POST"})
+///                  .then({L"wc", L"-l"})
+///                  .run();
+class Pipeline {
+  public:
+    Pipeline() = default;
+
+    Pipeline(const Pipeline &)            = delete;
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    ~Pipeline() {
+        try {
+            terminate();
+        } catch (...) {}  // NOLINT(bugprone-empty-catch)
+    }
+
+    // append a stage that exec's argv directly.
+    Pipeline &then(vec<string> argv) {
+        stages_.push_back(std::Memory::move(argv));
+        return *this;
+    }
+
+    // append a stage run through `/bin/sh -c`.
+    Pipeline &then_shell(const string &command) {
+        return then({L"/bin/sh", L"-c", command});
+    }
+
+    // stdin of the first stage. the bytes are copied once into the pipeline.
+    Pipeline &stdin_from(nstring::slice bytes) {
+        return stdin_from(nstring(bytes.raw(), bytes.size()));
+    }
+
+    Pipeline &stdin_from(nstring &&bytes) {
+        reset_stdin();
+        stdin_data_ = std::Memory::move(bytes);
+        stdin_kind_ = StdinKind::Data;
+        return *this;
+    }
+
+    // fd stays owned by the caller and must remain open until start() returns.
+    Pipeline &stdin_from_fd(int fd) {
+        reset_stdin();
+        stdin_fd_   = fd;
+        stdin_kind_ = StdinKind::Fd;
+        return *this;
+    }
+
+    Pipeline &stdin_from_file(const string &path) {
+        reset_stdin();
+        stdin_path_ = path;
+        stdin_kind_ = StdinKind::File;
+        return *this;
+    }
+
+    Pipeline &env(map<string, string> vars) {
+        env_ = std::Memory::move(vars);
+        return *this;
+    }
+
+    Pipeline &working_dir(string dir) {
+        working_dir_ = std::Memory::move(dir);
+        return *this;
+    }
+
+    // capture policy and echo behaviour of the final stage, see Subprocess::spawn.
+    Pipeline &capture(bool capture_output, const CapturePolicy &policy = {}) {
+        capture_output_ = capture_output;
+        policy_         = policy;
+        return *this;
+    }
+
+    // spawn every stage. non-blocking, like Subprocess::spawn.
+    void start() {
+        if (stages_.empty()) {
+            throw libcxx::runtime_error("Pipeline: no stages");
+        }
+        if (!procs_.empty()) {
+            throw libcxx::runtime_error("Pipeline: already started");
+        }
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+        throw libcxx::runtime_error("Pipeline is not supported on Windows yet");
+#else
+        const string *wd = working_dir_.is_empty() ? nullptr : &working_dir_;
+
+        int file_fd = -1;  // stdin_from_file, dup'ed onto the first stage and then closed
+        int prev_rd = -1;  // read end of the pipe from the previous stage
+
+        auto close_ours = [&]() {
+            for (int fd : {file_fd, prev_rd}) {
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+            }
+            file_fd = prev_rd = -1;
+        };
+
+        try {
+            if (stdin_kind_ == StdinKind::File) {
+                file_fd = ::open(string_to_cstring(stdin_path_).c_str(), O_RDONLY | O_CLOEXEC);
+                if (file_fd < 0) {
+                    throw libcxx::runtime_error("Pipeline: cannot open stdin file: " +
+                                                libcxx::string(String::error(errno)));
+                }
+            }
+
+            for (usize i = 0; i < stages_.size(); ++i) {
+                const bool first = (i == 0);
+                const bool last  = (i + 1 == stages_.size());
+
+                Subprocess::Stdio stdio;
+                stdio.capture_err = last;
+
+                if (!first) {
+                    stdio.in = prev_rd;
+                } else if (stdin_kind_ == StdinKind::Fd) {
+                    stdio.in = stdin_fd_;
+                } else if (stdin_kind_ == StdinKind::File) {
+                    stdio.in = file_fd;
+                } else if (stdin_kind_ == StdinKind::Data) {
+                    stdio.feed_stdin = true;
+                }
+
+                int link[2]{-1, -1};  // NOLINT
+                if (!last) {
+                    Subprocess::open_pipe(link);
+                    stdio.out = link[1];
+                }
+
+                // built in place: the reader/writer threads point at the Subprocess
+                procs_.emplace_back(new Subprocess());
+                Subprocess &proc = *procs_.back();
+                proc.output_.set_capture(policy_);
+                proc.start_time_ = libcxx::chrono::steady_clock::now();
+                if (first && stdio.feed_stdin) {
+                    proc.stdin_data_ = std::Memory::move(stdin_data_);
+                }
+
+                try {
+                    proc.launch_posix(stages_[i], env_, wd, capture_output_ || !last, stdio);
+                } catch (...) {
+                    if (!last) {
+                        ::close(link[0]);
+                        ::close(link[1]);
+                    }
+                    procs_.pop_back();
+                    throw;
+                }
+
+                // the children hold their own copies now; the next stage inherits link[0]
+                if (prev_rd >= 0) {
+                    ::close(prev_rd);
+                    prev_rd = -1;
+                }
+                if (!last) {
+                    ::close(link[1]);
+                }
+                prev_rd = last ? -1 : link[0];
+            }
+        } catch (...) {
+            close_ours();
+            terminate();
+            throw;
+        }
+
+        close_ours();
+#endif
+    }
+
+    // wait for every stage; false if timeout_ms elapsed first (stages keep running).
+    bool wait(int timeout_ms = -1) {
+        auto deadline =
+            libcxx::chrono::steady_clock::now() + libcxx::chrono::milliseconds(timeout_ms);
+
+        for (auto &proc : procs_) {
+            int left = -1;
+            if (timeout_ms >= 0) {
+                auto ms = libcxx::chrono::ceil<libcxx::chrono::milliseconds>(
+                    deadline - libcxx::chrono::steady_clock::now());
+                left = static_cast<int>(libcxx::max<i64>(0, ms.count()));
+            }
+            if (!proc->wait(left)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    void terminate() {
+        for (auto &proc : procs_) {
+            proc->terminate();
+        }
+    }
+
+    // start, wait (terminating everything on timeout) and return the final stage's output.
+    // return_code is the last stage's, like a shell without pipefail; see return_codes().
+    ProcessOutput run(int timeout_ms = -1) {
+        start();
+
+        bool timed_out = !wait(timeout_ms);
+        if (timed_out) {
+            for (auto &proc : procs_) {
+                proc->wait_or_terminate(0);
+            }
+        }
+
+        return procs_.back()->take_output();
+    }
+
+    // exit status of every stage in order; only meaningful once wait() returned true.
+    vec<i32> return_codes() const {
+        vec<i32> codes;
+        codes.reserve(procs_.size());
+        for (const auto &proc : procs_) {
+            codes.push_back(proc->return_code_);
+        }
+        return codes;
+    }
+
+    // the running stages, first to last. the last one holds the captured output.
+    Subprocess       &stage(usize i) { return *procs_.at(i); }
+    const Subprocess &stage(usize i) const { return *procs_.at(i); }
+    usize             size() const { return stages_.size(); }
+
+  private:
+    enum class StdinKind : u8 { Inherit, Data, Fd, File };
+
+    void reset_stdin() {
+        stdin_data_.clear();
+        stdin_path_.clear();
+        stdin_fd_ = -1;
+    }
+
+    vec<vec<string>>                    stages_;
+    vec<libcxx::unique_ptr<Subprocess>> procs_;
+
+    map<string, string> env_;
+    string              working_dir_;
+    bool                capture_output_ = true;
+    CapturePolicy       policy_;
+
+    StdinKind stdin_kind_ = StdinKind::Inherit;
+    nstring   stdin_data_;
+    string    stdin_path_;
+    int       stdin_fd_ = -1;
+};
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M8PIPELINE
@@ -0,0 +1,448 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M12PROCESS_POOL
+#define _$_HX_CORE_M12PROCESS_POOL
+
+#include <include/config/config.hh>
+#include <include/runtime/__io/system.hh>
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+#   define _KAIRO_POOL_WIN32 1
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// one unit of work for a ProcessPool. `argv` is exec'd directly (see Subprocess::spawn); when it
+/// is empty `command` goes through the shell instead (see Subprocess::run).
+struct ProcessJob {
+    vec<string>         argv;
+    string              command;
+    map<string, string> env;
+    string              working_dir;  // empty = inherit
+    int                 timeout_ms     = -1;
+    bool                capture_output = true;
+    CapturePolicy       capture;
+
+    // registered on the job's ProcessOutput with on_timeout() once the job has finished.
+    $function<void()> on_timeout;
+
+    ProcessJob() = default;
+    ProcessJob(vec<string> args)  // NOLINT(google-explicit-constructor)
+        : argv(std::Memory::move(args)) {}
+    ProcessJob(string cmd)  // NOLINT(google-explicit-constructor)
+        : command(std::Memory::move(cmd)) {}
+};
+
+/// runs a queue of jobs with at most `max_parallel` children alive at once. the pool itself is a
+/// single loop on the calling thread: it refills free slots, then sleeps until something
+/// happens. on posix that is one poll() over every child's pidfd and capture pipes plus a wake
+/// fd that cancel() and SIGCHLD (where pidfds are unavailable) write to, so the children cost no
+/// threads and a cancel is seen at once. a job past its deadline, or cancelled, gets SIGTERM and
+/// then SIGKILL after a grace period, tracked as another deadline, so the loop never blocks on
+/// one child while the others wait.
+///
+/// example:
+///   ProcessPool pool(8);
+///   for (auto &file : files) { pool.submit(vec<string>{L"cc", L"-c", file}); }
+///   pool.fail_fast().on_complete([](const ProcessPool::JobResult &r) { ... });
+///   auto results = pool.run();
+class ProcessPool {
+  public:
+    enum class Order : u8 {
+        Submission,  // results[i] belongs to the i-th submitted job
+        Completion,  // results in the order jobs finished, skipped jobs last
+    };
+
+    struct JobResult {
+        usize         job{};
+        bool          skipped{false};  // never launched because the pool was cancelled
+        ProcessOutput output;
+
+        bool failed() const { return !skipped && (output.return_code != 0 || output.timed_out); }
+    };
+
+    // resource totals over the jobs that actually ran (skipped ones are left out).
+    static ProcessStatsReport report(const vec<JobResult> &results) {
+        ProcessStatsReport report;
+        for (const auto &r : results) {
+            if (!r.skipped) {
+                report.add(r.output);
+            }
+        }
+        return report;
+    }
+
+    explicit ProcessPool(usize max_parallel = 0)
+        : max_parallel_(max_parallel != 0
+                            ? max_parallel
+                            : libcxx::max<usize>(1, libcxx::thread::hardware_concurrency())) {}
+
+    ProcessPool(const ProcessPool &)            = delete;
+    ProcessPool &operator=(const ProcessPool &) = delete;
+
+    // queue a job; returns its index, which is also its position in Order::Submission results.
+    usize submit(ProcessJob job) {
+        jobs_.push_back(std::Memory::move(job));
+        return jobs_.size() - 1;
+    }
+
+    // streaming notification, called on the run() thread as each job finishes (or is skipped).
+    ProcessPool &on_complete($function<void(const JobResult &)> cb) {
+        on_complete_ = std::Memory::move(cb);
+        return *this;
+    }
+
+    // on the first failed job (non-zero exit, timeout or spawn error), stop launching new jobs
+    // and terminate the ones still running.
+    ProcessPool &fail_fast(bool enable = true) {
+        fail_fast_ = enable;
+        return *this;
+    }
+
+    // may be called from any thread (or from on_complete). running children are sent SIGTERM
+    // right away (SIGKILL after the grace period); queued jobs are reported as skipped.
+    void cancel() {
+        cancelled_ = true;
+#if !defined(_KAIRO_POOL_WIN32)
+        wake_.notify();
+#endif
+    }
+    bool cancelled() const { return cancelled_; }
+
+    usize max_parallel() const { return max_parallel_; }
+    usize size() const { return jobs_.size(); }
+
+    vec<JobResult> run(Order order = Order::Submission) {
+        vec<JobResult> done;
+        done.reserve(jobs_.size());
+
+        list<Active> active;
+        usize        next = 0;
+
+        auto finish = [&](JobResult result) {
+            if (result.failed() && fail_fast_) {
+                cancelled_ = true;
+            }
+            if (on_complete_) {
+                on_complete_(result);
+            }
+            done.push_back(std::Memory::move(result));
+        };
+
+        auto complete = [&](list<Active>::iterator it) {
+            ProcessOutput out = it->proc.take_output();
+            if (jobs_[it->job].on_timeout) {
+                out.on_timeout(jobs_[it->job].on_timeout);
+            }
+            finish(JobResult{it->job, false, std::Memory::move(out)});
+            return active.erase(it);
+        };
+
+#if !defined(_KAIRO_POOL_WIN32)
+        Waiter waiter(*this);
+#endif
+
+        for (;;) {
+            while (!cancelled_ && next < jobs_.size() && active.size() < max_parallel_) {
+                launch(next++, active, finish);
+            }
+
+            if (cancelled_) {
+                auto now = clock::now();
+                for (auto &a : active) {
+                    stop(a, false, now);
+                }
+            }
+
+            if (active.empty()) {
+                break;
+            }
+
+#if defined(_KAIRO_POOL_WIN32)
+            wait_step(active, complete);
+#else
+            waiter.step(active, complete);
+#endif
+        }
+
+        // everything never launched because of cancellation
+        for (; next < jobs_.size(); ++next) {
+            finish(JobResult{next, true, ProcessOutput{}});
+        }
+
+        if (order == Order::Submission) {
+            libcxx::sort(done.begin(), done.end(), [](const JobResult &a, const JobResult &b) {
+                return a.job < b.job;
+            });
+        } else {
+            libcxx::stable_partition(
+                done.begin(), done.end(), [](const JobResult &r) { return !r.skipped; });
+        }
+
+        return done;
+    }
+
+  private:
+    using clock      = libcxx::chrono::steady_clock;
+    using time_point = clock::time_point;
+
+    struct Active {
+        usize      job;
+        Subprocess proc;
+        time_point deadline{};
+        bool       has_deadline{false};
+        bool       stopping{false};  // terminate requested; SIGKILL at kill_at
+        time_point kill_at{time_point::max()};
+        bool       reaped{false};  // exit status collected, pipes still open (posix)
+        int        status{0};
+
+        // on windows the child's reader threads point at the Subprocess, so it is built in
+        // place in its list node from the run()/spawn() prvalue and never moved afterwards.
+        template <typename Make>
+        Active(usize index, Make &&make, int timeout_ms)
+            : job(index)
+            , proc(make())
+            , deadline(clock::now() + libcxx::chrono::milliseconds(timeout_ms))
+            , has_deadline(timeout_ms >= 0) {}
+
+        // when the loop next has to act on this job without hearing from it
+        time_point next_deadline() const {
+            if (reaped) {
+                return time_point::max();
+            }
+            return stopping ? kill_at : (has_deadline ? deadline : time_point::max());
+        }
+    };
+
+    // SIGTERM now, SIGKILL once the grace period is over; the exit arrives through the wait.
+    static void stop(Active &a, bool timed_out, time_point now) {
+        if (!a.stopping && !a.reaped) {
+            a.proc.request_terminate(timed_out);
+            a.stopping = true;
+            a.kill_at  = now + term_grace_;
+        }
+    }
+
+    // escalate or time out the jobs whose deadline has passed.
+    static void expire(Active &a, time_point now) {
+        if (a.reaped) {
+            return;  // the pid may already belong to someone else
+        }
+        if (a.stopping) {
+            if (now >= a.kill_at) {
+                a.proc.force_kill();
+                a.kill_at = time_point::max();
+            }
+        } else if (a.has_deadline && now >= a.deadline) {
+            stop(a, true, now);
+        }
+    }
+
+#if defined(_KAIRO_POOL_WIN32)
+    // windows: Subprocess::wait_any over the process handles, waking every cancel_check_ to
+    // notice cancel() from another thread.
+    template <typename Complete>
+    void wait_step(list<Active> &active, Complete &complete) {
+        auto now   = clock::now();
+        auto until = now + cancel_check_;
+        for (auto &a : active) {
+            until = libcxx::min(until, a.next_deadline());
+        }
+
+        waiting_.clear();
+        for (auto &a : active) {
+            waiting_.push_back(&a.proc);
+        }
+
+        auto left = libcxx::chrono::ceil<libcxx::chrono::milliseconds>(until - now);
+        (void)Subprocess::wait_any(waiting_, static_cast<int>(libcxx::max<i64>(0, left.count())));
+
+        now = clock::now();
+        for (auto it = active.begin(); it != active.end();) {
+            if (!it->proc.is_running()) {
+                it = complete(it);
+                continue;
+            }
+            expire(*it, now);
+            ++it;
+        }
+    }
+
+    vec<Subprocess *> waiting_;
+
+    static constexpr libcxx::chrono::milliseconds cancel_check_{25};
+#else
+    // posix: one poll() per wake-up over the wake fd and, per child, its pidfd and capture
+    // pipes. children without a pidfd are noticed through SIGCHLD, which the notifier
+    // forwards to the wake fd while this run() is subscribed. a child is reaped as soon as it
+    // exits but finishes only once its pipes reach EOF, which a grandchild holding them open
+    // can delay without holding up anyone else.
+    class Waiter {
+      public:
+        explicit Waiter(ProcessPool &pool)
+            : pool_(pool) {}
+
+        ~Waiter() {
+            if (subscribed_) {
+                __internal::SigchldNotifier::instance().unsubscribe(&pool_.wake_);
+            }
+        }
+
+        Waiter(const Waiter &)            = delete;
+        Waiter &operator=(const Waiter &) = delete;
+
+        template <typename Complete>
+        void step(list<Active> &active, Complete &complete) {
+            fds_.clear();
+            spans_.clear();
+            fds_.push_back(pollfd{pool_.wake_.fd(), POLLIN, 0});
+
+            auto until = time_point::max();
+            for (auto &a : active) {
+                until = libcxx::min(until, a.next_deadline());
+                spans_.push_back(Span{fds_.size(), !a.reaped && a.proc.pidfd_ >= 0});
+
+                if (a.reaped) {
+                    // only the pipes are left to wait for
+                } else if (a.proc.pidfd_ >= 0) {
+                    fds_.push_back(pollfd{a.proc.pidfd_, POLLIN, 0});
+                } else if (!subscribed_) {
+                    // subscribe before the reap below, so an exit after it still wakes us
+                    __internal::SigchldNotifier::instance().subscribe(&pool_.wake_);
+                    subscribed_ = true;
+                }
+                for (int fd : {a.proc.out_rd_, a.proc.err_rd_}) {
+                    if (fd >= 0) {
+                        fds_.push_back(pollfd{fd, POLLIN, 0});
+                    }
+                }
+            }
+
+            // a child without a pidfd may have exited before we subscribed: look before
+            // sleeping. with pidfds this is skipped and the poll below reports the exit.
+            bool exited = false;
+            for (auto &a : active) {
+                exited = (!a.reaped && a.proc.pidfd_ < 0 && try_reap(a)) || exited;
+            }
+
+            if (!exited) {
+                (void)Subprocess::poll_fds(
+                    fds_.data(), fds_.size(), until == time_point::max() ? nullptr : &until);
+            }
+            pool_.wake_.drain();
+
+            auto  now = clock::now();
+            usize k   = 0;
+            for (auto it = active.begin(); it != active.end(); ++k) {
+                Subprocess &proc  = it->proc;
+                usize       first = spans_[k].first;
+                usize       last  = (k + 1 < spans_.size()) ? spans_[k + 1].first : fds_.size();
+
+                if (spans_[k].pidfd) {
+                    if (fds_[first++].revents != 0) {
+                        (void)try_reap(*it);
+                    }
+                } else if (!it->reaped && proc.is_running()) {
+                    (void)try_reap(*it);
+                }
+
+                for (usize i = first; i < last; ++i) {
+                    if (fds_[i].revents != 0) {
+                        (void)proc.pump_posix(fds_[i].fd);
+                    }
+                }
+
+                if (it->reaped && proc.out_rd_ < 0 && proc.err_rd_ < 0) {
+                    proc.finalize_posix(it->status);
+                }
+                if (!proc.is_running()) {
+                    it = complete(it);
+                    continue;
+                }
+                expire(*it, now);
+                ++it;
+            }
+        }
+
+      private:
+        // collect the exit status without blocking.
+        static bool try_reap(Active &a) {
+            a.reaped = a.reaped || a.proc.await_exit(0, a.status);
+            return a.reaped;
+        }
+
+        // where one child's entries start in fds_, and whether the first is its pidfd
+        struct Span {
+            usize first;
+            bool  pidfd;
+        };
+
+        ProcessPool &pool_;
+        vec<pollfd>  fds_;
+        vec<Span>    spans_;
+        bool         subscribed_{false};
+    };
+
+    __internal::WakeFd wake_;
+#endif
+
+    template <typename Finish>
+    void launch(usize index, list<Active> &active, Finish &finish) {
+        const ProcessJob &job = jobs_[index];
+        const string     *wd  = job.working_dir.is_empty() ? nullptr : &job.working_dir;
+
+        try {
+            active.emplace_back(
+                index,
+                [&]() {
+#if defined(_KAIRO_POOL_WIN32)
+                    return job.argv.empty()
+                               ? Subprocess::run(
+                                     job.command, job.capture_output, job.env, wd, job.capture)
+                               : Subprocess::spawn(
+                                     job.argv, job.capture_output, job.env, wd, job.capture);
+#else
+                    vec<string> shell{L"/bin/sh", L"-c", job.command};
+                    return Subprocess::spawn_polled(job.argv.empty() ? shell : job.argv,
+                                                    job.capture_output,
+                                                    job.env,
+                                                    wd,
+                                                    job.capture);
+#endif
+                },
+                job.timeout_ms);
+        } catch (const libcxx::exception &e) {
+            // report the spawn error like a shell would: exit 127 with the reason on stderr
+            JobResult result{index, false, ProcessOutput{}};
+            result.output.return_code = 127;
+            result.output.stderr_data = to_string(e.what());
+            finish(std::Memory::move(result));
+        }
+    }
+
+    usize                              max_parallel_;
+    vec<ProcessJob>                    jobs_;
+    $function<void(const JobResult &)> on_complete_;
+    bool                               fail_fast_{false};
+    libcxx::atomic_bool                cancelled_{false};
+
+    // how long a terminated child gets between SIGTERM and SIGKILL, as in Subprocess::terminate
+    static constexpr libcxx::chrono::milliseconds term_grace_{500};
+};
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#undef _KAIRO_POOL_WIN32
+
+#endif  // _$_HX_CORE_M12PROCESS_POOL
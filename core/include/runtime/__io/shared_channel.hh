@@ -0,0 +1,344 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M14SHARED_CHANNEL
+#define _$_HX_CORE_M14SHARED_CHANNEL
+
+#include <include/config/config.hh>
+#include <include/runtime/__io/shared_channel_abi.h>
+#include <include/runtime/__io/system.hh>
+
+#if defined(__linux__)
+#   include <sys/mman.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// single-producer / single-consumer byte stream between this process and a child, for children
+/// that produce more than pipes comfortably carry. the ring lives in a memfd shared by both
+/// sides; the child writes with the C functions in shared_channel_abi.h, we read in place.
+///
+/// the ring is mapped twice back to back on our side, so peek() always returns everything
+/// available as one contiguous slice, even across the wrap. neither side makes a system call
+/// while the other is awake; the futex words are only touched around sleeps.
+///
+/// linux only (memfd_create + futex); constructing one elsewhere throws.
+///
+/// example:
+///   SharedChannel chan(8 << 20);
+///   auto proc = chan.spawn({L"./producer"});
+///   chan.drain([&](nstring::slice s) { sink.write(s.raw(), s.size()); }, &proc);
+///   proc.wait();
+class SharedChannel {
+  public:
+    explicit SharedChannel(usize capacity = usize(1) << 20) {
+#if defined(__linux__)
+        auto page = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+
+        capacity_ = page;
+        while (capacity_ < capacity) {
+            capacity_ <<= 1;
+        }
+
+        // the ring is mapped at the header's file offset, which has to be page aligned
+        const usize header_size = libcxx::max<usize>(KAIRO_CHANNEL_HEADER_MIN, page);
+        const usize file_size   = header_size + capacity_;
+
+        fd_ = ::memfd_create("kairo-channel", MFD_CLOEXEC);
+        if (fd_ < 0) {
+            throw libcxx::runtime_error("SharedChannel: memfd_create failed: " +
+                                        libcxx::string(String::error(errno)));
+        }
+        if (::ftruncate(fd_, static_cast<off_t>(file_size)) != 0) {
+            int err = errno;
+            release();
+            throw libcxx::runtime_error("SharedChannel: ftruncate failed: " +
+                                        libcxx::string(String::error(err)));
+        }
+
+        // reserve header + 2x ring, then map the file over the first part and the ring again
+        // right after it: byte i and byte i + capacity are the same memory
+        mapped_    = file_size + capacity_;
+        void *base = ::mmap(nullptr, mapped_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (base == MAP_FAILED) {
+            mapped_ = 0;
+            release();
+            throw libcxx::runtime_error("SharedChannel: mmap reserve failed");
+        }
+        base_ = static_cast<unsigned char *>(base);
+
+        void *whole = ::mmap(base_, file_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED,
+                             fd_, 0);
+        void *alias = ::mmap(base_ + file_size, capacity_, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_FIXED, fd_, static_cast<off_t>(header_size));
+        if (whole == MAP_FAILED || alias == MAP_FAILED) {
+            release();
+            throw libcxx::runtime_error("SharedChannel: mmap of ring failed");
+        }
+
+        header_              = reinterpret_cast<kairo_channel_header *>(base_);
+        header_->magic       = KAIRO_CHANNEL_MAGIC;
+        header_->version     = KAIRO_CHANNEL_VERSION;
+        header_->capacity    = capacity_;
+        header_->header_size = static_cast<u32>(header_size);
+        data_                = base_ + header_size;
+#else
+        (void)capacity;
+        throw libcxx::runtime_error("SharedChannel is only supported on linux");
+#endif
+    }
+
+    SharedChannel(const SharedChannel &)            = delete;
+    SharedChannel &operator=(const SharedChannel &) = delete;
+
+    SharedChannel(SharedChannel &&other) noexcept
+        : fd_(libcxx::exchange(other.fd_, -1))
+        , base_(libcxx::exchange(other.base_, nullptr))
+        , mapped_(libcxx::exchange(other.mapped_, 0))
+        , capacity_(libcxx::exchange(other.capacity_, 0))
+        , header_(libcxx::exchange(other.header_, nullptr))
+        , data_(libcxx::exchange(other.data_, nullptr)) {}
+
+    SharedChannel &operator=(SharedChannel &&other) noexcept {
+        if (this != &other) {
+            release();
+            fd_       = libcxx::exchange(other.fd_, -1);
+            base_     = libcxx::exchange(other.base_, nullptr);
+            mapped_   = libcxx::exchange(other.mapped_, 0);
+            capacity_ = libcxx::exchange(other.capacity_, 0);
+            header_   = libcxx::exchange(other.header_, nullptr);
+            data_     = libcxx::exchange(other.data_, nullptr);
+        }
+        return *this;
+    }
+
+    ~SharedChannel() { release(); }
+
+    int   fd() const { return fd_; }
+    usize capacity() const { return capacity_; }
+
+    // Subprocess::spawn with the channel inherited as `child_fd` and named in $KAIRO_CHANNEL_FD,
+    // which is what kairo_channel_open_env() looks at.
+    Subprocess spawn(const vec<string>   &argv,
+                     bool                 capture_output = true,
+                     map<string, string>  env            = {},
+                     const string        *working_dir    = nullptr,
+                     const CapturePolicy &capture        = {},
+                     int                  child_fd       = KAIRO_CHANNEL_DEFAULT_FD) {
+#if defined(__linux__)
+        if (child_fd <= STDERR_FILENO) {
+            throw libcxx::runtime_error("SharedChannel: child_fd must not be a standard stream");
+        }
+
+        // dup2 onto the same number would leave close-on-exec set, so pass a copy instead
+        int src = fd_;
+        if (src == child_fd) {
+            src = ::fcntl(fd_, F_DUPFD_CLOEXEC, child_fd + 1);
+            if (src < 0) {
+                throw libcxx::runtime_error("SharedChannel: fcntl(F_DUPFD) failed");
+            }
+        }
+
+        env[L"" KAIRO_CHANNEL_FD_ENV] = to_string(libcxx::to_string(child_fd));
+
+        Subprocess::Stdio stdio;
+        stdio.pass_fds.emplace_back(src, child_fd);
+
+        Subprocess p;
+        p.output_.set_capture(capture);
+        p.start_time_ = libcxx::chrono::steady_clock::now();
+        try {
+            p.launch_posix(argv, env, working_dir, capture_output, stdio);
+        } catch (...) {
+            if (src != fd_) {
+                ::close(src);
+            }
+            throw;
+        }
+        if (src != fd_) {
+            ::close(src);
+        }
+        return p;
+#else
+        (void)argv, (void)capture_output, (void)env, (void)working_dir, (void)capture;
+        (void)child_fd;
+        throw libcxx::runtime_error("SharedChannel is only supported on linux");
+#endif
+    }
+
+    /// --- consumer side (this process) ---
+
+    // everything the producer has published and we have not consumed, without copying. the
+    // bytes stay valid until consume() hands them back.
+    nstring::slice peek() const {
+        u64 head = __atomic_load_n(&header_->head, __ATOMIC_ACQUIRE);
+        u64 tail = header_->tail;  // only this side writes tail
+        return {reinterpret_cast<const char *>(data_ + (tail & (capacity_ - 1))),
+                static_cast<usize>(head - tail)};
+    }
+
+    // release the first n bytes of the last peek() back to the producer.
+    void consume(usize n) {
+        __atomic_store_n(&header_->tail, header_->tail + n, __ATOMIC_RELEASE);
+
+        // same handshake as kairo_channel_notify_, in the other direction
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&header_->producer_waiting, __ATOMIC_RELAXED) != 0) {
+            __atomic_fetch_add(&header_->space_seq, 1, __ATOMIC_RELEASE);
+            futex_wake(&header_->space_seq);
+        }
+    }
+
+    // block until data is available, the producer closed, or timeout_ms elapsed; returns
+    // peek(), which is empty in the last two cases.
+    nstring::slice wait(int timeout_ms = -1) {
+        auto deadline =
+            libcxx::chrono::steady_clock::now() + libcxx::chrono::milliseconds(timeout_ms);
+
+        for (;;) {
+            // a short spin catches producers that write in quick bursts without a sleep
+            for (int spin = 0; spin < 64; ++spin) {
+                nstring::slice avail = peek();
+                if (!avail.is_empty() || closed()) {
+                    return avail;
+                }
+            }
+
+            u32 seen = __atomic_load_n(&header_->data_seq, __ATOMIC_ACQUIRE);
+            __atomic_store_n(&header_->consumer_waiting, 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+            if (!peek().is_empty() || closed()) {
+                __atomic_store_n(&header_->consumer_waiting, 0, __ATOMIC_RELAXED);
+                continue;
+            }
+
+            long long wait_ns = -1;
+            if (timeout_ms >= 0) {
+                auto left = libcxx::chrono::duration_cast<libcxx::chrono::nanoseconds>(
+                    deadline - libcxx::chrono::steady_clock::now());
+                wait_ns = left.count();
+                if (wait_ns <= 0) {
+                    __atomic_store_n(&header_->consumer_waiting, 0, __ATOMIC_RELAXED);
+                    return peek();
+                }
+            }
+
+            futex_wait(&header_->data_seq, seen, wait_ns);
+            __atomic_store_n(&header_->consumer_waiting, 0, __ATOMIC_RELAXED);
+        }
+    }
+
+    // the producer called kairo_channel_close() (or close()).
+    bool closed() const { return __atomic_load_n(&header_->closed, __ATOMIC_ACQUIRE) != 0; }
+
+    // closed and fully consumed.
+    bool finished() const { return closed() && peek().is_empty(); }
+
+    // hand every chunk to fn until the producer closes the channel and it is empty. with a
+    // producer process given, also stops once that process has exited without closing (crash,
+    // kill) and everything it wrote has been read. returns the number of bytes drained.
+    template <typename Fn>
+    u64 drain(Fn &&fn, const Subprocess *producer = nullptr) {
+        u64 total = 0;
+
+        for (;;) {
+            nstring::slice chunk = wait(producer != nullptr ? 50 : -1);
+            if (!chunk.is_empty()) {
+                fn(chunk);
+                total += chunk.size();
+                consume(chunk.size());
+                continue;
+            }
+
+            if (closed() || (producer != nullptr && exited(*producer))) {
+                if (peek().is_empty()) {
+                    return total;
+                }
+            }
+        }
+    }
+
+    /// --- producer side, for a producer living in this process (threads, tests) ---
+
+    void write(nstring::slice bytes) {
+        kairo_channel ch{header_, data_, 0};
+        kairo_channel_write(&ch, bytes.raw(), bytes.size());
+    }
+
+    void close() {
+        __atomic_store_n(&header_->closed, 1, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&header_->data_seq, 1, __ATOMIC_RELEASE);
+        futex_wake(&header_->data_seq);
+    }
+
+  private:
+    void release() noexcept {
+#if defined(__linux__)
+        if (base_ != nullptr) {
+            ::munmap(base_, mapped_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+#endif
+        base_   = nullptr;
+        header_ = nullptr;
+        data_   = nullptr;
+        fd_     = -1;
+    }
+
+    // the child exited (zombie or already reaped), looked at without reaping it.
+    static bool exited(const Subprocess &proc) {
+#if defined(__linux__)
+        if (!proc.running_) {
+            return true;
+        }
+        siginfo_t info{};
+        int       rc = ::waitid(P_PID, static_cast<id_t>(proc.pid_), &info,
+                                WEXITED | WNOHANG | WNOWAIT);
+        return rc != 0 || info.si_pid == proc.pid_;
+#else
+        return !proc.is_running();
+#endif
+    }
+
+    static void futex_wait(u32 *word, u32 seen, long long timeout_ns) {
+#if defined(__linux__)
+        timespec  ts{static_cast<time_t>(timeout_ns / 1000000000),
+                    static_cast<long>(timeout_ns % 1000000000)};
+        ::syscall(SYS_futex, word, FUTEX_WAIT, seen, timeout_ns < 0 ? nullptr : &ts, nullptr, 0);
+#else
+        (void)word, (void)seen, (void)timeout_ns;
+#endif
+    }
+
+    static void futex_wake(u32 *word) {
+#if defined(__linux__)
+        ::syscall(SYS_futex, word, FUTEX_WAKE, 1, nullptr, nullptr, 0);
+#else
+        (void)word;
+#endif
+    }
+
+    int                   fd_{-1};
+    unsigned char        *base_{nullptr};
+    usize                 mapped_{0};
+    usize                 capacity_{0};
+    kairo_channel_header *header_{nullptr};
+    unsigned char        *data_{nullptr};
+};
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M14SHARED_CHANNEL
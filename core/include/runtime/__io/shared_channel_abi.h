@@ -0,0 +1,205 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+///
+/// producer side of kairo::std::SharedChannel, as plain C with no kairo dependencies so any
+/// child process (C, C++, or anything with a C FFI) can write into a channel its parent created.
+///
+/// the parent passes the channel as an inherited fd and names it in $KAIRO_CHANNEL_FD:
+///
+///   kairo_channel ch;
+///   if (kairo_channel_open_env(&ch) == 0) {
+///       kairo_channel_write(&ch, buf, len);  // blocks only while the ring is full
+///       kairo_channel_close(&ch);            // parent sees end of stream
+///   }
+///
+/// layout: `header_size` bytes of header (a whole number of pages, at least 4096, so the ring can
+/// be mapped on its own), then `capacity` bytes of ring (a power of two). head and tail are
+/// free-running byte counters. the futex words are only touched when the other side is asleep,
+/// so a busy channel moves data without any system calls. linux only (memfd + futex).
+///
+///-------------------------------------------------------------------------------- lib-helix ---///
+
+#ifndef _$_HX_CORE_M18SHARED_CHANNEL_ABI
+#define _$_HX_CORE_M18SHARED_CHANNEL_ABI
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#   include <linux/futex.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <sys/syscall.h>
+#   include <time.h>
+#   include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define KAIRO_CHANNEL_MAGIC 0x4B43484EU /* "KCHN" */
+#define KAIRO_CHANNEL_VERSION 2U
+#define KAIRO_CHANNEL_HEADER_MIN 4096U /* header_size is this or the page size, if larger */
+#define KAIRO_CHANNEL_FD_ENV "KAIRO_CHANNEL_FD"
+#define KAIRO_CHANNEL_DEFAULT_FD 3
+
+/* producer and consumer fields live on separate cache lines */
+typedef struct kairo_channel_header {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t capacity;
+    uint32_t header_size;    /* offset of the ring from the start of the file */
+    uint32_t reserved_;
+    uint8_t  pad0_[40];
+
+    uint64_t head;           /* bytes published, written by the producer */
+    uint32_t data_seq;       /* futex: bumped when data arrives for a sleeping consumer */
+    uint32_t closed;         /* producer is done */
+    uint8_t  pad1_[48];
+
+    uint64_t tail;           /* bytes consumed, written by the consumer */
+    uint32_t space_seq;      /* futex: bumped when space frees up for a sleeping producer */
+    uint32_t consumer_waiting;
+    uint32_t producer_waiting;
+    uint8_t  pad2_[44];
+} kairo_channel_header;
+
+typedef struct kairo_channel {
+    kairo_channel_header *header;
+    unsigned char        *data;
+    size_t                mapped;
+} kairo_channel;
+
+#if defined(__linux__)
+
+#if !defined(__cplusplus)
+/* unistd.h only declares syscall() with _DEFAULT_SOURCE, which strict -std=c11 leaves off */
+long syscall(long number, ...);
+#endif
+
+static inline void kairo_channel_futex_wait_(uint32_t *word, uint32_t seen) {
+    syscall(SYS_futex, word, FUTEX_WAIT, seen, NULL, NULL, 0);
+}
+
+static inline void kairo_channel_futex_wake_(uint32_t *word) {
+    syscall(SYS_futex, word, FUTEX_WAKE, 1, NULL, NULL, 0);
+}
+
+/* wake the consumer if it announced it is going to sleep. the full fence orders our head store
+ * before the consumer_waiting load, pairing with the consumer's fence. */
+static inline void kairo_channel_notify_(kairo_channel_header *h) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&h->consumer_waiting, __ATOMIC_RELAXED) != 0) {
+        __atomic_fetch_add(&h->data_seq, 1, __ATOMIC_RELEASE);
+        kairo_channel_futex_wake_(&h->data_seq);
+    }
+}
+
+/* map a channel fd inherited from the parent. returns 0, or -1 if fd is not a channel. */
+static inline int kairo_channel_open(kairo_channel *ch, int fd) {
+    struct stat st;
+    void       *base;
+
+    if (fstat(fd, &st) != 0 || st.st_size <= (off_t)KAIRO_CHANNEL_HEADER_MIN) {
+        return -1;
+    }
+
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (base == MAP_FAILED) {
+        return -1;
+    }
+
+    ch->header = (kairo_channel_header *)base;
+    ch->mapped = (size_t)st.st_size;
+
+    if (ch->header->magic != KAIRO_CHANNEL_MAGIC ||
+        ch->header->version != KAIRO_CHANNEL_VERSION ||
+        ch->header->header_size < KAIRO_CHANNEL_HEADER_MIN ||
+        ch->header->capacity + ch->header->header_size != (uint64_t)st.st_size) {
+        munmap(base, ch->mapped);
+        ch->header = NULL;
+        return -1;
+    }
+
+    ch->data = (unsigned char *)base + ch->header->header_size;
+    return 0;
+}
+
+/* open the channel named by $KAIRO_CHANNEL_FD. */
+static inline int kairo_channel_open_env(kairo_channel *ch) {
+    const char *fd = getenv(KAIRO_CHANNEL_FD_ENV);
+    return fd != NULL ? kairo_channel_open(ch, atoi(fd)) : -1;
+}
+
+/* copy len bytes into the ring, sleeping while it is full. returns len. */
+static inline size_t kairo_channel_write(kairo_channel *ch, const void *buf, size_t len) {
+    kairo_channel_header *h    = ch->header;
+    const unsigned char  *src  = (const unsigned char *)buf;
+    const uint64_t        cap  = h->capacity;
+    size_t                left = len;
+
+    while (left != 0) {
+        uint64_t head  = h->head; /* only this side writes head */
+        uint64_t tail  = __atomic_load_n(&h->tail, __ATOMIC_ACQUIRE);
+        uint64_t space = cap - (head - tail);
+
+        if (space == 0) {
+            uint32_t seen = __atomic_load_n(&h->space_seq, __ATOMIC_ACQUIRE);
+            __atomic_store_n(&h->producer_waiting, 1, __ATOMIC_RELAXED);
+            __atomic_thread_fence(__ATOMIC_SEQ_CST);
+            if (__atomic_load_n(&h->tail, __ATOMIC_ACQUIRE) == tail) {
+                kairo_channel_futex_wait_(&h->space_seq, seen);
+            }
+            __atomic_store_n(&h->producer_waiting, 0, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        size_t n     = left < space ? left : (size_t)space;
+        size_t off   = (size_t)(head & (cap - 1));
+        size_t first = n < cap - off ? n : (size_t)(cap - off);
+
+        memcpy(ch->data + off, src, first);
+        memcpy(ch->data, src + first, n - first);
+        __atomic_store_n(&h->head, head + n, __ATOMIC_RELEASE);
+        kairo_channel_notify_(h);
+
+        src += n;
+        left -= n;
+    }
+
+    return len;
+}
+
+/* mark end of stream and unmap. the parent drains what is left. */
+static inline void kairo_channel_close(kairo_channel *ch) {
+    kairo_channel_header *h = ch->header;
+    if (h == NULL) {
+        return;
+    }
+
+    __atomic_store_n(&h->closed, 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&h->data_seq, 1, __ATOMIC_RELEASE);
+    kairo_channel_futex_wake_(&h->data_seq);
+
+    munmap((void *)h, ch->mapped);
+    ch->header = NULL;
+}
+
+#endif /* __linux__ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _$_HX_CORE_M18SHARED_CHANNEL_ABI */
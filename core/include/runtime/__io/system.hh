@@ -26,6 +26,8 @@
 #include <include/config/config.hh>
 #include <include/runtime/__error/runtime_error.hh>
 #include <include/runtime/__panic/panic_config.hh>
+#include <include/types/collection/collection.hh>
+#include <include/types/maping/maping.hh>
 #include <include/types/question/question_impl.hh>
 #include <include/types/string/string.hh>
 
@@ -34,11 +36,434 @@
 #   include <unistd.h>
 #endif
 
+#if defined(__linux__) || defined(__APPLE__)
+#   include <poll.h>
+#   include <spawn.h>
+#   include <sys/resource.h>
+#endif
+
+#if defined(__linux__)
+#   include <sys/eventfd.h>
+#   include <sys/syscall.h>
+#   include <sys/uio.h>
+#endif
+
+#if defined(__APPLE__)
+#   include <crt_externs.h>
+#endif
+
+// posix_spawn_file_actions_addchdir_np landed in glibc 2.29 and macOS 10.15; without it the
+// working directory is applied by a tiny `/bin/sh` trampoline instead.
+#if defined(__APPLE__) || \
+    (defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29)))
+#   define _KAIRO_SPAWN_HAS_CHDIR 1
+#endif
+
 // "⠈", "⠐", "⠠", "⢀", "⡀", "⠄", "⠂", "⠁"
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
+#if !(defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64))
+namespace __internal {
+/// an fd that polls readable from notify() until drain(), for waking a thread blocked in
+/// poll(). an eventfd on linux, a non-blocking self-pipe elsewhere; notify() is
+/// async-signal-safe.
+class WakeFd {
+  public:
+    WakeFd() {
+#if defined(__linux__)
+        read_fd_ = write_fd_ = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (read_fd_ < 0) {
+            throw libcxx::runtime_error("eventfd() failed: errno=" + libcxx::to_string(errno));
+        }
+#else
+        int fds[2]{-1, -1};  // NOLINT
+        if (::pipe(static_cast<int *>(fds)) < 0) {
+            throw libcxx::runtime_error("pipe() for wake fd failed: errno=" +
+                                        libcxx::to_string(errno));
+        }
+
+        for (int fd : fds) {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        }
+
+        read_fd_  = fds[0];
+        write_fd_ = fds[1];
+#endif
+    }
+
+    ~WakeFd() {
+        ::close(read_fd_);
+        if (write_fd_ != read_fd_) {
+            ::close(write_fd_);
+        }
+    }
+
+    WakeFd(const WakeFd &)            = delete;
+    WakeFd &operator=(const WakeFd &) = delete;
+
+    int fd() const { return read_fd_; }
+
+    void notify() const noexcept {
+        u64 one = 1;  // an eventfd takes exactly 8 bytes; a pipe only needs one of them
+        (void)::write(write_fd_, &one, (write_fd_ == read_fd_) ? sizeof(one) : 1);
+    }
+
+    void drain() const noexcept {
+        array<char, 64> buf{};
+        while (::read(read_fd_, buf.data(), buf.size()) > 0) {}
+    }
+
+  private:
+    int read_fd_{-1};
+    int write_fd_{-1};
+};
+
+/// exit notification for when pidfd_open is unavailable (macOS, pre-5.3 kernels, seccomp).
+/// a SIGCHLD handler writes into a self-pipe; one watcher thread drains it and bumps a
+/// generation counter that any number of waiting threads block on. waiters snapshot the
+/// generation before checking waitpid(WNOHANG), so an exit in between is never missed.
+class SigchldNotifier {
+  public:
+    using time_point = libcxx::chrono::steady_clock::time_point;
+
+    static SigchldNotifier &instance() {
+        static SigchldNotifier notifier;
+        return notifier;
+    }
+
+    u64 generation() {
+        libcxx::lock_guard<libcxx::mutex> lg(mutex_);
+        return generation_;
+    }
+
+    // returns false if the deadline passed without another SIGCHLD.
+    bool wait_past(u64 seen, const time_point *deadline) {
+        libcxx::unique_lock<libcxx::mutex> lk(mutex_);
+        auto                               moved = [&] { return generation_ != seen; };
+
+        if (deadline == nullptr) {
+            cv_.wait(lk, moved);
+            return true;
+        }
+
+        return cv_.wait_until(lk, *deadline, moved);
+    }
+
+    // also notify `wake` on every SIGCHLD until unsubscribe(), for callers blocked in poll().
+    void subscribe(const WakeFd *wake) {
+        libcxx::lock_guard<libcxx::mutex> lg(mutex_);
+        listeners_.push_back(wake);
+    }
+
+    void unsubscribe(const WakeFd *wake) {
+        libcxx::lock_guard<libcxx::mutex> lg(mutex_);
+        listeners_.erase(libcxx::remove(listeners_.begin(), listeners_.end(), wake),
+                         listeners_.end());
+    }
+
+    SigchldNotifier(const SigchldNotifier &)            = delete;
+    SigchldNotifier &operator=(const SigchldNotifier &) = delete;
+
+  private:
+    SigchldNotifier() {
+        int fds[2]{-1, -1};  // NOLINT
+        if (::pipe(static_cast<int *>(fds)) < 0) {
+            throw libcxx::runtime_error("pipe() for SIGCHLD notifier failed: errno=" +
+                                        libcxx::to_string(errno));
+        }
+
+        for (int fd : fds) {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+            ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        }
+
+        read_fd_  = fds[0];
+        write_fd_ = fds[1];
+
+        // SA_SIGINFO so a previous handler that wants (sig, info, ctx) can be handed them
+        struct sigaction sa {};
+        sa.sa_sigaction = &SigchldNotifier::on_sigchld;
+        sa.sa_flags     = SA_RESTART | SA_NOCLDSTOP | SA_SIGINFO;
+        sigemptyset(&sa.sa_mask);
+        ::sigaction(SIGCHLD, &sa, &previous_);
+
+        libcxx::thread([this]() { watch(); }).detach();
+    }
+
+    static void on_sigchld(int sig, siginfo_t *info, void *ctx) {
+        int  saved = errno;
+        char b     = 0;
+        (void)::write(write_fd_, &b, 1);
+
+        // chain through whichever union member the previous handler was installed with
+        if ((previous_.sa_flags & SA_SIGINFO) != 0) {
+            if (previous_.sa_sigaction != nullptr) {
+                previous_.sa_sigaction(sig, info, ctx);
+            }
+        } else if (previous_.sa_handler != SIG_DFL && previous_.sa_handler != SIG_IGN &&
+                   previous_.sa_handler != nullptr) {
+            previous_.sa_handler(sig);
+        }
+
+        errno = saved;
+    }
+
+    [[noreturn]] void watch() {
+        array<char, 64> drain{};
+        pollfd          pfd{read_fd_, POLLIN, 0};
+
+        for (;;) {
+            if (::poll(&pfd, 1, -1) < 0) {
+                continue;
+            }
+
+            while (::read(read_fd_, drain.data(), drain.size()) > 0) {}
+
+            {
+                libcxx::lock_guard<libcxx::mutex> lg(mutex_);
+                ++generation_;
+                for (const WakeFd *wake : listeners_) {
+                    wake->notify();
+                }
+            }
+
+            cv_.notify_all();
+        }
+    }
+
+    libcxx::mutex                  mutex_;
+    libcxx::condition_variable     cv_;
+    u64                            generation_{0};
+    int                            read_fd_{-1};
+    libcxx::vector<const WakeFd *> listeners_;
+
+    inline static int              write_fd_ = -1;
+    inline static struct sigaction previous_ {};
+};
+}  // namespace __internal
+#endif
+
+/// how a Subprocess keeps what a child writes to stdout/stderr. the default (Full, not raw)
+/// decodes every chunk into ProcessOutput::stdout_data/stderr_data as it arrives. every other
+/// policy stores plain bytes and only decodes when stdout_text()/stderr_text() are called, so a
+/// child that prints gigabytes costs at most `limit` bytes of memory per stream.
+struct CapturePolicy {
+    enum class Mode : u8 {
+        Full,     // keep everything
+        Ring,     // keep only the last `limit` bytes
+        Spill,    // keep `limit` bytes in memory, then move everything to an anonymous temp file
+        Discard,  // keep nothing, only count bytes
+    };
+
+    Mode  mode  = Mode::Full;
+    usize limit = 0;
+    bool  raw   = false;  // Full only: store bytes and decode lazily
+
+    static CapturePolicy full() { return {}; }
+    static CapturePolicy raw_bytes() { return {Mode::Full, 0, true}; }
+    static CapturePolicy ring(usize bytes) { return {Mode::Ring, bytes, true}; }
+    static CapturePolicy spill(usize threshold) { return {Mode::Spill, threshold, true}; }
+    static CapturePolicy discard() { return {Mode::Discard, 0, true}; }
+
+    bool decodes_eagerly() const { return mode == Mode::Full && !raw; }
+};
+
+namespace __internal {
+/// byte store behind every CapturePolicy except the eager default.
+/// not synchronised; ProcessOutput guards it with the stream mutex.
+class CaptureBuffer {
+  public:
+    void configure(const CapturePolicy &policy) {
+        policy_ = policy;
+        clear();
+    }
+
+    void append(const char *data, usize n) {
+        total_ += n;
+
+        switch (policy_.mode) {
+            case CapturePolicy::Mode::Full:
+                mem_.append(data, n);
+                break;
+            case CapturePolicy::Mode::Ring:
+                append_ring(data, n);
+                break;
+            case CapturePolicy::Mode::Spill:
+                append_spill(data, n);
+                break;
+            case CapturePolicy::Mode::Discard:
+                break;
+        }
+    }
+
+    // the retained bytes, oldest first. for a ring the first character may be a partial UTF-8
+    // sequence, which decodes as '?'.
+    nstring bytes() const {
+        if (spill_) {
+            return spill_->read_all();
+        }
+
+        if (policy_.mode == CapturePolicy::Mode::Ring) {
+            auto [a, b] = ring_.as_slices();
+            nstring out;
+            out.reserve(a.size() + b.size());
+            out.append(a.data(), a.size());
+            out.append(b.data(), b.size());
+            return out;
+        }
+
+        return mem_;
+    }
+
+    // calls fn(nstring::slice) over the retained bytes. zero-copy for Full and for a ring whose
+    // bytes are one run in its buffer; a wrapped ring is stitched into a temporary (at most
+    // `limit` bytes) and a spill file is read back.
+    template <typename Fn>
+    decltype(auto) view(Fn &&fn) const {
+        if (policy_.mode == CapturePolicy::Mode::Ring && !spill_) {
+            auto [a, b] = ring_.as_slices();
+            if (b.empty()) {
+                return fn(nstring::slice(a.empty() ? "" : a.data(), a.size()));
+            }
+        }
+
+        if (spill_ || policy_.mode == CapturePolicy::Mode::Ring) {
+            nstring tmp = bytes();
+            return fn(nstring::slice(tmp.raw(), tmp.size()));
+        }
+
+        return fn(nstring::slice(mem_.raw(), mem_.size()));
+    }
+
+    usize total() const { return total_; }
+    usize retained() const { return spill_ ? spill_->size : mem_.size() + ring_.size(); }
+    usize dropped() const { return total_ - retained(); }
+    bool  spilled() const { return static_cast<bool>(spill_); }
+
+    void clear() {
+        mem_.clear();
+        ring_.clear();
+        total_ = 0;
+        spill_.reset();
+    }
+
+  private:
+    // shared so copies of a ProcessOutput can all read the spilled data; the mutex serialises
+    // the seek+read against a reader thread that is still appending.
+    struct SpillFile {
+        libcxx::FILE *file = nullptr;
+        usize         size = 0;
+        libcxx::mutex mutex;
+
+        ~SpillFile() {
+            if (file != nullptr) {
+                libcxx::fclose(file);
+            }
+        }
+
+        void write(const char *data, usize n) {
+            libcxx::lock_guard<libcxx::mutex> lg(mutex);
+            if (libcxx::fwrite(data, 1, n, file) != n) {
+                throw libcxx::runtime_error("capture spill file write failed");
+            }
+            size += n;
+        }
+
+        nstring read_all() {
+            libcxx::lock_guard<libcxx::mutex> lg(mutex);
+            nstring                           out;
+            out.resize(size);
+            libcxx::fflush(file);
+            libcxx::fseek(file, 0, SEEK_SET);
+            usize got = libcxx::fread(const_cast<char *>(out.raw()), 1, size, file);
+            libcxx::fseek(file, 0, SEEK_END);
+            out.resize(got);
+            return out;
+        }
+    };
+
+    void append_ring(const char *data, usize n) {
+        const usize cap = policy_.limit;
+
+        if (cap == 0) {
+            return;
+        }
+
+        if (n >= cap) {
+            ring_.clear();
+            ring_.append(data + (n - cap), cap);
+            return;
+        }
+
+        // drop just enough of the oldest bytes, then append: two memcpys at most, and the
+        // buffer stops growing once it holds `cap` bytes
+        if (ring_.size() + n > cap) {
+            ring_.drop_front(ring_.size() + n - cap);
+        }
+        ring_.append(data, n);
+    }
+
+    void append_spill(const char *data, usize n) {
+        if (!spill_ && mem_.size() + n <= policy_.limit) {
+            mem_.append(data, n);
+            return;
+        }
+
+        if (!spill_) {
+            // tmpfile() is unlinked on creation, so nothing is left behind if we crash
+            spill_       = libcxx::make_shared<SpillFile>();
+            spill_->file = libcxx::tmpfile();
+            if (spill_->file == nullptr) {
+                spill_.reset();
+                throw libcxx::runtime_error("tmpfile() for capture spill failed: errno=" +
+                                            libcxx::to_string(errno));
+            }
+            spill_->write(mem_.raw(), mem_.size());
+            mem_ = nstring();  // release the in-memory copy
+        }
+
+        spill_->write(data, n);
+    }
+
+    CapturePolicy                 policy_;
+    nstring                       mem_;
+    ring_deque<char>              ring_;  // Ring mode only
+    usize                         total_ = 0;
+    libcxx::shared_ptr<SpillFile> spill_;
+};
+}  // namespace __internal
+
+/// resources a child used, filled in when it is reaped. cpu time, peak rss, faults and context
+/// switches come from the rusage wait4() returns with the exit status (so they cover the child
+/// and any descendants it waited for). on linux the I/O counters are read from /proc/<pid>/io
+/// just before the zombie is reaped; Subprocess::stats() samples them while the child runs.
+/// on windows only the cpu times and I/O transfer counts are filled.
+struct ProcessStats {
+    libcxx::chrono::microseconds user_cpu{0};
+    libcxx::chrono::microseconds system_cpu{0};
+
+    u64 max_rss_bytes{0};
+    u64 minor_faults{0};
+    u64 major_faults{0};
+    u64 voluntary_switches{0};    // blocked waiting for a resource
+    u64 involuntary_switches{0};  // preempted
+    u64 block_reads{0};           // filesystem input operations
+    u64 block_writes{0};          // filesystem output operations
+
+    u64 read_bytes{0};     // bytes read through read()-like calls, cached or not (rchar)
+    u64 write_bytes{0};    // bytes written through write()-like calls (wchar)
+    u64 storage_read{0};   // bytes actually fetched from storage (read_bytes)
+    u64 storage_write{0};  // bytes sent to storage (write_bytes)
+
+    bool has_usage{false};  // cpu / memory / switch fields are valid
+    bool has_io{false};     // byte counters are valid
+
+    libcxx::chrono::microseconds cpu_time() const { return user_cpu + system_cpu; }
+};
+
 struct ProcessOutput {
     string stdout_data;
     string stderr_data;
@@ -55,6 +480,8 @@ struct ProcessOutput {
     bool timed_out{false};
     bool terminated{false};
 
+    ProcessStats stats;
+
     ProcessOutput() = default;
 
     ProcessOutput(const ProcessOutput &other) noexcept
@@ -67,7 +494,11 @@ struct ProcessOutput {
         , on_stdout(other.on_stdout)
         , on_stderr(other.on_stderr)
         , timed_out(other.timed_out)
-        , terminated(other.terminated) {}
+        , terminated(other.terminated)
+        , stats(other.stats)
+        , policy_(other.policy_)
+        , stdout_capture_(other.stdout_capture_)
+        , stderr_capture_(other.stderr_capture_) {}
 
     ProcessOutput(ProcessOutput &&other) noexcept
         : stdout_data(std::Memory::move(other.stdout_data))
@@ -79,7 +510,11 @@ struct ProcessOutput {
         , on_stdout(std::Memory::move(other.on_stdout))
         , on_stderr(std::Memory::move(other.on_stderr))
         , timed_out(other.timed_out)
-        , terminated(other.terminated) {}
+        , terminated(other.terminated)
+        , stats(other.stats)
+        , policy_(other.policy_)
+        , stdout_capture_(std::Memory::move(other.stdout_capture_))
+        , stderr_capture_(std::Memory::move(other.stderr_capture_)) {}
 
     ProcessOutput &operator=(const ProcessOutput &other) noexcept {
         stdout_data = other.stdout_data;
@@ -92,6 +527,11 @@ struct ProcessOutput {
         on_stderr   = other.on_stderr;
         timed_out   = other.timed_out;
         terminated  = other.terminated;
+        stats       = other.stats;
+
+        policy_         = other.policy_;
+        stdout_capture_ = other.stdout_capture_;
+        stderr_capture_ = other.stderr_capture_;
         return *this;
     }
 
@@ -106,11 +546,83 @@ struct ProcessOutput {
         on_stderr   = std::Memory::move(other.on_stderr);
         timed_out   = other.timed_out;
         terminated  = other.terminated;
+        stats       = other.stats;
+
+        policy_         = other.policy_;
+        stdout_capture_ = std::Memory::move(other.stdout_capture_);
+        stderr_capture_ = std::Memory::move(other.stderr_capture_);
         return *this;
     }
 
     ~ProcessOutput() = default;
 
+    // captured output under any CapturePolicy. with the default policy these are stdout_data /
+    // stderr_data; otherwise the stored bytes are decoded (text) or returned as-is (bytes) here.
+    string stdout_text() const {
+        libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
+        return policy_.decodes_eagerly() ? stdout_data : nstring_to_string(stdout_capture_.bytes());
+    }
+
+    string stderr_text() const {
+        libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
+        return policy_.decodes_eagerly() ? stderr_data : nstring_to_string(stderr_capture_.bytes());
+    }
+
+    nstring stdout_bytes() const {
+        libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
+        return policy_.decodes_eagerly() ? nstring(string_to_cstring(stdout_data))
+                                         : stdout_capture_.bytes();
+    }
+
+    nstring stderr_bytes() const {
+        libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
+        return policy_.decodes_eagerly() ? nstring(string_to_cstring(stderr_data))
+                                         : stderr_capture_.bytes();
+    }
+
+    // bytes the child wrote that the policy did not keep (ring overwrite, discard).
+    usize stdout_dropped() const {
+        libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
+        return stdout_capture_.dropped();
+    }
+
+    usize stderr_dropped() const {
+        libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
+        return stderr_capture_.dropped();
+    }
+
+    const CapturePolicy &capture_policy() const { return policy_; }
+
+    // run fn(string::slice) over everything captured so far without copying it out. the stream
+    // lock is held for the duration of the call so the reader thread can't append (and
+    // reallocate) underneath the view; keep fn short and don't let the slice escape.
+    // byte policies have no decoded text to point at, so they decode into a temporary first.
+    template <typename Fn>
+    decltype(auto) with_stdout(Fn &&fn) const {
+        libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
+        return with_text(stdout_data, stdout_capture_, fn);
+    }
+
+    template <typename Fn>
+    decltype(auto) with_stderr(Fn &&fn) const {
+        libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
+        return with_text(stderr_data, stderr_capture_, fn);
+    }
+
+    // same, over the raw bytes (fn(nstring::slice)). zero-copy under raw_bytes() and an unwrapped
+    // ring; the default policy has to re-encode its decoded text.
+    template <typename Fn>
+    decltype(auto) with_stdout_bytes(Fn &&fn) const {
+        libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
+        return with_bytes(stdout_data, stdout_capture_, fn);
+    }
+
+    template <typename Fn>
+    decltype(auto) with_stderr_bytes(Fn &&fn) const {
+        libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
+        return with_bytes(stderr_data, stderr_capture_, fn);
+    }
+
     ProcessOutput &on_fail($function<void()> cb, bool include_timeout = false) {
         on_fail_ = {include_timeout, cb};
 
@@ -142,8 +654,12 @@ struct ProcessOutput {
     }
 
   private:
-    libcxx::mutex stdout_mutex;
-    libcxx::mutex stderr_mutex;
+    mutable libcxx::mutex stdout_mutex;
+    mutable libcxx::mutex stderr_mutex;
+
+    CapturePolicy             policy_;
+    __internal::CaptureBuffer stdout_capture_;
+    __internal::CaptureBuffer stderr_capture_;
 
     libcxx::pair<bool, $function<void()>> on_fail_;
     $function<void()>                     on_timeout_;
@@ -167,25 +683,185 @@ struct ProcessOutput {
 
     void timeout(bool st) { this->timed_out = st; }
 
+    template <typename Fn>
+    decltype(auto) with_text(const string                    &data,
+                             const __internal::CaptureBuffer &capture,
+                             Fn                              &fn) const {
+        if (policy_.decodes_eagerly()) {
+            return fn(string::slice(data.raw(), data.size()));
+        }
+
+        string text = nstring_to_string(capture.bytes());
+        return fn(string::slice(text.raw(), text.size()));
+    }
+
+    template <typename Fn>
+    decltype(auto) with_bytes(const string                    &data,
+                              const __internal::CaptureBuffer &capture,
+                              Fn                              &fn) const {
+        if (policy_.decodes_eagerly()) {
+            nstring bytes(string_to_cstring(data));
+            return fn(nstring::slice(bytes.raw(), bytes.size()));
+        }
+
+        return capture.view(fn);
+    }
+
+    void set_capture(const CapturePolicy &policy) {
+        policy_ = policy;
+        stdout_capture_.configure(policy);
+        stderr_capture_.configure(policy);
+    }
+
     void append_stdout(const char *data, size_t n) {
         libcxx::lock_guard<libcxx::mutex> lg(stdout_mutex);
-        auto                              str = cstring_to_string(libcxx::string(data, n));
+        if (!policy_.decodes_eagerly()) {
+            stdout_capture_.append(data, n);
+            if (on_stdout) {
+                auto chunk = cstring_to_string(libcxx::string(data, n));
+                on_stdout(chunk);
+            }
+            return;
+        }
+        auto  str   = cstring_to_string(libcxx::string(data, n));
+        usize start = stdout_data.size();
         stdout_data.append(str);
         if (on_stdout) {
-            on_stdout(stdout_data.subslice(stdout_data.size() - n, n));
+            // view of just the decoded chunk, pointing into stdout_data
+            on_stdout(string::slice(stdout_data.raw() + start, str.size()));
         }
     }
 
     void append_stderr(const char *data, size_t n) {
         libcxx::lock_guard<libcxx::mutex> lg(stderr_mutex);
-        auto                              str = cstring_to_string(libcxx::string(data, n));
+        if (!policy_.decodes_eagerly()) {
+            stderr_capture_.append(data, n);
+            if (on_stderr) {
+                auto chunk = cstring_to_string(libcxx::string(data, n));
+                on_stderr(chunk);
+            }
+            return;
+        }
+        auto  str   = cstring_to_string(libcxx::string(data, n));
+        usize start = stderr_data.size();
         stderr_data.append(str);
         if (on_stderr) {
-            on_stderr(stderr_data.subslice(stderr_data.size() - n, n));
+            // view of just the decoded chunk, pointing into stderr_data
+            on_stderr(string::slice(stderr_data.raw() + start, str.size()));
         }
     }
 
     friend class Subprocess;
+    friend class Pipeline;
+    friend class SharedChannel;
+};
+
+/// totals over a batch of finished processes, e.g. everything a ProcessPool ran.
+///
+/// example:
+///   ProcessStatsReport report;
+///   for (auto &r : pool.run()) { report.add(r.output); }
+///   print(report.summary());
+struct ProcessStatsReport {
+    usize processes{0};
+    usize failed{0};  // non-zero exit or timed out
+
+    libcxx::chrono::microseconds wall_total{0};  // sum of per-process wall time
+    libcxx::chrono::microseconds wall_max{0};
+    libcxx::chrono::microseconds user_cpu{0};
+    libcxx::chrono::microseconds system_cpu{0};
+
+    u64 max_rss_bytes{0};  // largest single peak, not a sum
+    u64 voluntary_switches{0};
+    u64 involuntary_switches{0};
+    u64 major_faults{0};
+    u64 block_reads{0};
+    u64 block_writes{0};
+    u64 read_bytes{0};
+    u64 write_bytes{0};
+    u64 storage_read{0};
+    u64 storage_write{0};
+
+    isize slowest_pid{-1};
+    isize largest_pid{-1};
+
+    void add(const ProcessOutput &out) {
+        auto wall = libcxx::chrono::duration_cast<libcxx::chrono::microseconds>(out.end_time -
+                                                                                 out.start_time);
+        const ProcessStats &st = out.stats;
+
+        ++processes;
+        if (out.return_code != 0 || out.timed_out) {
+            ++failed;
+        }
+
+        wall_total += wall;
+        if (wall > wall_max || slowest_pid < 0) {
+            wall_max    = wall;
+            slowest_pid = out.pid;
+        }
+        if (st.max_rss_bytes > max_rss_bytes || largest_pid < 0) {
+            max_rss_bytes = st.max_rss_bytes;
+            largest_pid   = out.pid;
+        }
+
+        user_cpu             += st.user_cpu;
+        system_cpu           += st.system_cpu;
+        voluntary_switches   += st.voluntary_switches;
+        involuntary_switches += st.involuntary_switches;
+        major_faults         += st.major_faults;
+        block_reads          += st.block_reads;
+        block_writes         += st.block_writes;
+        read_bytes           += st.read_bytes;
+        write_bytes          += st.write_bytes;
+        storage_read         += st.storage_read;
+        storage_write        += st.storage_write;
+    }
+
+    template <typename Range>
+    static ProcessStatsReport of(const Range &outputs) {
+        ProcessStatsReport report;
+        for (const ProcessOutput &out : outputs) {
+            report.add(out);
+        }
+        return report;
+    }
+
+    libcxx::chrono::microseconds cpu_time() const { return user_cpu + system_cpu; }
+
+    // average number of cores kept busy per process while it ran (cpu time / wall time).
+    double cpu_utilization() const {
+        return wall_total.count() > 0 ? static_cast<double>(cpu_time().count()) /
+                                            static_cast<double>(wall_total.count())
+                                      : 0.0;
+    }
+
+    string summary() const {
+        auto ms = [](libcxx::chrono::microseconds us) {
+            return libcxx::to_wstring(static_cast<double>(us.count()) / 1000.0) + L" ms";
+        };
+
+        libcxx::wstring text;
+        text += L"processes: " + libcxx::to_wstring(processes) +
+                L" (failed: " + libcxx::to_wstring(failed) + L")\n";
+        text += L"wall: " + ms(wall_total) + L" total, " + ms(wall_max) +
+                L" max (pid " + libcxx::to_wstring(slowest_pid) + L")\n";
+        text += L"cpu: " + ms(user_cpu) + L" user, " + ms(system_cpu) + L" system, " +
+                libcxx::to_wstring(cpu_utilization()) + L" utilization\n";
+        text += L"peak rss: " + libcxx::to_wstring(max_rss_bytes / 1024) + L" KiB (pid " +
+                libcxx::to_wstring(largest_pid) + L")\n";
+        text += L"context switches: " + libcxx::to_wstring(voluntary_switches) +
+                L" voluntary, " + libcxx::to_wstring(involuntary_switches) + L" involuntary\n";
+        text += L"major faults: " + libcxx::to_wstring(major_faults) + L", block ops: " +
+                libcxx::to_wstring(block_reads) + L" in / " + libcxx::to_wstring(block_writes) +
+                L" out\n";
+        text += L"io: " + libcxx::to_wstring(read_bytes) + L" read / " +
+                libcxx::to_wstring(write_bytes) + L" written, storage " +
+                libcxx::to_wstring(storage_read) + L" / " + libcxx::to_wstring(storage_write) +
+                L" bytes\n";
+
+        return string(text.c_str(), text.size());
+    }
 };
 
 class Subprocess {
@@ -219,16 +895,36 @@ class Subprocess {
     static Subprocess run(const string             &wcmd,
                           bool                      capture_output,
                           const map<string, string> env         = {},
-                          const string             *working_dir = nullptr) {
+                          const string             *working_dir = nullptr,
+                          const CapturePolicy      &capture     = {}) {
         Subprocess p;
+        p.output_.set_capture(capture);
         p.start_time_ = libcxx::chrono::steady_clock::now();
         p.launch(wcmd, env, working_dir, capture_output);
         return p;
     }
 
+    // launches argv[0] directly with the given arguments, no shell involved. argv[0] is looked up
+    // in PATH when it contains no '/'. the environment block and working directory are prepared
+    // in the parent and handed to posix_spawn (vfork-style clone on glibc), so nothing runs in the
+    // child between the spawn and the exec. use run() when shell parsing is actually wanted.
+    static Subprocess spawn(const vec<string>         &argv,
+                            bool                       capture_output,
+                            const map<string, string> &env         = {},
+                            const string              *working_dir = nullptr,
+                            const CapturePolicy       &capture     = {}) {
+        Subprocess p;
+        p.output_.set_capture(capture);
+        p.start_time_ = libcxx::chrono::steady_clock::now();
+        p.launch(argv, env, working_dir, capture_output);
+        return p;
+    }
+
     // wait until the process exits or timeout_ms elapses.
     // timeout_ms <= 0 means wait indefinitely.
     // returns true if process exited, false if timeout occurred.
+    // on linux the exit is observed through a pidfd, so this wakes the moment the child exits
+    // and the timeout is honoured exactly instead of in polling steps.
     bool wait(int timeout_ms = -1) {
         if (!running_) {
             return true;
@@ -247,27 +943,132 @@ class Subprocess {
         finalize_windows(true);
         return true;
 #else
-        // poll with waitpid(WNOHANG) loop if timeout specified.
-        if (timeout_ms < 0) {
-            blocking_waitpid();
-            return true;
+        int status = 0;
+        if (!await_exit(timeout_ms, status)) {
+            return false;
+        }
+        finalize_posix(status, timeout_ms < 0);
+        return true;
+#endif
+    }
+
+    // wait until the first of `procs` exits (or timeout_ms elapses) and return it, already
+    // reaped and finalized. a process that has already finished is returned immediately.
+    // returns nullptr on timeout, or when no entry is a live process.
+    // one poll() over every pidfd on linux, so hundreds of children cost a single wakeup.
+    static Subprocess *wait_any(libcxx::span<Subprocess *> procs, int timeout_ms = -1) {
+        Memory::SmallVec<Subprocess *, 16> live;
+        live.reserve(procs.size());
+
+        for (Subprocess *p : procs) {
+            if (p == nullptr) {
+                continue;
+            }
+            if (!p->running_) {
+                return p;
+            }
+            live.push_back(p);
         }
+
+        if (live.empty()) {
+            return nullptr;
+        }
+
         auto deadline =
             libcxx::chrono::steady_clock::now() + libcxx::chrono::milliseconds(timeout_ms);
-        while (libcxx::chrono::steady_clock::now() < deadline) {
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+        // WaitForMultipleObjects caps out at MAXIMUM_WAIT_OBJECTS handles, so larger sets are
+        // waited on in groups with a short slice each.
+        const bool grouped = live.size() > MAXIMUM_WAIT_OBJECTS;
+
+        for (;;) {
+            for (usize base = 0; base < live.size(); base += MAXIMUM_WAIT_OBJECTS) {
+                usize          n = libcxx::min<usize>(MAXIMUM_WAIT_OBJECTS, live.size() - base);
+                vec<HANDLE> handles(n);
+                for (usize i = 0; i < n; ++i) {
+                    handles[i] = live[base + i]->pi_.hProcess;
+                }
+
+                DWORD slice = 0;
+                if (!grouped) {
+                    slice = (timeout_ms < 0) ? INFINITE : static_cast<DWORD>(timeout_ms);
+                } else if (base + n >= live.size()) {
+                    slice = 1;
+                }
+
+                DWORD wr = WaitForMultipleObjects(
+                    static_cast<DWORD>(n), handles.data(), FALSE, slice);
+                if (wr >= WAIT_OBJECT_0 && wr < WAIT_OBJECT_0 + n) {
+                    Subprocess *p = live[base + (wr - WAIT_OBJECT_0)];
+                    p->finalize_windows(true);
+                    return p;
+                }
+                if (wr == WAIT_FAILED) {
+                    throw libcxx::runtime_error("WaitForMultipleObjects failed! Error: " +
+                                                libcxx::to_string(GetLastError()));
+                }
+            }
+
+            if (timeout_ms >= 0 && libcxx::chrono::steady_clock::now() >= deadline) {
+                return nullptr;
+            }
+        }
+#else
+        auto try_reap = [](Subprocess *p) -> bool {
             int   status = 0;
-            pid_t r      = ::waitpid(pid_, &status, WNOHANG);
-            if (r == -1) {
-                int e = errno;
-                throw libcxx::runtime_error("waitpid failed: errno=" + libcxx::to_string(e));
+            pid_t r      = p->reap_child(WNOHANG, status);
+            if (r == -1 && errno != EINTR) {
+                throw libcxx::runtime_error("waitpid failed: errno=" + libcxx::to_string(errno));
             }
-            if (r == pid_) {
-                finalize_posix(status);
+            if (r == p->pid_) {
+                p->finalize_posix(status, true);
                 return true;
             }
-            libcxx::this_thread::sleep_for(libcxx::chrono::milliseconds(5));
+            return false;
+        };
+
+        const time_point *limit = (timeout_ms < 0) ? nullptr : &deadline;
+
+#if defined(__linux__)
+        bool all_pidfd = true;
+        for (Subprocess *p : live) {
+            all_pidfd = all_pidfd && (p->pidfd_ >= 0);
+        }
+
+        if (all_pidfd) {
+            Memory::SmallVec<pollfd, 16> fds;
+            fds.reserve(live.size());
+            for (Subprocess *p : live) {
+                fds.push_back(pollfd{p->pidfd_, POLLIN, 0});
+            }
+
+            for (;;) {
+                for (usize i = 0; i < live.size(); ++i) {
+                    if ((fds[i].revents & (POLLIN | POLLHUP | POLLERR)) != 0 && try_reap(live[i])) {
+                        return live[i];
+                    }
+                }
+
+                if (!poll_fds(fds.data(), fds.size(), limit)) {
+                    return nullptr;
+                }
+            }
+        }
+#endif
+
+        auto &notifier = __internal::SigchldNotifier::instance();
+        for (;;) {
+            u64 seen = notifier.generation();
+            for (Subprocess *p : live) {
+                if (try_reap(p)) {
+                    return p;
+                }
+            }
+            if (!notifier.wait_past(seen, limit)) {
+                return nullptr;
+            }
         }
-        return false;
 #endif
     }
 
@@ -283,30 +1084,58 @@ class Subprocess {
         finalize_windows(/*mark_terminated=*/true);
 #else
         ::kill(pid_, SIGTERM);
-        // if it doesn't exit quickly, SIGKILL as last resort.
-        for (int i = 0; i < 50 && running_; ++i) {
-            libcxx::this_thread::sleep_for(libcxx::chrono::milliseconds(10));
-        }
+        // if it doesn't exit within the grace period, SIGKILL as last resort. the wait returns
+        // as soon as the child is gone rather than sleeping out the whole period.
+        int status = 0;
+        if (!await_exit(500, status)) {
+            ::kill(pid_, SIGKILL);
+            (void)await_exit(-1, status);
+        }
+        finalize_posix(status, /*mark_terminated=*/true);
+#endif
+    }
+
+    // ask the child to exit without waiting for it: SIGTERM (TerminateProcess on windows). a
+    // later wait() or wait_any() collects the exit, reported as terminated; `timed_out` also
+    // marks the output timed out. follow with force_kill() if it outlives a grace period.
+    void request_terminate(bool timed_out = false) {
+        if (!running_) {
+            return;
+        }
+
+        timed_out_      = timed_out_ || timed_out;
+        was_terminated_ = true;
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+        TerminateProcess(pi_.hProcess, 1);
+#else
+        ::kill(pid_, SIGTERM);
+#endif
+    }
+
+    // SIGKILL a child that ignored request_terminate(). no-op on windows, where that was final.
+    void force_kill() {
+#if !(defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64))
         if (running_) {
             ::kill(pid_, SIGKILL);
         }
-        // ensure we reap it.
-        int status = 0;
-        (void)::waitpid(pid_, &status, 0);
-        finalize_posix(status, /*mark_terminated=*/true);
 #endif
     }
 
+    // wait with timeout; if it times out, mark the output timed out and terminate.
+    // returns true if the process exited on its own.
+    bool wait_or_terminate(int timeout_ms) {
+        if (wait(timeout_ms)) {
+            return true;
+        }
+        timed_out_ = true;
+        terminate(1);
+        return false;
+    }
+
     // convenience: wait with timeout; if it times out, terminate and return unified output.
     ProcessOutput timeout(int timeout_ms) {
-        ProcessOutput pr{};
-        bool          ok = wait(timeout_ms);
-        if (!ok) {
-            timed_out_ = true;
-            terminate(1);
-        }
-        pr = output();
-        return pr;
+        wait_or_terminate(timeout_ms);
+        return output();
     }
 
     // collect output after process has finished; returns the unified ProcessOutput
@@ -314,22 +1143,27 @@ class Subprocess {
         if (running_) {
             wait();
         }
-        ProcessOutput res;
-        {
-            libcxx::lock_guard<libcxx::mutex> lg_out(output_.stdout_mutex);
-            res.stdout_data = output_.stdout_data;
-        }
-        {
-            libcxx::lock_guard<libcxx::mutex> lg_err(output_.stderr_mutex);
-            res.stderr_data = output_.stderr_data;
+        return collect(/*take=*/false);
+    }
+
+    // like output(), but moves the captured buffers out instead of copying them. afterwards this
+    // Subprocess holds no captured data; output()/with_stdout() see empty streams.
+    ProcessOutput take_output() {
+        if (running_) {
+            wait();
         }
-        res.return_code = return_code_;
-        res.pid         = pid_public_;
-        res.start_time  = start_time_;
-        res.end_time    = end_time_;
-        res.timeout(timed_out_);
-        res.terminate(was_terminated_);
-        return res;
+        return collect(/*take=*/true);
+    }
+
+    // zero-copy inspection of the live capture, see ProcessOutput::with_stdout.
+    template <typename Fn>
+    decltype(auto) with_stdout(Fn &&fn) const {
+        return output_.with_stdout(libcxx::forward<Fn>(fn));
+    }
+
+    template <typename Fn>
+    decltype(auto) with_stderr(Fn &&fn) const {
+        return output_.with_stderr(libcxx::forward<Fn>(fn));
     }
 
     // accessors
@@ -337,6 +1171,19 @@ class Subprocess {
     // non-blocking: you can read accumulated stdout/stderr while process runs.
     const ProcessOutput &output() const { return output_; }
 
+    // resource usage. once the process has been reaped this is the final accounting (also in
+    // output().stats); while it runs only the linux I/O counters are live, cpu time and memory
+    // arrive with the exit status.
+    ProcessStats stats() const {
+        ProcessStats st = stats_;
+#if defined(__linux__)
+        if (running_) {
+            read_proc_io(pid_, st);
+        }
+#endif
+        return st;
+    }
+
     // register or replace streaming callbacks at any time.
     void stdout_callback($function<void(string::slice)> cb) {
         libcxx::lock_guard<libcxx::mutex> lg(output_.stdout_mutex);
@@ -360,6 +1207,28 @@ class Subprocess {
   private:
     Subprocess() = default;
 
+#if !(defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64))
+    // spawn() for ProcessPool, which reads the capture pipes itself (Stdio::caller_reads).
+    static Subprocess spawn_polled(const vec<string>         &argv,
+                                   bool                       capture_output,
+                                   const map<string, string> &env,
+                                   const string              *working_dir,
+                                   const CapturePolicy       &capture) {
+        if (argv.empty()) {
+            throw libcxx::runtime_error("spawn: argv must contain at least the program");
+        }
+
+        Subprocess p;
+        p.output_.set_capture(capture);
+        p.start_time_ = libcxx::chrono::steady_clock::now();
+
+        Stdio stdio;
+        stdio.caller_reads = true;
+        p.launch_posix(argv, env, working_dir, capture_output, stdio);
+        return p;
+    }
+#endif
+
     void move_from(Subprocess &&o) {
         running_.store(o.running_.load());
         return_code_    = o.return_code_;
@@ -367,7 +1236,10 @@ class Subprocess {
         was_terminated_ = o.was_terminated_;
         start_time_     = o.start_time_;
         end_time_       = o.end_time_;
+        stats_          = o.stats_;
         pid_public_     = o.pid_public_;
+        caller_reads_   = o.caller_reads_;
+        echo_           = o.echo_;
         output_         = std::Memory::move(o.output_);
 
 #if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
@@ -384,6 +1256,8 @@ class Subprocess {
 #else
         pid_      = o.pid_;
         o.pid_    = -1;
+        pidfd_    = o.pidfd_;
+        o.pidfd_  = -1;
         out_rd_   = o.out_rd_;
         o.out_rd_ = -1;
         err_rd_   = o.err_rd_;
@@ -392,10 +1266,14 @@ class Subprocess {
         o.out_wr_ = -1;
         err_wr_   = o.err_wr_;
         o.err_wr_ = -1;
+        in_wr_    = o.in_wr_;
+        o.in_wr_  = -1;
 #endif
 
-        t_out_ = std::Memory::move(o.t_out_);
-        t_err_ = std::Memory::move(o.t_err_);
+        t_out_      = std::Memory::move(o.t_out_);
+        t_err_      = std::Memory::move(o.t_err_);
+        t_in_       = std::Memory::move(o.t_in_);
+        stdin_data_ = std::Memory::move(o.stdin_data_);
         o.running_.store(false);
     }
 
@@ -434,10 +1312,21 @@ class Subprocess {
         if (err_wr_ >= 0) {
             ::close(err_wr_), err_wr_ = -1;
         }
+        if (pidfd_ >= 0) {
+            ::close(pidfd_), pidfd_ = -1;
+        }
 #endif
     }
 
     void join_readers() {
+#if !(defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64))
+        if (caller_reads_) {
+            drain_pipes_posix();
+        }
+#endif
+        if (t_in_.joinable()) {
+            t_in_.join();
+        }
         if (t_out_.joinable()) {
             t_out_.join();
         }
@@ -446,6 +1335,39 @@ class Subprocess {
         }
     }
 
+    ProcessOutput collect(bool take) {
+        ProcessOutput res;
+        res.policy_ = output_.policy_;
+
+        auto grab = [take](auto &from, auto &to) {
+            if (take) {
+                to = std::Memory::move(from);
+                from.clear();
+            } else {
+                to = from;
+            }
+        };
+
+        {
+            libcxx::lock_guard<libcxx::mutex> lg_out(output_.stdout_mutex);
+            grab(output_.stdout_data, res.stdout_data);
+            grab(output_.stdout_capture_, res.stdout_capture_);
+        }
+        {
+            libcxx::lock_guard<libcxx::mutex> lg_err(output_.stderr_mutex);
+            grab(output_.stderr_data, res.stderr_data);
+            grab(output_.stderr_capture_, res.stderr_capture_);
+        }
+        res.return_code = return_code_;
+        res.pid         = pid_public_;
+        res.start_time  = start_time_;
+        res.end_time    = end_time_;
+        res.stats       = stats_;
+        res.timeout(timed_out_);
+        res.terminate(was_terminated_);
+        return res;
+    }
+
     void mark_finished() {
         running_  = false;
         end_time_ = libcxx::chrono::steady_clock::now();
@@ -456,6 +1378,7 @@ class Subprocess {
                 const map<string, string> &m_env,
                 const string              *working_dir,
                 bool                       capture_output) {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
         vec<string> env;
 
         if (!m_env.empty()) {
@@ -465,7 +1388,6 @@ class Subprocess {
             }
         }
 
-#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
         SECURITY_ATTRIBUTES sa{};
         sa.nLength        = sizeof(SECURITY_ATTRIBUTES);
         sa.bInheritHandle = TRUE;
@@ -592,98 +1514,327 @@ class Subprocess {
         });
 
 #else
-        int out_pipe[2]{-1, -1};  // NOLINT
-        int err_pipe[2]{-1, -1};  // NOLINT
+        launch_posix({L"/bin/sh", L"-c", wcmd}, m_env, working_dir, capture_output, Stdio{});
+#endif
+    }
+
+    void launch(const vec<string>         &argv,
+                const map<string, string> &m_env,
+                const string              *working_dir,
+                bool                       capture_output) {
+        if (argv.empty()) {
+            throw libcxx::runtime_error("spawn: argv must contain at least the program");
+        }
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+        // CreateProcessW only takes a single command line, so quote each argument the way the
+        // MSVC runtime splits them back apart.
+        string cmdline;
+        for (const auto &arg : argv) {
+            if (!cmdline.is_empty()) {
+                cmdline += L" ";
+            }
+            cmdline += quote_windows_arg(arg);
+        }
+        launch(cmdline, m_env, working_dir, capture_output);
+#else
+        launch_posix(argv, m_env, working_dir, capture_output, Stdio{});
+#endif
+    }
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    static string quote_windows_arg(const string &arg) {
+        if (!arg.is_empty() &&
+            arg.raw_string().find_first_of(L" \t\n\v\"") == libcxx::wstring::npos) {
+            return arg;
+        }
 
-        if (pipe(static_cast<int *>(out_pipe)) < 0) {
-            throw libcxx::runtime_error("pipe() stdout failed");
+        string quoted(L"\"");
+        usize  backslashes = 0;
+        for (wchar_t c : arg) {
+            if (c == L'\\') {
+                ++backslashes;
+                continue;
+            }
+            if (c == L'"') {
+                // escape all pending backslashes and the quote itself
+                quoted.append(string(L'\\', backslashes * 2 + 1));
+            } else {
+                quoted.append(string(L'\\', backslashes));
+            }
+            quoted.push_back(c);
+            backslashes = 0;
+        }
+        // trailing backslashes precede the closing quote, so they must be doubled
+        quoted.append(string(L'\\', backslashes * 2));
+        quoted.push_back(L'"');
+        return quoted;
+    }
+#else
+    static char **current_environ() {
+#if defined(__APPLE__)
+        return *_NSGetEnviron();
+#else
+        return environ;
+#endif
+    }
+
+    // builds "KEY=VALUE" entries for the child: the inherited environment with every key from
+    // m_env overridden (matching the old setenv-in-child behaviour), then the new keys.
+    static void build_environment(const map<string, string> &m_env,
+                                  vec<cstring>              &storage,
+                                  vec<char *>               &envp) {
+        // one sorted block, probed once per inherited variable with a view of its name. m_env
+        // is ordered, so with end() as the hint keys normally append without a search
+        flat_map<cstring, cstring, libcxx::less<>> overrides;
+        overrides.reserve(m_env.size());
+        for (const auto &kv : m_env) {
+            overrides.try_emplace(
+                overrides.end(), string_to_cstring(kv.first), string_to_cstring(kv.second));
+        }
+
+        for (char **e = current_environ(); (e != nullptr) && (*e != nullptr); ++e) {
+            const char *eq = ::strchr(*e, '=');
+            if ((eq != nullptr) &&
+                overrides.contains(libcxx::string_view(*e, static_cast<usize>(eq - *e)))) {
+                continue;
+            }
+            storage.emplace_back(*e);
+        }
+
+        for (const auto &kv : overrides) {
+            storage.push_back(kv.first + "=" + kv.second);
+        }
+
+        envp.reserve(storage.size() + 1);
+        for (auto &entry : storage) {
+            envp.push_back(entry.data());
         }
+        envp.push_back(nullptr);
+    }
 
-        if (pipe(static_cast<int *>(err_pipe)) < 0) {
-            ::close(out_pipe[0]);
-            ::close(out_pipe[1]);
-            throw libcxx::runtime_error("pipe() stderr failed");
+    static void open_pipe(int (&fds)[2]) {  // NOLINT
+        // close-on-exec so concurrently spawned children never inherit each other's pipe ends;
+        // the dup2 file actions clear the flag on the child's stdout/stderr.
+#if defined(__linux__)
+        if (::pipe2(static_cast<int *>(fds), O_CLOEXEC) < 0) {
+            throw libcxx::runtime_error("pipe2() failed: errno=" + libcxx::to_string(errno));
         }
+#else
+        if (::pipe(static_cast<int *>(fds)) < 0) {
+            throw libcxx::runtime_error("pipe() failed: errno=" + libcxx::to_string(errno));
+        }
+        ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        ::fcntl(fds[1], F_SETFD, FD_CLOEXEC);
+#endif
+    }
 
-        pid_t pid = fork();
+    // how the child's standard streams are wired. the defaults are what run()/spawn() use:
+    // stdin inherited, stdout and stderr captured through pipes read by this Subprocess.
+    struct Stdio {
+        int  in          = -1;     // fd dup'ed onto the child's stdin; the caller keeps it
+        bool feed_stdin  = false;  // write stdin_data_ into a stdin pipe from a writer thread
+        int  out         = -1;     // fd dup'ed onto the child's stdout instead of a capture pipe
+        bool capture_err = true;   // false: the child shares our stderr
+
+        // no reader threads: the owner polls out_rd_/err_rd_ and calls pump_posix() when they
+        // are readable (ProcessPool); finalizing reads whatever is left
+        bool caller_reads = false;
+
+        // extra fds handed to the child as {ours, child's number}; the child number must be > 2
+        vec<libcxx::pair<int, int>> pass_fds;
+    };
+
+    void launch_posix(vec<string>                argv,
+                      const map<string, string> &m_env,
+                      const string              *working_dir,
+                      bool                       capture_output,
+                      const Stdio               &stdio) {
+        const bool chdir_needed = (working_dir != nullptr) && !working_dir->empty();
+
+#if !defined(_KAIRO_SPAWN_HAS_CHDIR)
+        if (chdir_needed) {
+            // sh -c 'cd -- "$0" && exec "$@"' <dir> <argv...>
+            argv.insert(argv.begin(),
+                        {L"/bin/sh", L"-c", L"cd -- \"$0\" && exec \"$@\"", *working_dir});
+        }
+#endif
 
-        if (pid < 0) {
-            ::close(out_pipe[0]);
-            ::close(out_pipe[1]);
-            ::close(err_pipe[0]);
-            ::close(err_pipe[1]);
+        // everything the child needs is materialized here. posix_spawn shares our address space
+        // until the exec, so the child itself must not allocate or touch the environment.
+        Memory::SmallVec<cstring, 8> arg_storage;
+        Memory::SmallVec<char *, 16> args;
+        arg_storage.reserve(argv.size());
+        args.reserve(argv.size() + 1);
+        for (const auto &arg : argv) {
+            arg_storage.push_back(string_to_cstring(arg));
+        }
+        for (auto &arg : arg_storage) {
+            args.push_back(arg.data());
+        }
+        args.push_back(nullptr);
 
-            throw libcxx::runtime_error("fork() failed");
+        vec<cstring> env_storage;
+        vec<char *>  envp;
+        char       **child_env = current_environ();
+        if (!m_env.empty()) {
+            build_environment(m_env, env_storage, envp);
+            child_env = envp.data();
         }
 
-        if (pid == 0) {
-            // child
-            // redirect stdout/stderr
-            ::close(out_pipe[0]);  // close read
-            ::close(err_pipe[0]);
-            ::dup2(out_pipe[1], STDOUT_FILENO);
-            ::dup2(err_pipe[1], STDERR_FILENO);
-            ::close(out_pipe[1]);
-            ::close(err_pipe[1]);
+        int out_pipe[2]{-1, -1};  // NOLINT
+        int err_pipe[2]{-1, -1};  // NOLINT
+        int in_pipe[2]{-1, -1};   // NOLINT
 
-            // optional working dir
-            if ((working_dir != nullptr) && !working_dir->empty()) {
-                if (chdir(string_to_cstring(*working_dir).c_str()) != 0) {
-                    _exit(127);
+        auto close_pipes = [&]() {
+            for (int fd :
+                 {out_pipe[0], out_pipe[1], err_pipe[0], err_pipe[1], in_pipe[0], in_pipe[1]}) {
+                if (fd >= 0) {
+                    ::close(fd);
                 }
             }
+        };
 
-            // build command for /bin/sh -c to keep parity with shell command interpretation,
-            // or exec directly if you want no shell. Here we mimic your original system() usage.
-            libcxx::string cmd = string_to_cstring(wcmd);
-
-            // environment setup
-            if (!env.empty()) {
-                // construct new environment
-                // note: setenv() is easier than building envp; do before exec.
-                for (const auto &e : env) {
-                    auto pos = e.lfind(L"=");
-                    if (pos != libcxx::string::npos) {
-                        auto key = string_to_cstring(e.raw_string().substr(0, pos));
-                        auto val = string_to_cstring(e.raw_string().substr(pos + 1));
-                        setenv(key.c_str(), val.c_str(), 1);
-                    }
-                }
+        try {
+            if (stdio.out < 0) {
+                open_pipe(out_pipe);
+            }
+            if (stdio.capture_err) {
+                open_pipe(err_pipe);
+            }
+            if (stdio.feed_stdin) {
+                open_pipe(in_pipe);
             }
+        } catch (...) {
+            close_pipes();
+            throw;
+        }
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        if (stdio.feed_stdin) {
+            posix_spawn_file_actions_adddup2(&actions, in_pipe[0], STDIN_FILENO);
+        } else if (stdio.in >= 0) {
+            posix_spawn_file_actions_adddup2(&actions, stdio.in, STDIN_FILENO);
+        }
+        posix_spawn_file_actions_adddup2(
+            &actions, (stdio.out >= 0) ? stdio.out : out_pipe[1], STDOUT_FILENO);
+        if (stdio.capture_err) {
+            posix_spawn_file_actions_adddup2(&actions, err_pipe[1], STDERR_FILENO);
+        }
+        for (const auto &[ours, theirs] : stdio.pass_fds) {
+            // dup2 onto itself would keep close-on-exec set, so callers pick a different number
+            posix_spawn_file_actions_adddup2(&actions, ours, theirs);
+        }
+#if defined(_KAIRO_SPAWN_HAS_CHDIR)
+        cstring wdir;
+        if (chdir_needed) {
+            wdir = string_to_cstring(*working_dir);
+            posix_spawn_file_actions_addchdir_np(&actions, wdir.c_str());
+        }
+#endif
 
-            // use sh -c "cmd"
-            execl("/bin/sh", "sh", "-c", cmd.c_str(), (char *)nullptr);
-            _exit(127);
+        pid_t pid = -1;
+        int   rc  = ::posix_spawnp(&pid, args[0], &actions, nullptr, args.data(), child_env);
+        posix_spawn_file_actions_destroy(&actions);
+
+        if (rc != 0) {
+            close_pipes();
+            throw libcxx::runtime_error("posix_spawn() failed for '" + arg_storage.front() +
+                                        "': " + String::error(rc));
+        }
+
+        // parent keeps only its own ends: the read ends of the capture pipes and the write end
+        // of the stdin pipe
+        for (int *fd : {&out_pipe[1], &err_pipe[1], &in_pipe[0]}) {
+            if (*fd >= 0) {
+                ::close(*fd), *fd = -1;
+            }
         }
 
         // parent
         pid_        = pid;
         pid_public_ = static_cast<long long>(pid_);
+        pidfd_      = open_pidfd(pid_);
         out_rd_     = out_pipe[0];
-        out_wr_     = out_pipe[1];
         err_rd_     = err_pipe[0];
-        err_wr_     = err_pipe[1];
-        // parent doesn't write
-        ::close(out_wr_);
-        out_wr_ = -1;
-        ::close(err_wr_);
-        err_wr_ = -1;
+        in_wr_      = in_pipe[1];
 
-        // set non-blocking reads (optional; our reader threads will still block in read()
-        // but setting O_NONBLOCK helps in some shutdown races).
-        set_nonblocking(out_rd_);
-        set_nonblocking(err_rd_);
+        running_      = true;
+        caller_reads_ = stdio.caller_reads;
+        echo_         = !capture_output;
 
-        running_ = true;
+        // non-blocking reads: the reader threads wait in poll() between bursts, and a caller
+        // pumping the pipes must never block in read()
+        if (out_rd_ >= 0) {
+            set_nonblocking(out_rd_);
+            if (!caller_reads_) {
+                t_out_ = libcxx::thread([capture_output, this]() {
+                    read_pipe_posix(out_rd_, /*is_stdout=*/true, capture_output);
+                });
+            }
+        }
+        if (err_rd_ >= 0) {
+            set_nonblocking(err_rd_);
+            if (!caller_reads_) {
+                t_err_ = libcxx::thread([capture_output, this]() {
+                    read_pipe_posix(err_rd_, /*is_stdout=*/false, capture_output);
+                });
+            }
+        }
+        if (in_wr_ >= 0) {
+            t_in_ = libcxx::thread([this]() { write_stdin_posix(in_wr_); });
+        }
+    }
 
-        t_out_ = libcxx::thread([capture_output, this]() {
-            read_pipe_posix(out_rd_, /*is_stdout=*/true, capture_output);
-        });
-        t_err_ = libcxx::thread([capture_output, this]() {
-            read_pipe_posix(err_rd_, /*is_stdout=*/false, capture_output);
-        });
+    // feeds stdin_data_ to the child and closes the pipe so it sees EOF. on linux the buffer's
+    // pages are vmsplice'd into the pipe rather than copied, which is why stdin_data_ has to
+    // outlive the child and is never modified once the writer has started.
+    void write_stdin_posix(int fd) {
+        // a child that exits without reading everything must give us EPIPE, not a SIGPIPE that
+        // takes down the whole process. SIGPIPE is thread-directed, so blocking it here suffices.
+        sigset_t block;
+        sigemptyset(&block);
+        sigaddset(&block, SIGPIPE);
+        pthread_sigmask(SIG_BLOCK, &block, nullptr);
+
+        const char *data = stdin_data_.raw();
+        usize       left = stdin_data_.size();
+#if defined(__linux__)
+        bool use_vmsplice = true;
 #endif
+
+        while (left > 0) {
+            ssize_t n = -1;
+#if defined(__linux__)
+            if (use_vmsplice) {
+                iovec iov{const_cast<char *>(data), left};
+                n = ::vmsplice(fd, &iov, 1, 0);
+                if (n < 0 && (errno == EINVAL || errno == ENOSYS)) {
+                    use_vmsplice = false;
+                    continue;
+                }
+            } else
+#endif
+            {
+                n = ::write(fd, data, left);
+            }
+
+            if (n < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;  // EPIPE: the child closed its stdin early
+            }
+
+            data += n;
+            left -= static_cast<usize>(n);
+        }
+
+        ::close(fd);
+        in_wr_ = -1;
     }
+#endif
 
 #if !(defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64))
     static void set_nonblocking(int fd) {
@@ -694,9 +1845,19 @@ class Subprocess {
     }
 
     void read_pipe_posix(int fd, bool is_stdout, bool capture_output) {
+        while (read_ready_posix(fd, is_stdout, capture_output, usize(-1))) {
+            // block until more data or the write end closes instead of spinning
+            pollfd pfd{fd, POLLIN, 0};
+            (void)::poll(&pfd, 1, -1);
+        }
+    }
+
+    // read what `fd` holds right now, at most `max_chunks` reads. returns false once the
+    // stream has ended (EOF or a read error), after closing fd.
+    bool read_ready_posix(int fd, bool is_stdout, bool capture_output, usize max_chunks) {
         array<char, 4096> buf{};
 
-        for (;;) {
+        for (usize chunk = 0;;) {
             ssize_t n = ::read(fd, buf.data(), buf.size());
 
             if (n > 0) {
@@ -716,6 +1877,9 @@ class Subprocess {
                     }
                 }
 
+                if (++chunk == max_chunks) {
+                    return true;  // let the caller get to its other streams
+                }
                 continue;
             }
 
@@ -724,9 +1888,7 @@ class Subprocess {
             }
 
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                // small sleep to avoid busy spin
-                libcxx::this_thread::sleep_for(libcxx::chrono::milliseconds(2));
-                continue;
+                return true;
             }
 
             if (errno == EINTR) {
@@ -747,16 +1909,214 @@ class Subprocess {
         }
 
         is_stdout ? (out_rd_ = -1) : (err_rd_ = -1);
+        return false;
+    }
+
+    // caller_reads mode: read what the capture pipe `fd` (out_rd_ or err_rd_) holds now.
+    // returns false once that stream has ended and fd is closed.
+    bool pump_posix(int fd) {
+        // one pipe buffer's worth per call, so a chatty child cannot starve the others
+        return read_ready_posix(fd, fd == out_rd_, !echo_, 16);
+    }
+
+    // caller_reads mode: read both capture pipes to EOF, which is what joining the reader
+    // threads amounts to otherwise.
+    void drain_pipes_posix() {
+        for (;;) {
+            array<pollfd, 2> fds{};
+            usize            n = 0;
+            for (int fd : {out_rd_, err_rd_}) {
+                if (fd >= 0) {
+                    fds[n++] = pollfd{fd, POLLIN, 0};
+                }
+            }
+            if (n == 0) {
+                return;
+            }
+
+            (void)poll_fds(fds.data(), n, nullptr);
+            for (usize i = 0; i < n; ++i) {
+                if (fds[i].revents != 0) {
+                    (void)pump_posix(fds[i].fd);
+                }
+            }
+        }
+    }
+
+    static int open_pidfd(pid_t pid) {
+#if defined(__linux__) && defined(SYS_pidfd_open)
+        int fd = static_cast<int>(::syscall(SYS_pidfd_open, pid, 0));
+        if (fd >= 0) {
+            ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        return fd;  // -1 (ENOSYS, EPERM under seccomp, ...) selects the SIGCHLD fallback
+#else
+        (void)pid;
+        return -1;
+#endif
+    }
+
+    // waitpid() that also records what the child used. on linux the exit is first observed with
+    // WNOWAIT, so /proc/<pid>/io can still be read from the zombie before wait4 reaps it.
+    pid_t reap_child(int options, int &status) {
+#if defined(__linux__)
+        siginfo_t info{};
+        if (::waitid(P_PID, static_cast<id_t>(pid_), &info, WEXITED | WNOWAIT | options) == -1) {
+            return -1;
+        }
+        if (info.si_pid != pid_) {
+            return 0;  // WNOHANG and still running
+        }
+        read_proc_io(pid_, stats_);
+#endif
+
+        rusage usage{};
+        pid_t  r = ::wait4(pid_, &status, options, &usage);
+        if (r == pid_) {
+            auto us = [](const timeval &tv) {
+                return libcxx::chrono::seconds(tv.tv_sec) +
+                       libcxx::chrono::microseconds(tv.tv_usec);
+            };
+
+            stats_.user_cpu             = us(usage.ru_utime);
+            stats_.system_cpu           = us(usage.ru_stime);
+#if defined(__APPLE__)
+            stats_.max_rss_bytes        = static_cast<u64>(usage.ru_maxrss);  // already bytes
+#else
+            stats_.max_rss_bytes        = static_cast<u64>(usage.ru_maxrss) * 1024;  // KiB
+#endif
+            stats_.minor_faults         = static_cast<u64>(usage.ru_minflt);
+            stats_.major_faults         = static_cast<u64>(usage.ru_majflt);
+            stats_.voluntary_switches   = static_cast<u64>(usage.ru_nvcsw);
+            stats_.involuntary_switches = static_cast<u64>(usage.ru_nivcsw);
+            stats_.block_reads          = static_cast<u64>(usage.ru_inblock);
+            stats_.block_writes         = static_cast<u64>(usage.ru_oublock);
+            stats_.has_usage            = true;
+        }
+        return r;
+    }
+
+#if defined(__linux__)
+    // parses /proc/<pid>/io. fails quietly (has_io stays as it was) when the file is missing or
+    // unreadable, e.g. without ptrace access to the child.
+    static void read_proc_io(pid_t pid, ProcessStats &st) {
+        char path[32];  // NOLINT
+        ::snprintf(static_cast<char *>(path), sizeof(path), "/proc/%d/io", static_cast<int>(pid));
+
+        int fd = ::open(static_cast<char *>(path), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return;
+        }
+
+        char    buf[512];  // NOLINT
+        ssize_t n = ::read(fd, static_cast<char *>(buf), sizeof(buf) - 1);
+        ::close(fd);
+        if (n <= 0) {
+            return;
+        }
+        buf[n] = '\0';
+
+        auto field = [&](const char *name, u64 &into) {
+            const char *at = ::strstr(static_cast<char *>(buf), name);
+            if (at != nullptr) {
+                into = ::strtoull(at + ::strlen(name), nullptr, 10);
+            }
+        };
+
+        // the leading newline keeps "write_bytes" from matching "cancelled_write_bytes"
+        field("rchar: ", st.read_bytes);
+        field("wchar: ", st.write_bytes);
+        field("\nread_bytes: ", st.storage_read);
+        field("\nwrite_bytes: ", st.storage_write);
+        st.has_io = true;
+    }
+#endif
+
+    // poll() with a steady_clock deadline (nullptr = forever). returns false once the deadline
+    // has passed; ppoll takes a timespec so linux timeouts are not rounded to milliseconds.
+    static bool poll_fds(pollfd                                         *fds,
+                         usize                                           n,
+                         const libcxx::chrono::steady_clock::time_point *deadline) {
+        for (;;) {
+            int rc = 0;
+
+            if (deadline == nullptr) {
+                rc = ::poll(fds, static_cast<nfds_t>(n), -1);
+            } else {
+                auto left = *deadline - libcxx::chrono::steady_clock::now();
+                if (left <= libcxx::chrono::steady_clock::duration::zero()) {
+                    return false;
+                }
+#if defined(__linux__)
+                auto     ns = libcxx::chrono::duration_cast<libcxx::chrono::nanoseconds>(left);
+                timespec ts{static_cast<time_t>(ns.count() / 1000000000),
+                            static_cast<long>(ns.count() % 1000000000)};
+                rc = ::ppoll(fds, static_cast<nfds_t>(n), &ts, nullptr);
+#else
+                auto ms = libcxx::chrono::ceil<libcxx::chrono::milliseconds>(left);
+                rc = ::poll(fds, static_cast<nfds_t>(n), static_cast<int>(ms.count()));
+#endif
+            }
+
+            if (rc > 0) {
+                return true;
+            }
+            if (rc < 0 && errno != EINTR) {
+                throw libcxx::runtime_error("poll failed: errno=" + libcxx::to_string(errno));
+            }
+            // rc == 0 or EINTR: loop re-checks the deadline
+        }
     }
 
-    void blocking_waitpid() {
-        int   status = 0;
-        pid_t r      = ::waitpid(pid_, &status, 0);
-        if (r == -1) {
-            int e = errno;
-            throw libcxx::runtime_error("waitpid failed: errno=" + libcxx::to_string(e));
+    // blocks until the child has been reaped (status filled, returns true) or timeout_ms
+    // elapses (returns false). timeout_ms < 0 waits indefinitely.
+    bool await_exit(int timeout_ms, int &status) {
+        auto reap = [&]() -> bool {
+            pid_t r = reap_child(WNOHANG, status);
+            if (r == -1 && errno != EINTR) {
+                throw libcxx::runtime_error("waitpid failed: errno=" + libcxx::to_string(errno));
+            }
+            return r == pid_;
+        };
+
+        if (timeout_ms < 0) {
+            for (;;) {
+                pid_t r = reap_child(0, status);
+                if (r == pid_) {
+                    return true;
+                }
+                if (r == -1 && errno != EINTR) {
+                    throw libcxx::runtime_error("waitpid failed: errno=" +
+                                                libcxx::to_string(errno));
+                }
+            }
+        }
+
+        auto deadline =
+            libcxx::chrono::steady_clock::now() + libcxx::chrono::milliseconds(timeout_ms);
+
+        if (pidfd_ >= 0) {
+            pollfd pfd{pidfd_, POLLIN, 0};
+            for (;;) {
+                if (reap()) {
+                    return true;
+                }
+                if (!poll_fds(&pfd, 1, &deadline)) {
+                    return reap();
+                }
+            }
+        }
+
+        auto &notifier = __internal::SigchldNotifier::instance();
+        for (;;) {
+            u64 seen = notifier.generation();
+            if (reap()) {
+                return true;
+            }
+            if (!notifier.wait_past(seen, &deadline)) {
+                return reap();
+            }
         }
-        finalize_posix(status, true);
     }
 
     void finalize_posix(int status, bool mark_terminated = false) {
@@ -781,6 +2141,9 @@ class Subprocess {
         if (err_rd_ >= 0) {
             ::close(err_rd_), err_rd_ = -1;
         }
+        if (pidfd_ >= 0) {
+            ::close(pidfd_), pidfd_ = -1;
+        }
     }
 #else
     void read_pipe_windows(HANDLE hPipe, bool is_stdout, bool capture_output) {
@@ -830,6 +2193,27 @@ class Subprocess {
         }
     }
 
+    void record_usage_windows() {
+        auto us = [](const FILETIME &ft) {  // 100ns ticks
+            return libcxx::chrono::microseconds(
+                ((static_cast<u64>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime) / 10);
+        };
+
+        FILETIME created{}, exited{}, kernel{}, user{};
+        if (GetProcessTimes(pi_.hProcess, &created, &exited, &kernel, &user)) {
+            stats_.user_cpu   = us(user);
+            stats_.system_cpu = us(kernel);
+            stats_.has_usage  = true;
+        }
+
+        IO_COUNTERS io{};
+        if (GetProcessIoCounters(pi_.hProcess, &io)) {
+            stats_.read_bytes  = io.ReadTransferCount;
+            stats_.write_bytes = io.WriteTransferCount;
+            stats_.has_io      = true;
+        }
+    }
+
     void finalize_windows(bool mark_terminated = false) {
         // ensure readers have consumed everything
         join_readers();
@@ -846,6 +2230,7 @@ class Subprocess {
                                         libcxx::to_string(err));
         }
         return_code_    = static_cast<int>(exitCode);
+        record_usage_windows();
         was_terminated_ = was_terminated_ || mark_terminated;
         mark_finished();
 
@@ -867,12 +2252,19 @@ class Subprocess {
     long long           pid_public_{-1};
     time_point          start_time_;
     time_point          end_time_;
+    ProcessStats        stats_;
     ProcessOutput       output_;
     libcxx::atomic_bool running_{false};
+    bool                caller_reads_{false};  // see Stdio::caller_reads
+    bool                echo_{false};          // not capturing: copy the child's output to ours
 
     // reader threads
     libcxx::thread t_out_;
     libcxx::thread t_err_;
+    libcxx::thread t_in_;
+
+    // bytes written to the child's stdin (Pipeline::stdin_from); see write_stdin_posix.
+    nstring stdin_data_;
 
 #if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
     PROCESS_INFORMATION pi_{};
@@ -880,9 +2272,15 @@ class Subprocess {
     HANDLE              hStderrRd_{nullptr}, hStderrWr_{nullptr};
 #else
     pid_t pid_{-1};
+    int   pidfd_{-1};
     int   out_rd_{-1}, out_wr_{-1};
     int   err_rd_{-1}, err_wr_{-1};
+    int   in_wr_{-1};
 #endif
+
+    friend class Pipeline;
+    friend class SharedChannel;
+    friend class ProcessPool;
 };
 
 // convenience helper similar to your original signature but async-capable.
@@ -899,8 +2297,9 @@ class Subprocess {
 inline Subprocess async_system(const string              &wcmd,
                                bool                       capture_output = false,
                                const map<string, string> &env            = {},
-                               const string              *working_dir    = nullptr) {
-    return Subprocess::run(wcmd, capture_output, env, working_dir);
+                               const string              *working_dir    = nullptr,
+                               const CapturePolicy       &capture        = {}) {
+    return Subprocess::run(wcmd, capture_output, env, working_dir, capture);
 }
 
 // synchronous helper with timeout that returns unified ProcessOutput.
@@ -908,9 +2307,11 @@ inline ProcessOutput system(const string              &wcmd,
                             bool                       capture_output = false,
                             int                        timeout_ms     = -1,
                             const map<string, string> &env            = {},
-                            const string              *working_dir    = nullptr) {
-    auto p = Subprocess::run(wcmd, capture_output, env, working_dir);
-    return p.timeout(timeout_ms);
+                            const string              *working_dir    = nullptr,
+                            const CapturePolicy       &capture        = {}) {
+    auto p = Subprocess::run(wcmd, capture_output, env, working_dir, capture);
+    p.wait_or_terminate(timeout_ms);
+    return p.take_output();
 }
 
 H_STD_NAMESPACE_END
@@ -15,6 +15,7 @@
 #include <include/config/config.hh>
 
 #include "heap_bounds.hh"
+#include "memory_map.hh"
 #include "stack_bounds.hh"
 #include "rot_bounds.hh"
 
@@ -29,19 +30,47 @@ enum class AddressType : u8 {
     Unknown   // (in cases like an other program or some other shared memory configuration)
 };
 
+/// classify ptr. the calling thread's stack is checked against its own bounds; anything else
+/// is looked up in MemoryMap::global(), so a query costs a binary search and no system calls.
+/// other threads' stacks come back as Unknown, never Heap.
+/// the map is only re-read when ptr is outside every known region and not near null, at most
+/// every 10 ms, backing off to once a second while re-reads find nothing new.
 inline AddressType address_type(const void *ptr) {
-    static auto [stack_st, stack_ed] = stack_bounds();
-    static auto heap_base            = reinterpret_cast<uintptr_t>(heap_start());
-    static auto stack_low            = reinterpret_cast<uintptr_t>(stack_st);
-    static auto stack_high           = reinterpret_cast<uintptr_t>(stack_ed);
-    auto        addr                 = reinterpret_cast<uintptr_t>(ptr);
+    if (in_stack(ptr)) {
+        return AddressType::Stack;
+    }
 
-    if (addr >= heap_base) {
-        return AddressType::Heap;
+#if defined(__linux__)
+    auto &map    = MemoryMap::global();
+    auto  region = map.find(ptr);
+    if (!region && map.refresh_on_miss(ptr)) {
+        region = map.find(ptr);
     }
 
-    if ((addr - stack_low) < (stack_high - stack_low)) {
-        return AddressType::Stack;
+    if (!region) {
+        return AddressType::Unknown;
+    }
+
+    switch (region->kind) {
+        case MemoryMap::Kind::Stack:
+            return AddressType::Stack;
+        case MemoryMap::Kind::Heap:
+            return AddressType::Heap;
+        case MemoryMap::Kind::Anonymous:
+            return region->writable() ? AddressType::Heap : AddressType::Unknown;
+        case MemoryMap::Kind::Guarded:
+            // most likely another thread's stack, but an allocator's guarded block looks the
+            // same and only the calling thread's stack bounds are known
+            return AddressType::Unknown;
+        default:
+            return (region->readable() && !region->writable()) ? AddressType::ROTData
+                                                               : AddressType::Unknown;
+    }
+#else
+    static auto heap_base = reinterpret_cast<uintptr_t>(heap_start());
+
+    if (reinterpret_cast<uintptr_t>(ptr) >= heap_base) {
+        return AddressType::Heap;
     }
 
     if (in_rotdata(ptr)) {
@@ -49,6 +78,7 @@ inline AddressType address_type(const void *ptr) {
     }
 
     return AddressType::Unknown;
+#endif
 }
 }  // namespace Memory
 
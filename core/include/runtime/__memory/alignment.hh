@@ -17,6 +17,7 @@
 #include <include/c++/libc++.hh>
 #include <include/types/builtins/builtins.hh>
 
+#include "alloc_hooks.hh"
 #include "forwarding.hh"
 
 H_NAMESPACE_BEGIN
@@ -49,6 +50,7 @@ inline T *new_aligned(Args &&...args) {
     raw_mem = ::operator new(sizeof(T), libcxx::align_val_t(alignof(T)));
 #endif
 
+    profile_runtime_alloc(raw_mem, sizeof(T));
     return ::new (raw_mem) T(libcxx::forward<Args>(args)...);
 }
 
@@ -67,6 +69,7 @@ inline void delete_aligned(T *ptr) {
     }
 
     ptr->~T();
+    profile_runtime_free(ptr);
 #ifdef _MSC_VER
     _aligned_free(ptr);
 #else
@@ -0,0 +1,119 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M11ALLOC_HOOKS
+#define _$_HX_CORE_M11ALLOC_HOOKS
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// fast paths of the allocation profiler (see alloc_profile.hh). these are called from every
+/// hooked allocation, so they only touch a global flag and a thread-local byte countdown; the
+/// rest of the profiler is reached through function pointers it installs when it starts,
+/// which keeps this header free of the stacktrace dependency.
+///
+namespace __profile {
+/// mean bytes between samples; 0 while the profiler is stopped.
+inline libcxx::atomic<usize> sample_period{0};
+
+/// set when the replacement global operator new/delete are linked in, so the runtime's own
+/// hooks (create, new_aligned) do not count the same allocation twice.
+inline bool global_hooks = false;
+
+/// called for a sampled allocation. `countdown` is the thread's byte counter, to be re-armed.
+using SampleFn = void (*)(void *ptr, usize size, i64 &countdown) noexcept;
+inline libcxx::atomic<SampleFn> on_sample{nullptr};
+
+/// addresses of live sampled allocations, so frees can be matched without a lock. a key is
+/// hashed to a window of `window` slots (one cache line) and only that window is searched.
+inline constexpr usize window = 8;
+
+struct Table {
+    usize                           mask;  // slot count - 1
+    libcxx::atomic<uintptr_t>      *keys;
+    void (*on_free)(usize slot) noexcept;
+};
+
+inline libcxx::atomic<Table *> live{nullptr};
+
+inline thread_local i64 countdown = 0;
+
+inline usize window_of(const Table &t, const void *ptr) noexcept {
+    auto h = static_cast<u64>(reinterpret_cast<uintptr_t>(ptr) >> 4) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<usize>(h >> 32) & t.mask & ~(window - 1);
+}
+
+inline void free_slow(Table *t, void *ptr) noexcept {
+    const auto  key   = reinterpret_cast<uintptr_t>(ptr);
+    const usize first = window_of(*t, ptr);
+
+    for (usize i = first; i < first + window; ++i) {
+        uintptr_t seen = key;
+        if (t->keys[i].load(libcxx::memory_order_relaxed) == key &&
+            t->keys[i].compare_exchange_strong(seen, uintptr_t(1), libcxx::memory_order_acquire)) {
+            t->on_free(i);  // releases the slot (stores 0) when done with it
+            return;
+        }
+    }
+}
+}  // namespace __profile
+
+/// report an allocation to the profiler. cheap when profiling is off or the sample is not due.
+inline void profile_alloc(void *ptr, usize size) noexcept {
+    if (__profile::sample_period.load(libcxx::memory_order_relaxed) == 0) [[likely]] {
+        return;
+    }
+
+    if ((__profile::countdown -= static_cast<i64>(size)) > 0 || ptr == nullptr) [[likely]] {
+        return;
+    }
+
+    if (auto fn = __profile::on_sample.load(libcxx::memory_order_relaxed); fn != nullptr) {
+        fn(ptr, size, __profile::countdown);
+    }
+}
+
+/// report a free to the profiler; only pointers that were sampled are looked at further.
+inline void profile_free(void *ptr) noexcept {
+    __profile::Table *t = __profile::live.load(libcxx::memory_order_acquire);
+    if (t == nullptr || ptr == nullptr) [[likely]] {
+        return;
+    }
+
+    __profile::free_slow(t, ptr);
+}
+
+/// hooks for runtime helpers that allocate through ::operator new; skipped when the global
+/// operators are replaced, since those already see the allocation.
+inline void profile_runtime_alloc(void *ptr, usize size) noexcept {
+    if (!__profile::global_hooks) {
+        profile_alloc(ptr, size);
+    }
+}
+
+inline void profile_runtime_free(void *ptr) noexcept {
+    if (!__profile::global_hooks) {
+        profile_free(ptr);
+    }
+}
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M11ALLOC_HOOKS
@@ -0,0 +1,689 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M13ALLOC_PROFILE
+#define _$_HX_CORE_M13ALLOC_PROFILE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__panic/stacktrace.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "alloc_hooks.hh"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief Sampling allocation profiler: answers "who allocates" and "who holds the heap".
+///
+/// Allocations are sampled by bytes, not by call: each thread counts down a random interval
+/// drawn from an exponential distribution with mean `sample_bytes`, so sampling is a Poisson
+/// process over allocated bytes and large allocations are proportionally more likely to be
+/// seen. Every sample records the call site (the Kairo shadow stack kept by
+/// Stacktrace::RegisterFrame, plus native return addresses) and is weighted back up to an
+/// estimate of the allocations it stands for. Sampled blocks that are still alive form the
+/// live-heap view.
+///
+/// The runtime's create()/destroy() and new_aligned()/delete_aligned() report to the profiler.
+/// To see every allocation in the program, define KAIRO_ALLOC_PROFILE_HOOKS in exactly one
+/// translation unit before including the runtime; that replaces the global operator
+/// new/delete with malloc-backed versions that report too.
+/// \code
+///   Memory::AllocProfiler::start();
+///   run_workload();
+///   write_file("heap.folded", Memory::AllocProfiler::folded());   // flamegraph.pl, speedscope
+///   write_file("heap.prof", Memory::AllocProfiler::heap_profile()); // pprof
+/// \endcode
+///
+/// While stopped, a hooked allocation costs one relaxed load; while running, a thread-local
+/// subtraction, plus a probe of one cache line on free. Only sampled allocations (twice: for
+/// the options, then to record) and frees of sampled blocks take the profiler's lock.
+/// Live samples are tracked in a 4096-slot table (about 2 GiB of live heap at the default
+/// rate); samples that find no slot still count towards the Allocated view.
+///
+class AllocProfiler {
+  public:
+    struct Options {
+        usize sample_bytes  = 512 * 1024;  // mean bytes between samples
+        usize max_frames    = 32;
+        bool  native_frames = true;  // also capture return addresses (needed for heap_profile)
+    };
+
+    enum class View : u8 {
+        Live,      // sampled allocations that have not been freed
+        Allocated  // everything allocated since start()
+    };
+
+    struct Site {
+        libcxx::vector<const Stacktrace::Location *> kairo;   // innermost first
+        libcxx::vector<void *>                       native;  // innermost first
+
+        // estimates, unsampled by the probability each sample had of being taken
+        double alloc_count{0};
+        double alloc_bytes{0};
+        double live_count{0};
+        double live_bytes{0};
+
+        // raw sample totals, what pprof's heap_v2 format expects
+        u64 samples{0};
+        u64 sampled_bytes{0};
+        u64 live_samples{0};
+        u64 live_sampled_bytes{0};
+    };
+
+    /// begin sampling (again). data from earlier runs is kept until reset().
+    static void start() { start(Options{}); }
+
+    static void start(Options options) {
+        Busy busy;
+        auto &s = state();
+
+        libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+        s.options = options;
+        if (s.options.sample_bytes == 0) {
+            s.options.sample_bytes = 1;
+        }
+
+        if (s.table.keys == nullptr) {
+            // small enough to stay cache-resident, since every free probes it. kept for the
+            // life of the process: a free on another thread may be probing it
+            constexpr usize slots = usize(1) << 12;
+            s.table.mask          = slots - 1;
+            s.table.keys          = new libcxx::atomic<uintptr_t>[slots]();
+            s.table.on_free       = &AllocProfiler::on_free;
+            s.slots.resize(slots);
+        }
+
+#if !defined(_WIN32)
+        if (s.options.native_frames) {
+            void *warm[1];
+            ::backtrace(warm, 1);  // the first call loads the unwinder, which allocates
+        }
+#endif
+
+        s.started = libcxx::chrono::steady_clock::now();
+        __profile::on_sample.store(&AllocProfiler::on_sample, libcxx::memory_order_relaxed);
+        __profile::live.store(&s.table, libcxx::memory_order_release);
+        __profile::sample_period.store(s.options.sample_bytes, libcxx::memory_order_release);
+    }
+
+    /// stop taking samples. frees of already sampled blocks are still tracked.
+    static void stop() {
+        auto &s = state();
+
+        libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+        if (__profile::sample_period.exchange(0, libcxx::memory_order_acq_rel) != 0) {
+            s.elapsed += libcxx::chrono::steady_clock::now() - s.started;
+        }
+    }
+
+    static bool running() {
+        return __profile::sample_period.load(libcxx::memory_order_relaxed) != 0;
+    }
+
+    /// forget all sites and live samples.
+    static void reset() {
+        Busy busy;
+        auto &s = state();
+
+        libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+        for (usize i = 0; s.table.keys != nullptr && i <= s.table.mask; ++i) {
+            // a key of 1 is a free that claimed the slot and is waiting for this lock; it
+            // stores the 0 itself once on_free() finds the slot detached from every site.
+            // anything else is swapped out so a free cannot claim it in between
+            uintptr_t key = s.table.keys[i].load(libcxx::memory_order_relaxed);
+            while (key > 1 && !s.table.keys[i].compare_exchange_weak(
+                                  key, uintptr_t(0), libcxx::memory_order_relaxed)) {}
+            s.slots[i].site = no_site;
+        }
+
+        s.sites.clear();
+        s.index.clear();
+        s.untracked = 0;
+        s.elapsed   = {};
+        s.started   = libcxx::chrono::steady_clock::now();
+    }
+
+    /// copy of every call site seen so far.
+    static libcxx::vector<Site> sites() {
+        Busy busy;
+        auto &s = state();
+
+        libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+        return s.sites;
+    }
+
+    /// seconds spent profiling, for turning Allocated totals into rates.
+    static double seconds() {
+        auto &s = state();
+
+        libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+        auto total = s.elapsed;
+        if (running()) {
+            total += libcxx::chrono::steady_clock::now() - s.started;
+        }
+        return libcxx::chrono::duration<double>(total).count();
+    }
+
+    /// folded stacks ("root;caller;callee bytes" per line) for flamegraph.pl, inferno or
+    /// speedscope. Kairo frames are used when a site has any, native symbols otherwise.
+    static libcxx::string folded(View view = View::Live) {
+        Busy busy;
+        libcxx::string out;
+
+        for (const Site &site : sites()) {
+            double bytes = (view == View::Live) ? site.live_bytes : site.alloc_bytes;
+            if (bytes < 0.5) {
+                continue;
+            }
+
+            libcxx::vector<libcxx::string> frames = symbolize(site);
+            for (usize i = frames.size(); i-- > 0;) {
+                out += frames[i];
+                out += (i != 0) ? ';' : ' ';
+            }
+            if (frames.empty()) {
+                out += "[unknown] ";
+            }
+
+            out += libcxx::to_string(static_cast<u64>(bytes + 0.5));
+            out += '\n';
+        }
+
+        return out;
+    }
+
+    /// the gperftools heap profile text format, which `pprof <binary> heap.prof` reads: live
+    /// and allocated totals per native stack, followed by the process's mappings so pprof can
+    /// symbolize. needs Options::native_frames.
+    static libcxx::string heap_profile() {
+        Busy busy;
+        auto &s = state();
+
+        libcxx::vector<Site> list;
+        u64                  period = 0;
+        {
+            libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+            list   = s.sites;
+            period = s.options.sample_bytes;
+        }
+
+        u64 live_n = 0, live_b = 0, alloc_n = 0, alloc_b = 0;
+        for (const Site &site : list) {
+            live_n += site.live_samples;
+            live_b += site.live_sampled_bytes;
+            alloc_n += site.samples;
+            alloc_b += site.sampled_bytes;
+        }
+
+        libcxx::string out;
+        char           line[160];  // NOLINT
+
+        libcxx::snprintf(line, sizeof(line),
+                         "heap profile: %llu: %llu [%llu: %llu] @ heap_v2/%llu\n",
+                         ull(live_n), ull(live_b), ull(alloc_n), ull(alloc_b), ull(period));
+        out += line;
+
+        for (const Site &site : list) {
+            libcxx::snprintf(line, sizeof(line), "%llu: %llu [%llu: %llu] @",
+                             ull(site.live_samples), ull(site.live_sampled_bytes),
+                             ull(site.samples), ull(site.sampled_bytes));
+            out += line;
+
+            for (void *pc : site.native) {
+                libcxx::snprintf(line, sizeof(line), " %p", pc);
+                out += line;
+            }
+            out += '\n';
+        }
+
+#if defined(__linux__)
+        out += "\nMAPPED_LIBRARIES:\n";
+        if (FILE *maps = libcxx::fopen("/proc/self/maps", "r")) {
+            char buf[4096];  // NOLINT
+            for (usize n; (n = libcxx::fread(buf, 1, sizeof(buf), maps)) > 0;) {
+                out.append(buf, n);
+            }
+            libcxx::fclose(maps);
+        }
+#endif
+
+        return out;
+    }
+
+    /// human-readable report: live heap and allocation rate, and the top sites by live bytes.
+    static libcxx::string summary(usize top = 10) {
+        Busy busy;
+        auto   list = sites();
+        double secs = seconds();
+
+        double live = 0, allocated = 0, count = 0;
+        for (const Site &site : list) {
+            live += site.live_bytes;
+            allocated += site.alloc_bytes;
+            count += site.alloc_count;
+        }
+
+        libcxx::sort(list.begin(), list.end(),
+                     [](const Site &a, const Site &b) { return a.live_bytes > b.live_bytes; });
+
+        libcxx::string out;
+        char           line[256];  // NOLINT
+
+        libcxx::snprintf(line, sizeof(line),
+                         "live heap ~%.1f KiB; allocated ~%.1f KiB in ~%.0f allocations over "
+                         "%.2fs (%.1f KiB/s); %zu sites\n",
+                         live / 1024, allocated / 1024, count, secs,
+                         secs > 0 ? allocated / 1024 / secs : 0.0, list.size());
+        out += line;
+
+        for (usize i = 0; i < list.size() && i < top; ++i) {
+            const Site &site   = list[i];
+            auto        frames = symbolize(site);
+
+            libcxx::snprintf(line, sizeof(line), "  %10.1f KiB live %10.1f KiB/s  ",
+                             site.live_bytes / 1024,
+                             secs > 0 ? site.alloc_bytes / 1024 / secs : 0.0);
+            out += line;
+            out += frames.empty() ? libcxx::string("[unknown]") : frames.front();
+            out += '\n';
+        }
+
+        return out;
+    }
+
+  private:
+    using ull = unsigned long long;
+
+    static constexpr u32 no_site = ~u32{0};
+
+    struct Slot {
+        u32    site;  // no_site once reset() has dropped the sample
+        u32    size;  // clamped; only used for the raw live totals
+        double count;
+        double bytes;
+    };
+
+    struct State {
+        libcxx::mutex                          mutex;
+        Options                                options;
+        libcxx::vector<Site>                   sites;
+        libcxx::unordered_map<u64, u32>        index;  // stack hash -> site
+        libcxx::vector<Slot>                   slots;  // parallel to table.keys
+        __profile::Table                       table{0, nullptr, nullptr};
+        u64                                    untracked{0};  // samples the table had no room for
+        libcxx::chrono::steady_clock::time_point started;
+        libcxx::chrono::steady_clock::duration   elapsed{};
+    };
+
+    static State &state() {
+        static State *s = new State;  // never destroyed: frees can arrive during exit
+        return *s;
+    }
+
+    /// the profiler's own allocations must not be sampled (that would re-enter it).
+    inline static thread_local bool busy_ = false;
+
+    struct Busy {
+        bool was;
+        Busy()
+            : was(busy_) {
+            busy_ = true;
+        }
+        ~Busy() { busy_ = was; }
+    };
+
+    /// exponential with mean `period`, from a per-thread xorshift generator.
+    static i64 next_interval(usize period) noexcept {
+        thread_local u64 rng = 0;
+        if (rng == 0) {
+            rng = reinterpret_cast<uintptr_t>(&rng) ^
+                  static_cast<u64>(libcxx::chrono::steady_clock::now().time_since_epoch().count()) ^
+                  0x9E3779B97F4A7C15ULL;
+        }
+
+        rng ^= rng >> 12;
+        rng ^= rng << 25;
+        rng ^= rng >> 27;
+        double u = static_cast<double>((rng * 0x2545F4914F6CDD1DULL) >> 11) * 0x1.0p-53;
+
+        double next = -libcxx::log(1.0 - u) * static_cast<double>(period);
+        return static_cast<i64>(next) + 1;
+    }
+
+    static void on_sample(void *ptr, usize size, i64 &countdown) noexcept {
+        const usize period = __profile::sample_period.load(libcxx::memory_order_relaxed);
+        if (period == 0) {
+            return;
+        }
+
+        // a thread's first countdown starts at zero; arm it instead of sampling
+        thread_local bool armed = false;
+        if (!armed || busy_) {
+            armed     = true;
+            countdown = next_interval(period);
+            return;
+        }
+
+        Busy busy;
+        countdown = next_interval(period);
+
+        try {
+            record(ptr, size, period);
+        } catch (...) {
+            // out of memory inside the profiler; drop the sample
+        }
+    }
+
+    static void record(void *ptr, usize size, usize period) {
+        auto &s = state();
+
+        // start() may be changing them; the stack is captured outside the lock
+        Options options;
+        {
+            libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+            options = s.options;
+        }
+
+        const void *kairo[64];   // NOLINT
+        void       *native[64];  // NOLINT
+        usize       nk = 0, nn = 0;
+        usize       max = options.max_frames < 64 ? options.max_frames : 64;
+
+        for (const Stacktrace::FrameSummary *f = Stacktrace::g_tls_kairo_head;
+             f != nullptr && nk < max; f = f->prev) {
+            kairo[nk++] = f->loc;
+        }
+
+        if (options.native_frames) {
+            void *raw[66];  // NOLINT
+            int   got = capture_native(raw, static_cast<int>(max + 2));
+            for (int i = 2; i < got; ++i) {  // skip record() and on_sample()
+                native[nn++] = raw[i];
+            }
+        }
+
+        u64 hash = 0xcbf29ce484222325ULL;
+        auto mix = [&](const void *p) {
+            hash ^= static_cast<u64>(reinterpret_cast<uintptr_t>(p));
+            hash *= 0x100000001b3ULL;
+        };
+        for (usize i = 0; i < nk; ++i) {
+            mix(kairo[i]);
+        }
+        mix(nullptr);
+        for (usize i = 0; i < nn; ++i) {
+            mix(native[i]);
+        }
+
+        // probability this allocation was sampled; its inverse scales the sample back up
+        const double p     = -libcxx::expm1(-static_cast<double>(size) / double(period));
+        const double count = 1.0 / p;
+        const double bytes = static_cast<double>(size) / p;
+
+        libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+
+        auto [it, fresh] = s.index.try_emplace(hash, static_cast<u32>(s.sites.size()));
+        if (fresh) {
+            Site site;
+            site.kairo.reserve(nk);
+            for (usize i = 0; i < nk; ++i) {
+                site.kairo.push_back(static_cast<const Stacktrace::Location *>(kairo[i]));
+            }
+            site.native.assign(native, native + nn);
+            s.sites.push_back(libcxx::move(site));
+        }
+
+        const u32 id   = it->second;
+        Site     &site = s.sites[id];
+        const u32 raw  = size > 0xFFFFFFFFULL ? 0xFFFFFFFFU : static_cast<u32>(size);
+
+        site.alloc_count += count;
+        site.alloc_bytes += bytes;
+        site.samples += 1;
+        site.sampled_bytes += size;
+
+        // claim a free slot in the pointer's window, fill it in, then publish the key
+        const usize first = __profile::window_of(s.table, ptr);
+        for (usize i = first; i < first + __profile::window; ++i) {
+            uintptr_t empty = 0;
+            if (s.table.keys[i].compare_exchange_strong(empty, uintptr_t(1),
+                                                        libcxx::memory_order_relaxed)) {
+                s.slots[i] = Slot{id, raw, count, bytes};
+                site.live_count += count;
+                site.live_bytes += bytes;
+                site.live_samples += 1;
+                site.live_sampled_bytes += raw;
+
+                s.table.keys[i].store(reinterpret_cast<uintptr_t>(ptr),
+                                      libcxx::memory_order_release);
+                return;
+            }
+        }
+
+        ++s.untracked;
+    }
+
+    static void on_free(usize slot) noexcept {
+        auto &s = state();
+        {
+            libcxx::lock_guard<libcxx::mutex> lock(s.mutex);
+
+            const Slot &sl = s.slots[slot];
+            if (sl.site < s.sites.size()) {
+                Site &site = s.sites[sl.site];
+                site.live_count -= sl.count;
+                site.live_bytes -= sl.bytes;
+                site.live_samples -= 1;
+                site.live_sampled_bytes -= sl.size;
+            }
+        }
+
+        s.table.keys[slot].store(0, libcxx::memory_order_release);
+    }
+
+    static int capture_native(void **out, int max) noexcept {
+#if defined(_WIN32)
+        return static_cast<int>(CaptureStackBackTrace(0, static_cast<DWORD>(max), out, nullptr));
+#else
+        return ::backtrace(out, max);
+#endif
+    }
+
+    /// frame names, innermost first. ';' is the folded-format separator and is replaced.
+    static libcxx::vector<libcxx::string> symbolize(const Site &site) {
+        libcxx::vector<libcxx::string> names;
+
+        auto clean = [](libcxx::string name) {
+            libcxx::replace(name.begin(), name.end(), ';', ',');
+            libcxx::replace(name.begin(), name.end(), '\n', ' ');
+            return name;
+        };
+
+        if (!site.kairo.empty()) {
+            for (const Stacktrace::Location *loc : site.kairo) {
+                char buf[1024];  // NOLINT
+                usize n = (loc != nullptr && loc->func != nullptr)
+                              ? libcxx::wcstombs(buf, loc->func, sizeof(buf) - 1)
+                              : usize(-1);
+                names.push_back(clean(n == usize(-1) ? "[kairo]" : libcxx::string(buf, n)));
+            }
+            return names;
+        }
+
+        for (void *pc : site.native) {
+            libcxx::string name;
+#if !defined(_WIN32)
+            Dl_info info{};
+            if (::dladdr(pc, &info) != 0 && info.dli_sname != nullptr) {
+                int   status    = 0;
+                char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+                name            = (status == 0 && demangled != nullptr) ? demangled
+                                                                        : info.dli_sname;
+                libcxx::free(demangled);
+            }
+#endif
+            if (name.empty()) {
+                char buf[32];  // NOLINT
+                libcxx::snprintf(buf, sizeof(buf), "%p", pc);
+                name = buf;
+            }
+            names.push_back(clean(libcxx::move(name)));
+        }
+
+        return names;
+    }
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#if defined(KAIRO_ALLOC_PROFILE_HOOKS)
+///
+/// replacement global allocation functions, emitted by the one translation unit that defines
+/// KAIRO_ALLOC_PROFILE_HOOKS. they allocate with malloc and report to the profiler.
+///
+namespace kairo::std::Memory::__profile {
+inline void *hooked_new(::std::size_t size, ::std::size_t align, bool nothrow) {
+    if (size == 0) {
+        size = 1;
+    }
+
+    for (;;) {
+        void *ptr = nullptr;
+#if defined(_MSC_VER)
+        ptr = (align > alignof(::std::max_align_t)) ? _aligned_malloc(size, align)
+                                                     : ::std::malloc(size);
+#else
+        if (align > alignof(::std::max_align_t)) {
+            if (::posix_memalign(&ptr, align, size) != 0) {
+                ptr = nullptr;
+            }
+        } else {
+            ptr = ::std::malloc(size);
+        }
+#endif
+        if (ptr != nullptr) {
+            profile_alloc(ptr, size);
+            return ptr;
+        }
+
+        ::std::new_handler handler = ::std::get_new_handler();
+        if (handler == nullptr) {
+            if (nothrow) {
+                return nullptr;
+            }
+            throw ::std::bad_alloc();
+        }
+
+        try {
+            handler();
+        } catch (...) {
+            if (nothrow) {
+                return nullptr;
+            }
+            throw;
+        }
+    }
+}
+
+inline void hooked_delete(void *ptr, ::std::size_t align) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    profile_free(ptr);
+#if defined(_MSC_VER)
+    if (align > alignof(::std::max_align_t)) {
+        _aligned_free(ptr);
+        return;
+    }
+#else
+    (void)align;
+#endif
+    ::std::free(ptr);
+}
+
+inline const bool installed = (global_hooks = true);
+}  // namespace kairo::std::Memory::__profile
+
+// NOLINTBEGIN
+#define _KAIRO_HOOK_NS ::kairo::std::Memory::__profile
+#define _KAIRO_MAX_ALIGN alignof(::std::max_align_t)
+
+void *operator new(::std::size_t n) {
+    return _KAIRO_HOOK_NS::hooked_new(n, _KAIRO_MAX_ALIGN, false);
+}
+void *operator new[](::std::size_t n) {
+    return _KAIRO_HOOK_NS::hooked_new(n, _KAIRO_MAX_ALIGN, false);
+}
+void *operator new(::std::size_t n, const ::std::nothrow_t &) noexcept {
+    return _KAIRO_HOOK_NS::hooked_new(n, _KAIRO_MAX_ALIGN, true);
+}
+void *operator new[](::std::size_t n, const ::std::nothrow_t &) noexcept {
+    return _KAIRO_HOOK_NS::hooked_new(n, _KAIRO_MAX_ALIGN, true);
+}
+void *operator new(::std::size_t n, ::std::align_val_t a) {
+    return _KAIRO_HOOK_NS::hooked_new(n, static_cast<::std::size_t>(a), false);
+}
+void *operator new[](::std::size_t n, ::std::align_val_t a) {
+    return _KAIRO_HOOK_NS::hooked_new(n, static_cast<::std::size_t>(a), false);
+}
+void *operator new(::std::size_t n, ::std::align_val_t a, const ::std::nothrow_t &) noexcept {
+    return _KAIRO_HOOK_NS::hooked_new(n, static_cast<::std::size_t>(a), true);
+}
+void *operator new[](::std::size_t n, ::std::align_val_t a, const ::std::nothrow_t &) noexcept {
+    return _KAIRO_HOOK_NS::hooked_new(n, static_cast<::std::size_t>(a), true);
+}
+
+void operator delete(void *p) noexcept { _KAIRO_HOOK_NS::hooked_delete(p, _KAIRO_MAX_ALIGN); }
+void operator delete[](void *p) noexcept { _KAIRO_HOOK_NS::hooked_delete(p, _KAIRO_MAX_ALIGN); }
+void operator delete(void *p, ::std::size_t) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, _KAIRO_MAX_ALIGN);
+}
+void operator delete[](void *p, ::std::size_t) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, _KAIRO_MAX_ALIGN);
+}
+void operator delete(void *p, const ::std::nothrow_t &) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, _KAIRO_MAX_ALIGN);
+}
+void operator delete[](void *p, const ::std::nothrow_t &) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, _KAIRO_MAX_ALIGN);
+}
+void operator delete(void *p, ::std::align_val_t a) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, static_cast<::std::size_t>(a));
+}
+void operator delete[](void *p, ::std::align_val_t a) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, static_cast<::std::size_t>(a));
+}
+void operator delete(void *p, ::std::size_t, ::std::align_val_t a) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, static_cast<::std::size_t>(a));
+}
+void operator delete[](void *p, ::std::size_t, ::std::align_val_t a) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, static_cast<::std::size_t>(a));
+}
+void operator delete(void *p, ::std::align_val_t a, const ::std::nothrow_t &) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, static_cast<::std::size_t>(a));
+}
+void operator delete[](void *p, ::std::align_val_t a, const ::std::nothrow_t &) noexcept {
+    _KAIRO_HOOK_NS::hooked_delete(p, static_cast<::std::size_t>(a));
+}
+
+#undef _KAIRO_MAX_ALIGN
+#undef _KAIRO_HOOK_NS
+// NOLINTEND
+#endif  // KAIRO_ALLOC_PROFILE_HOOKS
+
+#endif  // _$_HX_CORE_M13ALLOC_PROFILE
@@ -14,6 +14,7 @@
 
 #include <include/config/config.hh>
 
+#include "alloc_hooks.hh"
 #include "forwarding.hh"
 
 H_NAMESPACE_BEGIN
@@ -28,7 +29,11 @@ constexpr _Tp *_H_RESERVED$new(_Ty &&...t) {          // NOLINT
 
 template <typename _Tp, typename... _Ty>
 constexpr _Tp *create(_Ty &&...t) {          // NOLINT
-    return new _Tp(std::Memory::forward<_Ty>(t)...);  // NOLINT
+    _Tp *ptr = new _Tp(std::Memory::forward<_Ty>(t)...);  // NOLINT
+    if !consteval {
+        std::Memory::profile_runtime_alloc(ptr, sizeof(_Tp));
+    }
+    return ptr;
 }
 
 template <typename _Tp, typename... _Ty>
@@ -40,6 +45,9 @@ constexpr _Tp *create(void* dest, _Ty &&...t) {          // NOLINT
 // make a function called erase which calls c++ delete
 template <typename _Tp>
 constexpr void destroy(_Tp *ptr) {  // NOLINT
+    if !consteval {
+        std::Memory::profile_runtime_free(ptr);
+    }
     delete ptr;  // NOLINT
 }
 
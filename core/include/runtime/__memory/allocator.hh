@@ -0,0 +1,318 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M9ALLOCATOR
+#define _$_HX_CORE_M9ALLOCATOR
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "small_alloc.hh"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief Snapshot of an allocator's counters (the C++ side of `AllocatorStats` in
+///        pkgs/std/arc/types.k). Byte counts are requested sizes, not what the backend rounds
+///        them up to.
+///
+struct AllocatorStats {
+    /// bucket i counts allocations of at most 16 << i bytes; the last bucket takes the rest.
+    static constexpr usize buckets = 16;
+
+    u64 total_allocations{0};
+    u64 total_deallocations{0};
+    u64 currently_allocated{0};  // bytes live right now
+    u64 max_allocated{0};        // high-water mark of currently_allocated
+    u64 live_blocks{0};
+    u64 failed_allocations{0};
+
+    array<u64, buckets> size_histogram{};
+
+    static constexpr usize bucket_of(usize size) noexcept {
+        usize b = 0;
+        while (b + 1 < buckets && size > (usize(16) << b)) {
+            ++b;
+        }
+        return b;
+    }
+};
+
+///
+/// \brief Polymorphic allocator interface (the runtime behind `Allocator` in
+///        pkgs/std/arc/types.k). It is also a `std::pmr::memory_resource`, so any allocator
+///        can back the `Memory::pmr` containers:
+/// \code
+///   Memory::PoolAllocator pool;
+///   Memory::pmr::vec<Node> nodes(&pool);
+///   print(pool.get_stats().currently_allocated);
+/// \endcode
+///
+/// Implementations provide do_alloc/do_dealloc (and do_realloc when they can grow in place);
+/// the public functions add the statistics, which use relaxed atomics so one allocator can be
+/// shared between threads if its backend is thread-safe.
+///
+class Allocator : public libcxx::pmr::memory_resource {
+  public:
+    static constexpr usize default_alignment = alignof(libcxx::max_align_t);
+
+    Allocator()                             = default;
+    Allocator(const Allocator &)            = delete;
+    Allocator &operator=(const Allocator &) = delete;
+    ~Allocator() override                   = default;
+
+    /// at least `size` bytes aligned to `alignment`, or nullptr on failure.
+    void *alloc(usize size, usize alignment = default_alignment) {
+        void *ptr = can_alloc(size, alignment) ? do_alloc(size, alignment) : nullptr;
+        if (ptr == nullptr) {
+            failed_.fetch_add(1, libcxx::memory_order_relaxed);
+            return nullptr;
+        }
+        record_alloc(size);
+        return ptr;
+    }
+
+    /// `size` and `alignment` must match the allocation.
+    void dealloc(void *ptr, usize size, usize alignment = default_alignment) {
+        if (ptr == nullptr) {
+            return;
+        }
+        do_dealloc(ptr, size, alignment);
+        record_free(size);
+    }
+
+    /// resize a block. the contents move bytewise, so only use it for trivially relocatable
+    /// data (see realloc_array). returns nullptr on failure, leaving the old block intact.
+    void *realloc(void *ptr, usize old_size, usize new_size, usize alignment = default_alignment) {
+        if (ptr == nullptr) {
+            return alloc(new_size, alignment);
+        }
+
+        void *grown = do_realloc(ptr, old_size, new_size, alignment);
+        if (grown == nullptr) {
+            failed_.fetch_add(1, libcxx::memory_order_relaxed);
+            return nullptr;
+        }
+
+        record_free(old_size);
+        record_alloc(new_size);
+        return grown;
+    }
+
+    void *alloc_d(usize size) { return alloc(size, default_alignment); }
+    void *realloc_d(void *ptr, usize old_size, usize new_size) {
+        return realloc(ptr, old_size, new_size, default_alignment);
+    }
+
+    virtual bool can_alloc(usize /*size*/, usize alignment) const {
+        return alignment != 0 && (alignment & (alignment - 1)) == 0;
+    }
+
+    AllocatorStats get_stats() const {
+        AllocatorStats s;
+        s.total_allocations   = allocs_.load(libcxx::memory_order_relaxed);
+        s.total_deallocations = frees_.load(libcxx::memory_order_relaxed);
+        s.currently_allocated = bytes_.load(libcxx::memory_order_relaxed);
+        s.max_allocated       = peak_.load(libcxx::memory_order_relaxed);
+        s.live_blocks         = s.total_allocations - s.total_deallocations;
+        s.failed_allocations  = failed_.load(libcxx::memory_order_relaxed);
+        for (usize i = 0; i < AllocatorStats::buckets; ++i) {
+            s.size_histogram[i] = histogram_[i].load(libcxx::memory_order_relaxed);
+        }
+        return s;
+    }
+
+  protected:
+    virtual void *do_alloc(usize size, usize alignment)              = 0;
+    virtual void  do_dealloc(void *ptr, usize size, usize alignment) = 0;
+
+    /// default: allocate, copy, free.
+    virtual void *do_realloc(void *ptr, usize old_size, usize new_size, usize alignment) {
+        void *fresh = do_alloc(new_size, alignment);
+        if (fresh != nullptr) {
+            libcxx::memcpy(fresh, ptr, old_size < new_size ? old_size : new_size);
+            do_dealloc(ptr, old_size, alignment);
+        }
+        return fresh;
+    }
+
+    // memory_resource: throws bad_alloc like every other resource instead of returning null
+    void *do_allocate(usize bytes, usize alignment) final {
+        void *ptr = alloc(bytes, alignment);
+        if (ptr == nullptr) {
+            throw libcxx::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void do_deallocate(void *ptr, usize bytes, usize alignment) final {
+        dealloc(ptr, bytes, alignment);
+    }
+
+    bool do_is_equal(const libcxx::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+  private:
+    void record_alloc(usize size) {
+        allocs_.fetch_add(1, libcxx::memory_order_relaxed);
+        histogram_[AllocatorStats::bucket_of(size)].fetch_add(1, libcxx::memory_order_relaxed);
+
+        u64 now  = bytes_.fetch_add(size, libcxx::memory_order_relaxed) + size;
+        u64 peak = peak_.load(libcxx::memory_order_relaxed);
+        while (now > peak &&
+               !peak_.compare_exchange_weak(peak, now, libcxx::memory_order_relaxed)) {}
+    }
+
+    void record_free(usize size) {
+        frees_.fetch_add(1, libcxx::memory_order_relaxed);
+        bytes_.fetch_sub(size, libcxx::memory_order_relaxed);
+    }
+
+    libcxx::atomic<u64> allocs_{0};
+    libcxx::atomic<u64> frees_{0};
+    libcxx::atomic<u64> bytes_{0};
+    libcxx::atomic<u64> peak_{0};
+    libcxx::atomic<u64> failed_{0};
+
+    array<libcxx::atomic<u64>, AllocatorStats::buckets> histogram_{};
+};
+
+///
+/// \brief malloc-backed allocator. Growth goes through ::realloc, which extends the block in
+///        place when the heap has room behind it instead of allocating and copying.
+///
+class DefaultAllocator final : public Allocator {
+  protected:
+    void *do_alloc(usize size, usize alignment) override {
+        if (alignment <= default_alignment) {
+            return libcxx::malloc(size != 0 ? size : 1);
+        }
+#if defined(_MSC_VER)
+        return _aligned_malloc(size, alignment);
+#else
+        void *ptr = nullptr;
+        return ::posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+    }
+
+    void do_dealloc(void *ptr, usize /*size*/, usize alignment) override {
+#if defined(_MSC_VER)
+        if (alignment > default_alignment) {
+            _aligned_free(ptr);
+            return;
+        }
+#else
+        (void)alignment;
+#endif
+        libcxx::free(ptr);
+    }
+
+    void *do_realloc(void *ptr, usize old_size, usize new_size, usize alignment) override {
+        if (alignment <= default_alignment) {
+            return libcxx::realloc(ptr, new_size != 0 ? new_size : 1);
+        }
+#if defined(_MSC_VER)
+        return _aligned_realloc(ptr, new_size, alignment);
+#else
+        return Allocator::do_realloc(ptr, old_size, new_size, alignment);
+#endif
+    }
+};
+
+///
+/// \brief The small-object pool (small_alloc) as an Allocator. Thread-safe.
+///
+class PoolAllocator final : public Allocator {
+  protected:
+    void *do_alloc(usize size, usize alignment) override { return small_alloc(size, alignment); }
+    void  do_dealloc(void *ptr, usize size, usize alignment) override {
+        small_free(ptr, size, alignment);
+    }
+};
+
+///
+/// \brief Any memory_resource (an Arena, a pmr pool, ...) behind the Allocator interface, with
+///        statistics. Thread-safety is the resource's.
+///
+class ResourceAllocator final : public Allocator {
+  public:
+    explicit ResourceAllocator(libcxx::pmr::memory_resource *resource)
+        : resource_(resource) {}
+
+    libcxx::pmr::memory_resource *resource() const { return resource_; }
+
+  protected:
+    void *do_alloc(usize size, usize alignment) override {
+        try {
+            return resource_->allocate(size, alignment);
+        } catch (const libcxx::bad_alloc &) {
+            return nullptr;
+        }
+    }
+
+    void do_dealloc(void *ptr, usize size, usize alignment) override {
+        resource_->deallocate(ptr, size, alignment);
+    }
+
+  private:
+    libcxx::pmr::memory_resource *resource_;
+};
+
+/// process-wide DefaultAllocator.
+inline DefaultAllocator &default_allocator() {
+    static DefaultAllocator instance;
+    return instance;
+}
+
+/// allocator handle for containers; converts from any Allocator (or memory_resource) pointer.
+template <typename T>
+using allocator_handle = libcxx::pmr::polymorphic_allocator<T>;
+
+///
+/// \brief Resize an array of T allocated from `a`. Trivially copyable element types go through
+///        Allocator::realloc (in-place growth when the backend allows); anything else is moved
+///        element by element into a new block. `ptr` must not be used afterwards unless this
+///        returns nullptr.
+///
+template <typename T>
+T *realloc_array(Allocator &a, T *ptr, usize old_count, usize new_count) {
+    if constexpr (libcxx::is_trivially_copyable_v<T>) {
+        return static_cast<T *>(
+            a.realloc(ptr, old_count * sizeof(T), new_count * sizeof(T), alignof(T)));
+    } else {
+        auto *fresh = static_cast<T *>(a.alloc(new_count * sizeof(T), alignof(T)));
+        if (fresh == nullptr) {
+            return nullptr;
+        }
+
+        usize keep = old_count < new_count ? old_count : new_count;
+        for (usize i = 0; i < keep; ++i) {
+            ::new (fresh + i) T(libcxx::move(ptr[i]));
+        }
+        for (usize i = 0; i < old_count; ++i) {
+            ptr[i].~T();
+        }
+
+        a.dealloc(ptr, old_count * sizeof(T), alignof(T));
+        return fresh;
+    }
+}
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M9ALLOCATOR
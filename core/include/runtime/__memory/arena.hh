@@ -0,0 +1,319 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M5ARENA
+#define _$_HX_CORE_M5ARENA
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "forwarding.hh"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief Monotonic (bump) allocator: memory is carved out of large chunks by advancing a
+///        pointer and is only given back all at once, by rewind(), reset() or destruction.
+///
+/// Chunks come from an upstream `memory_resource` (global new/delete by default) and are kept
+/// for reuse when the arena is rewound, so a request loop that resets its arena every iteration
+/// stops touching the upstream allocator after the first few iterations.
+///
+/// Objects built with make() have their destructors run (newest first) when the arena is
+/// rewound past them; storage from allocate() is raw and never finalized.
+///
+/// The arena is also a `std::pmr::memory_resource`, so the pmr containers can live in it:
+/// \code
+///   Memory::Arena arena;
+///   Memory::pmr::vec<int> v(&arena);
+///   {
+///       auto scope = arena.scope();  // everything allocated below is freed at the brace
+///       auto *node = arena.make<Node>(1, 2);
+///   }
+/// \endcode
+///
+/// Not thread-safe; use one arena per thread (see scratch()).
+///
+class Arena : public libcxx::pmr::memory_resource {
+    struct Chunk {
+        Chunk *next;
+        usize  size;   // usable bytes after the header
+        bool   owned;  // false for the caller's initial buffer
+
+        unsigned char *begin() { return reinterpret_cast<unsigned char *>(this + 1); }
+        unsigned char *end() { return begin() + size; }
+    };
+
+    struct Finalizer {
+        void (*fn)(void *);
+        void      *object;
+        Finalizer *next;
+    };
+
+  public:
+    static constexpr usize default_chunk_size = 64 * 1024;
+
+    /// position in the arena; rewind() frees everything allocated after it was taken.
+    struct Marker {
+        Chunk         *chunk{nullptr};
+        unsigned char *ptr{nullptr};
+        Finalizer     *finalizers{nullptr};
+        usize          used{0};
+    };
+
+    /// rewinds the arena to where it was when the scope was opened.
+    class Scope {
+      public:
+        explicit Scope(Arena &arena)
+            : arena_(arena)
+            , marker_(arena.mark()) {}
+
+        Scope(const Scope &)            = delete;
+        Scope &operator=(const Scope &) = delete;
+
+        ~Scope() { arena_.rewind(marker_); }
+
+      private:
+        Arena &arena_;
+        Marker marker_;
+    };
+
+    explicit Arena(usize                          chunk_size = default_chunk_size,
+                   libcxx::pmr::memory_resource *upstream   = libcxx::pmr::new_delete_resource())
+        : chunk_size_(chunk_size < 256 ? 256 : chunk_size)
+        , upstream_(upstream) {}
+
+    /// start out in `buffer` (e.g. a stack array) and only go upstream once it is full.
+    Arena(void                         *buffer,
+          usize                         size,
+          usize                         chunk_size = default_chunk_size,
+          libcxx::pmr::memory_resource *upstream   = libcxx::pmr::new_delete_resource())
+        : Arena(chunk_size, upstream) {
+        void *at    = buffer;
+        usize space = size;
+        if (libcxx::align(alignof(Chunk), sizeof(Chunk), at, space) != nullptr &&
+            space > sizeof(Chunk)) {
+            first_ = ::new (at) Chunk{nullptr, space - sizeof(Chunk), false};
+            enter(first_);
+        }
+    }
+
+    Arena(const Arena &)            = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    ~Arena() override { release(); }
+
+    /// aligned storage for `size` bytes. the fast path is a pointer bump; this hides
+    /// memory_resource::allocate so direct calls skip the virtual dispatch.
+    void *allocate(usize size, usize align = alignof(libcxx::max_align_t)) {
+        auto  addr    = reinterpret_cast<libcxx::uintptr_t>(ptr_);
+        auto  aligned = (addr + (align - 1)) & ~static_cast<libcxx::uintptr_t>(align - 1);
+        usize pad     = aligned - addr;
+
+        if (ptr_ == nullptr || pad + size > static_cast<usize>(end_ - ptr_)) {
+            return allocate_slow(size, align);
+        }
+
+        ptr_ += pad + size;
+        used_ += size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    /// uninitialized storage for n objects of T.
+    template <typename T>
+    T *allocate_array(usize n) {
+        return static_cast<T *>(allocate(sizeof(T) * n, alignof(T)));
+    }
+
+    /// construct a T in the arena. unless T is trivially destructible its destructor runs when
+    /// the arena is rewound past it, reset, or destroyed.
+    template <typename T, typename... Args>
+    T *make(Args &&...args) {
+        void *mem = allocate(sizeof(T), alignof(T));
+        T    *obj = ::new (mem) T(std::Memory::forward<Args>(args)...);
+
+        if constexpr (!libcxx::is_trivially_destructible_v<T>) {
+            auto *fin   = allocate_array<Finalizer>(1);
+            fin->fn     = [](void *p) { static_cast<T *>(p)->~T(); };
+            fin->object = obj;
+            fin->next   = finalizers_;
+            finalizers_ = fin;
+        }
+
+        return obj;
+    }
+
+    Marker mark() const { return Marker{cur_, ptr_, finalizers_, used_}; }
+
+    /// free everything allocated since `m`, in O(1) plus one call per finalized object. the
+    /// chunks stay with the arena and are reused by later allocations.
+    void rewind(const Marker &m) {
+        run_finalizers(m.finalizers);
+        used_ = m.used;
+
+        if (m.chunk == nullptr) {
+            cur_ = nullptr;
+            ptr_ = end_ = nullptr;
+            if (first_ != nullptr) {
+                enter(first_);
+            }
+            return;
+        }
+
+        cur_ = m.chunk;
+        ptr_ = m.ptr;
+        end_ = m.chunk->end();
+    }
+
+    /// free everything, keeping the chunks for reuse.
+    void reset() { rewind(Marker{}); }
+
+    /// free everything and hand every chunk back upstream.
+    void release() {
+        run_finalizers(nullptr);
+
+        Chunk *keep = (first_ != nullptr && !first_->owned) ? first_ : nullptr;
+        for (Chunk *c = first_; c != nullptr;) {
+            Chunk *next = c->next;
+            if (c->owned) {
+                upstream_->deallocate(c, sizeof(Chunk) + c->size, alignof(Chunk));
+            }
+            c = next;
+        }
+
+        first_ = keep;
+        if (first_ != nullptr) {
+            first_->next = nullptr;
+        }
+        reserved_ = 0;
+        reset();
+    }
+
+    Scope scope() { return Scope(*this); }
+
+    /// bytes handed out since the last reset (alignment padding not included).
+    usize bytes_used() const { return used_; }
+
+    /// bytes currently held from upstream.
+    usize bytes_reserved() const { return reserved_; }
+
+    usize                         chunk_size() const { return chunk_size_; }
+    libcxx::pmr::memory_resource *upstream() const { return upstream_; }
+
+  protected:
+    void *do_allocate(usize bytes, usize alignment) override { return allocate(bytes, alignment); }
+
+    // individual frees are ignored, except that the most recent allocation is popped so
+    // a growing vector can reuse the space it just left.
+    void do_deallocate(void *p, usize bytes, usize /*alignment*/) override {
+        if (static_cast<unsigned char *>(p) + bytes == ptr_) {
+            ptr_ = static_cast<unsigned char *>(p);
+            used_ -= bytes;
+        }
+    }
+
+    bool do_is_equal(const libcxx::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+  private:
+    void enter(Chunk *c) {
+        cur_ = c;
+        ptr_ = c->begin();
+        end_ = c->end();
+    }
+
+    void *allocate_slow(usize size, usize align) {
+        const usize need = size + align;
+
+        // a kept chunk after the current one (from before a rewind) is reused when it fits
+        Chunk *next = (cur_ != nullptr) ? cur_->next : first_;
+        if (next == nullptr || next->size < need) {
+            usize cap   = need > chunk_size_ - sizeof(Chunk) ? need : chunk_size_ - sizeof(Chunk);
+            void *mem   = upstream_->allocate(sizeof(Chunk) + cap, alignof(Chunk));
+            Chunk *c    = ::new (mem) Chunk{next, cap, true};
+            reserved_  += sizeof(Chunk) + cap;
+
+            if (cur_ != nullptr) {
+                cur_->next = c;
+            } else {
+                first_ = c;
+            }
+            next = c;
+        }
+
+        enter(next);
+        return allocate(size, align);
+    }
+
+    void run_finalizers(Finalizer *until) {
+        while (finalizers_ != until && finalizers_ != nullptr) {
+            Finalizer *f = finalizers_;
+            finalizers_  = f->next;
+            f->fn(f->object);
+        }
+    }
+
+    usize                         chunk_size_;
+    libcxx::pmr::memory_resource *upstream_;
+
+    Chunk         *first_{nullptr};
+    Chunk         *cur_{nullptr};
+    unsigned char *ptr_{nullptr};
+    unsigned char *end_{nullptr};
+    Finalizer     *finalizers_{nullptr};
+    usize          used_{0};
+    usize          reserved_{0};
+};
+
+///
+/// \brief Per-thread scratch arena for short-lived temporaries. Callers open a scope and
+///        everything they allocate is gone when it closes:
+/// \code
+///   auto scope = Memory::scratch().scope();
+///   auto *tmp  = Memory::scratch().allocate_array<char>(len);
+/// \endcode
+///
+inline Arena &scratch() {
+    thread_local Arena arena(16 * 1024);
+    return arena;
+}
+
+/// containers that take their memory from an Arena (or any other memory_resource).
+namespace pmr {
+template <typename T>
+using vec = libcxx::pmr::vector<T>;
+
+template <typename K, typename V, class C = libcxx::less<K>>
+using map = libcxx::pmr::map<K, V, C>;
+
+template <typename T, class C = libcxx::less<T>>
+using set = libcxx::pmr::set<T, C>;
+
+template <typename T>
+using list = libcxx::pmr::list<T>;
+
+template <typename CharT>
+using basic_string = libcxx::pmr::basic_string<CharT>;
+
+using string  = basic_string<wchar_t>;
+using nstring = basic_string<char>;
+}  // namespace pmr
+}  // namespace Memory
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M5ARENA
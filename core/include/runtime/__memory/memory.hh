@@ -13,15 +13,24 @@
 #define _$_HX_CORE_M7MEMORY
 
 #include "alignment.hh"
+#include "arena.hh"
+#include "small_alloc.hh"
+#include "pool.hh"
+#include "allocator.hh"
+#include "pages.hh"
+#include "alloc_hooks.hh"
 #include "forwarding.hh"
 #include "exchange.hh"
 #include "stack_bounds.hh"
 #include "heap_bounds.hh"
 #include "rot_bounds.hh"
+#include "memory_map.hh"
 #include "address_type.hh"
 #include "conversions.hh"
 #include "allocation.hh"
 #include "platform_memory.hh"
 #include "c-array.hh"
+#include "relocate.hh"
+#include "small_vec.hh"
 
 #endif  // _$_HX_CORE_M7MEMORY
@@ -0,0 +1,369 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M10MEMORY_MAP
+#define _$_HX_CORE_M10MEMORY_MAP
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief Snapshot of the process's address space, read from /proc/self/maps. Lookups are a
+///        binary search over a sorted interval array and make no system calls; the map is only
+///        re-read by refresh() (or refresh_on_miss(), which address_type() uses when an
+///        address falls outside every known region, e.g. after a new mmap).
+///
+/// Snapshots are immutable and published through an atomic pointer, so lookups from any
+/// thread never block on a refresh. A replaced snapshot is freed once no lookup is inside it
+/// (readers are counted for the few instructions of a search); at most `retired_limit` wait
+/// for that, after which the refresh waits for the readers to drain. A re-read that finds the
+/// same regions is dropped and backs the miss-driven refresh off, up to once per second.
+///
+/// Only Linux has /proc/self/maps. Elsewhere the map stays empty and find() always misses.
+///
+class MemoryMap {
+  public:
+    enum Access : u8 { Read = 1, Write = 2, Exec = 4, Shared = 8 };
+
+    enum class Kind : u8 {
+        Heap,       // [heap], the brk area
+        Stack,      // [stack], the main thread's stack
+        Anonymous,  // anonymous mappings: malloc arenas, mmap'd buffers
+        Guarded,    // anonymous, directly above a PROT_NONE guard: how thread stacks are laid out
+        Image,      // file-backed: executables, shared libraries, mapped files
+        Special     // [vdso], [vvar], [vsyscall] and other kernel mappings
+    };
+
+    struct Region {
+        uintptr_t begin;
+        uintptr_t end;  // exclusive
+        u8        access;
+        Kind      kind;
+
+        bool readable() const { return (access & Read) != 0; }
+        bool writable() const { return (access & Write) != 0; }
+        bool executable() const { return (access & Exec) != 0; }
+
+        bool operator==(const Region &) const = default;
+    };
+
+    MemoryMap() = default;
+
+    MemoryMap(const MemoryMap &)            = delete;
+    MemoryMap &operator=(const MemoryMap &) = delete;
+
+    ~MemoryMap() {
+        delete current_.load(libcxx::memory_order_relaxed);
+        for (const Snapshot *s : retired_) {
+            delete s;
+        }
+    }
+
+    /// replaced snapshots kept while lookups may still be inside them.
+    static constexpr usize retired_limit = 4;
+
+    /// lowest address the kernel will map (vm.mmap_min_addr); a miss below it is never new.
+    static constexpr uintptr_t min_address = 0x10000;
+
+    /// the process-wide map, read on first use.
+    static MemoryMap &global() {
+        static MemoryMap map;
+        return map;
+    }
+
+    /// region containing ptr, if it is in the current snapshot. returned by value: the snapshot
+    /// it came from may be freed by a later refresh.
+    libcxx::optional<Region> find(const void *ptr) const {
+        ReadGuard       guard(*this);
+        const Snapshot *snap = guard.snap;
+        auto            addr = reinterpret_cast<uintptr_t>(ptr);
+
+        // first region that begins after addr; the one before it is the only candidate
+        const auto &r  = snap->regions;
+        auto        it = libcxx::upper_bound(
+            r.begin(), r.end(), addr, [](uintptr_t a, const Region &reg) { return a < reg.begin; });
+
+        if (it == r.begin()) {
+            return libcxx::nullopt;
+        }
+
+        --it;
+        return addr < it->end ? libcxx::optional<Region>(*it) : libcxx::nullopt;
+    }
+
+    /// re-read the map now. returns true if it changed.
+    bool refresh() {
+        libcxx::lock_guard<libcxx::mutex> lock(mutex_);
+        return publish(load());
+    }
+
+    /// re-read the map unless that happened within `min_interval`, or within the back-off that
+    /// re-reads finding nothing new build up. returns true if the map changed.
+    bool refresh_if_stale(
+        libcxx::chrono::nanoseconds min_interval = libcxx::chrono::milliseconds(10)) {
+        auto now  = libcxx::chrono::steady_clock::now().time_since_epoch().count();
+        auto was  = last_refresh_.load(libcxx::memory_order_relaxed);
+        auto wait = libcxx::max(min_interval.count(), backoff_.load(libcxx::memory_order_relaxed));
+        if (now - was < wait) {
+            return false;
+        }
+
+        libcxx::unique_lock<libcxx::mutex> lock(mutex_, libcxx::try_to_lock);
+        if (!lock.owns_lock()) {
+            return false;  // another thread is refreshing right now
+        }
+
+        return publish(load());
+    }
+
+    /// refresh after find(ptr) missed, if ptr could be in a mapping made since the last read.
+    /// returns true if the map changed and find() is worth retrying.
+    bool refresh_on_miss(const void *ptr) {
+        if (reinterpret_cast<uintptr_t>(ptr) < min_address) {
+            return false;  // null and near-null pointers are never mapped
+        }
+        return refresh_if_stale();
+    }
+
+    /// number of times the map has changed.
+    u64 generation() const { return ReadGuard(*this).snap->generation; }
+
+    /// copy of the current regions, sorted by address.
+    libcxx::vector<Region> regions() const { return ReadGuard(*this).snap->regions; }
+
+  private:
+    struct Snapshot {
+        libcxx::vector<Region> regions;
+        u64                    generation{0};
+    };
+
+    /// counts a lookup in readers_ while it uses the current snapshot. seq_cst on both sides:
+    /// once publish() sees readers_ at zero after swapping current_, every later reader loads
+    /// the new snapshot, so the retired ones can go.
+    struct ReadGuard {
+        const MemoryMap &map;
+        const Snapshot  *snap;
+
+        explicit ReadGuard(const MemoryMap &m)
+            : map(m) {
+            map.ensure_loaded();
+            map.readers_.fetch_add(1, libcxx::memory_order_seq_cst);
+            snap = map.current_.load(libcxx::memory_order_seq_cst);
+        }
+
+        ~ReadGuard() { map.readers_.fetch_sub(1, libcxx::memory_order_release); }
+
+        ReadGuard(const ReadGuard &)            = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+    };
+
+    void ensure_loaded() const {
+        if (current_.load(libcxx::memory_order_acquire) != nullptr) [[likely]] {
+            return;
+        }
+
+        libcxx::lock_guard<libcxx::mutex> lock(mutex_);
+        if (current_.load(libcxx::memory_order_acquire) == nullptr) {
+            const_cast<MemoryMap *>(this)->publish(load());
+        }
+    }
+
+    // caller holds mutex_. returns true if fresh replaced the current snapshot.
+    bool publish(Snapshot *fresh) {
+        const Snapshot *old = current_.load(libcxx::memory_order_relaxed);
+        auto now = libcxx::chrono::steady_clock::now().time_since_epoch().count();
+        last_refresh_.store(now, libcxx::memory_order_relaxed);
+
+        if (old != nullptr && old->regions == fresh->regions) {
+            // nothing new: keep the old snapshot and re-read less often on misses
+            delete fresh;
+            auto max_backoff = libcxx::chrono::nanoseconds(libcxx::chrono::seconds(1)).count();
+            auto backoff     = backoff_.load(libcxx::memory_order_relaxed);
+            backoff_.store(libcxx::min(libcxx::max<i64>(backoff * 2, min_backoff), max_backoff),
+                           libcxx::memory_order_relaxed);
+            return false;
+        }
+
+        fresh->generation = (old != nullptr) ? old->generation + 1 : 1;
+        current_.store(fresh, libcxx::memory_order_seq_cst);
+        backoff_.store(0, libcxx::memory_order_relaxed);
+
+        if (old != nullptr) {
+            retired_.push_back(old);
+            reclaim(retired_.size() > retired_limit);
+        }
+        return true;
+    }
+
+    // caller holds mutex_ and has just swapped current_. frees the retired snapshots if no
+    // lookup is running; with `wait`, spins until that is so (lookups are a binary search).
+    void reclaim(bool wait) {
+        while (readers_.load(libcxx::memory_order_seq_cst) != 0) {
+            if (!wait) {
+                return;
+            }
+            libcxx::this_thread::yield();
+        }
+
+        for (const Snapshot *s : retired_) {
+            delete s;
+        }
+        retired_.clear();
+    }
+
+    static Snapshot *load() {
+        auto *snap = new Snapshot;
+
+#if defined(__linux__)
+        int fd = ::open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return snap;
+        }
+
+        libcxx::string text;
+        char           buf[16384];  // NOLINT
+        for (;;) {
+            ssize_t n = ::read(fd, buf, sizeof(buf));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            text.append(buf, static_cast<usize>(n));
+        }
+        ::close(fd);
+
+        snap->regions.reserve(libcxx::count(text.begin(), text.end(), '\n'));
+
+        usize pos = 0;
+        while (pos < text.size()) {
+            usize eol = text.find('\n', pos);
+            if (eol == libcxx::string::npos) {
+                eol = text.size();
+            }
+
+            Region reg{};
+            if (parse_line(libcxx::string_view(text).substr(pos, eol - pos), reg)) {
+                snap->regions.push_back(reg);
+            }
+            pos = eol + 1;
+        }
+
+        // the kernel lists regions in address order already; make sure of it
+        if (!libcxx::is_sorted(snap->regions.begin(), snap->regions.end(),
+                               [](const Region &a, const Region &b) { return a.begin < b.begin; })) {
+            libcxx::sort(snap->regions.begin(), snap->regions.end(),
+                         [](const Region &a, const Region &b) { return a.begin < b.begin; });
+        }
+
+        // pthread stacks are one mapping with a PROT_NONE guard at the bottom, which the
+        // kernel lists as two adjacent regions; nothing else in the listing says "stack"
+        for (usize i = 1; i < snap->regions.size(); ++i) {
+            Region       &reg   = snap->regions[i];
+            const Region &below = snap->regions[i - 1];
+
+            if (reg.kind == Kind::Anonymous && below.kind == Kind::Anonymous &&
+                below.end == reg.begin && (below.access & (Read | Write | Exec)) == 0) {
+                reg.kind = Kind::Guarded;
+            }
+        }
+#endif
+
+        return snap;
+    }
+
+    /// "start-end perms offset dev inode [path]"
+    static bool parse_line(libcxx::string_view line, Region &reg) {
+        auto hex = [&](usize &i, uintptr_t &out) {
+            usize from = i;
+            out        = 0;
+            for (; i < line.size(); ++i) {
+                char     c = line[i];
+                unsigned d = 0;
+                if (c >= '0' && c <= '9') {
+                    d = unsigned(c - '0');
+                } else if (c >= 'a' && c <= 'f') {
+                    d = unsigned(c - 'a' + 10);
+                } else {
+                    break;
+                }
+                out = (out << 4) | d;
+            }
+            return i > from;
+        };
+
+        usize i = 0;
+        if (!hex(i, reg.begin) || i >= line.size() || line[i++] != '-' || !hex(i, reg.end) ||
+            i + 5 > line.size()) {
+            return false;
+        }
+
+        ++i;  // space
+        reg.access = 0;
+        reg.access |= (line[i] == 'r') ? Read : 0;
+        reg.access |= (line[i + 1] == 'w') ? Write : 0;
+        reg.access |= (line[i + 2] == 'x') ? Exec : 0;
+        reg.access |= (line[i + 3] == 's') ? Shared : 0;
+        i += 4;
+
+        // skip offset, dev and inode, then the padding before the path
+        for (int field = 0; field < 3; ++field) {
+            while (i < line.size() && line[i] == ' ') {
+                ++i;
+            }
+            while (i < line.size() && line[i] != ' ') {
+                ++i;
+            }
+        }
+        while (i < line.size() && line[i] == ' ') {
+            ++i;
+        }
+
+        libcxx::string_view path = line.substr(i);
+        if (path.empty()) {
+            reg.kind = Kind::Anonymous;
+        } else if (path == "[heap]") {
+            reg.kind = Kind::Heap;
+        } else if (path == "[stack]") {
+            reg.kind = Kind::Stack;
+        } else if (path.front() == '[') {
+            // [anon:name] is still anonymous memory; the rest are kernel mappings
+            reg.kind = path.starts_with("[anon") ? Kind::Anonymous : Kind::Special;
+        } else {
+            reg.kind = Kind::Image;
+        }
+
+        return reg.end > reg.begin;
+    }
+
+    // first step of the miss back-off, in nanoseconds
+    static constexpr i64 min_backoff = 20'000'000;
+
+    mutable libcxx::mutex            mutex_;
+    libcxx::atomic<const Snapshot *> current_{nullptr};
+    mutable libcxx::atomic<u32>      readers_{0};
+    libcxx::atomic<i64>              last_refresh_{0};
+    libcxx::atomic<i64>              backoff_{0};
+    libcxx::vector<const Snapshot *> retired_;
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M10MEMORY_MAP
@@ -0,0 +1,468 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M5PAGES
+#define _$_HX_CORE_M5PAGES
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "alloc_hooks.hh"
+
+#if defined(__linux__)
+#   include <sys/syscall.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief What alloc_pages() should try for. Every field is a preference: anything the
+///        system cannot provide falls back quietly, and the returned Pages says what happened.
+///
+struct PageHint {
+    bool huge      = false;  // explicit huge pages (MAP_HUGETLB), else transparent huge pages
+    i32  numa_node = -1;     // bind the memory to this node; -1 leaves placement to the kernel
+    bool populate  = false;  // fault every page in before returning
+};
+
+/// the kind of page backing a block from alloc_pages().
+enum class PageKind : u8 {
+    Normal,       // base pages
+    Transparent,  // base pages the kernel was asked to collapse into huge pages (THP)
+    Huge          // reserved huge pages (hugetlbfs / large pages); always huge
+};
+
+///
+/// \brief A block from alloc_pages(). `size` is the mapped length (the request rounded up to
+///        `page_size`) and must be kept for free_pages().
+///
+struct Pages {
+    void    *ptr{nullptr};
+    usize    size{0};
+    usize    page_size{0};  // for Transparent, the huge page size the kernel may use
+    PageKind kind{PageKind::Normal};
+    bool     numa_bound{false};  // the NUMA binding was applied
+
+    explicit operator bool() const noexcept { return ptr != nullptr; }
+};
+
+namespace __pages {
+inline usize round_up(usize n, usize to) { return (n + to - 1) & ~(to - 1); }
+
+#if defined(__linux__)
+/// read a small /proc or /sys file into `buf`; returns the length, 0 on failure.
+inline usize read_file(const char *path, char *buf, usize cap) {
+    int fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+
+    usize len = 0;
+    while (len + 1 < cap) {
+        ssize_t n = ::read(fd, buf + len, cap - 1 - len);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        len += static_cast<usize>(n);
+    }
+    ::close(fd);
+
+    buf[len] = '\0';
+    return len;
+}
+
+/// "Hugepagesize:    2048 kB" from /proc/meminfo.
+inline usize read_huge_page_size() {
+    char  buf[8192];  // NOLINT
+    usize len = read_file("/proc/meminfo", buf, sizeof(buf));
+
+    const char *at = len != 0 ? libcxx::strstr(buf, "Hugepagesize:") : nullptr;
+    if (at == nullptr) {
+        return usize(2) << 20;
+    }
+
+    usize kb = libcxx::strtoull(at + 13, nullptr, 10);
+    return kb != 0 ? kb * 1024 : usize(2) << 20;
+}
+
+/// highest node in /sys/devices/system/node/online ("0", "0-3", "0,2-3") plus one.
+inline usize read_numa_nodes() {
+    char  buf[256];  // NOLINT
+    usize len = read_file("/sys/devices/system/node/online", buf, sizeof(buf));
+
+    usize highest = 0;
+    usize value   = 0;
+    bool  digits  = false;
+    for (usize i = 0; i <= len; ++i) {
+        char c = buf[i];
+        if (c >= '0' && c <= '9') {
+            value  = value * 10 + usize(c - '0');
+            digits = true;
+            continue;
+        }
+        if (digits && value > highest) {
+            highest = value;
+        }
+        value  = 0;
+        digits = false;
+    }
+    return highest + 1;
+}
+
+/// MPOL_BIND through the raw syscall, so there is no libnuma dependency.
+inline bool bind(void *ptr, usize size, i32 node) {
+#   if defined(SYS_mbind)
+    constexpr int   mpol_bind = 2;
+    constexpr usize words     = 16;  // 1024 nodes
+    constexpr usize bits      = words * sizeof(unsigned long) * 8;
+
+    if (node < 0 || static_cast<usize>(node) >= bits) {
+        return false;
+    }
+
+    unsigned long mask[words] = {};
+    mask[usize(node) / (sizeof(unsigned long) * 8)] =
+        1UL << (usize(node) % (sizeof(unsigned long) * 8));
+
+    // the kernel drops the last bit of maxnode, hence the + 1
+    return ::syscall(SYS_mbind, ptr, size, mpol_bind, mask, bits + 1, 0) == 0;
+#   else
+    (void)ptr;
+    (void)size;
+    (void)node;
+    return false;
+#   endif
+}
+#endif
+
+/// fault the block in, one write per page.
+inline void touch(void *ptr, usize size, usize page) {
+#if defined(__linux__) && defined(MADV_POPULATE_WRITE)
+    if (::madvise(ptr, size, MADV_POPULATE_WRITE) == 0) {
+        return;
+    }
+#endif
+    auto *p = static_cast<volatile unsigned char *>(ptr);
+    for (usize off = 0; off < size; off += page) {
+        p[off] = 0;
+    }
+}
+}  // namespace __pages
+
+/// size of a base page.
+inline usize page_size() {
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    static const usize size = [] {
+        SYSTEM_INFO info;
+        ::GetSystemInfo(&info);
+        return static_cast<usize>(info.dwPageSize);
+    }();
+#else
+    static const usize size = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+#endif
+    return size;
+}
+
+/// default huge page size, or 0 where there are none.
+inline usize huge_page_size() {
+#if defined(__linux__)
+    static const usize size = __pages::read_huge_page_size();
+#elif defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    static const usize size = static_cast<usize>(::GetLargePageMinimum());
+#else
+    static const usize size = 0;
+#endif
+    return size;
+}
+
+/// number of NUMA nodes (1 on machines without NUMA).
+inline usize numa_node_count() {
+#if defined(__linux__)
+    static const usize count = __pages::read_numa_nodes();
+#elif defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    static const usize count = [] {
+        ULONG highest = 0;
+        return ::GetNumaHighestNodeNumber(&highest) ? usize(highest) + 1 : usize(1);
+    }();
+#else
+    static const usize count = 1;
+#endif
+    return count;
+}
+
+///
+/// \brief Page-granular memory straight from the OS, for large long-lived tables and arena
+///        chunks where TLB reach matters. The block is zeroed and aligned to its page size.
+///
+/// With `hint.huge`, Linux first tries reserved huge pages (MAP_HUGETLB; the size rounds up
+/// to a whole huge page) and otherwise, for blocks of at least one huge page, maps a
+/// huge-page-aligned range and marks it MADV_HUGEPAGE so the kernel backs it with transparent
+/// huge pages. `hint.numa_node` binds the block with mbind when the machine has more than one
+/// node, before any page is faulted in; on single-node machines it is ignored. Windows uses
+/// large pages (which need SeLockMemoryPrivilege) and VirtualAllocExNuma.
+/// \throws std::bad_alloc if not even base pages can be mapped.
+///
+inline Pages alloc_pages(usize bytes, const PageHint &hint) {
+    Pages out;
+    bytes = bytes != 0 ? bytes : 1;
+
+    const usize page = page_size();
+    const bool  numa = hint.numa_node >= 0 && numa_node_count() > 1;
+
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    auto map = [&](usize size, DWORD flags) -> void * {
+        flags |= MEM_RESERVE | MEM_COMMIT;
+        return numa ? ::VirtualAllocExNuma(::GetCurrentProcess(), nullptr, size, flags,
+                                           PAGE_READWRITE, DWORD(hint.numa_node))
+                    : ::VirtualAlloc(nullptr, size, flags, PAGE_READWRITE);
+    };
+
+    if (hint.huge && huge_page_size() != 0) {
+        usize size = __pages::round_up(bytes, huge_page_size());
+        if (void *p = map(size, MEM_LARGE_PAGES); p != nullptr) {
+            out = {p, size, huge_page_size(), PageKind::Huge, numa};
+        }
+    }
+
+    if (out.ptr == nullptr) {
+        usize size = __pages::round_up(bytes, page);
+        void *p    = map(size, 0);
+        if (p == nullptr) {
+            throw libcxx::bad_alloc();
+        }
+        out = {p, size, page, PageKind::Normal, numa};
+    }
+
+    if (hint.populate) {
+        __pages::touch(out.ptr, out.size, out.kind == PageKind::Huge ? out.page_size : page);
+    }
+#else
+    constexpr int prot  = PROT_READ | PROT_WRITE;
+    constexpr int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+
+    // populate at map time only when nothing has to happen between mapping and faulting
+    bool populated = false;
+
+#   if defined(__linux__)
+    if (hint.huge) {
+        const usize huge = huge_page_size();
+        const usize size = __pages::round_up(bytes, huge);
+
+        int extra = 0;
+#      if defined(MAP_POPULATE)
+        extra = (hint.populate && !numa) ? MAP_POPULATE : 0;
+#      endif
+
+        void *p = ::mmap(nullptr, size, prot, flags | MAP_HUGETLB | extra, -1, 0);
+        if (p != MAP_FAILED) {
+            out       = {p, size, huge, PageKind::Huge, false};
+            populated = extra != 0;
+        } else if (bytes >= huge) {
+            // over-map by one huge page and trim, so the block starts on a huge page boundary
+            void *raw = ::mmap(nullptr, size + huge, prot, flags, -1, 0);
+            if (raw != MAP_FAILED) {
+                auto begin = reinterpret_cast<uintptr_t>(raw);
+                auto at    = (begin + huge - 1) & ~static_cast<uintptr_t>(huge - 1);
+
+                if (at != begin) {
+                    ::munmap(raw, at - begin);
+                }
+                if (at + size != begin + size + huge) {
+                    ::munmap(reinterpret_cast<void *>(at + size), begin + huge - at);
+                }
+
+                p = reinterpret_cast<void *>(at);
+                if (::madvise(p, size, MADV_HUGEPAGE) == 0) {
+                    out = {p, size, huge, PageKind::Transparent, false};
+                } else {
+                    out = {p, size, page, PageKind::Normal, false};
+                }
+            }
+        }
+    }
+#   endif
+
+    if (out.ptr == nullptr) {
+        const usize size = __pages::round_up(bytes, page);
+
+        int extra = 0;
+#   if defined(MAP_POPULATE)
+        extra = (hint.populate && !numa) ? MAP_POPULATE : 0;
+#   endif
+
+        void *p = ::mmap(nullptr, size, prot, flags | extra, -1, 0);
+        if (p == MAP_FAILED) {
+            throw libcxx::bad_alloc();
+        }
+        out       = {p, size, page, PageKind::Normal, false};
+        populated = extra != 0;
+    }
+
+#   if defined(__linux__)
+    if (numa) {
+        out.numa_bound = __pages::bind(out.ptr, out.size, hint.numa_node);
+    }
+#   endif
+
+    if (hint.populate && !populated) {
+        __pages::touch(out.ptr, out.size, out.kind == PageKind::Huge ? out.page_size : page);
+    }
+#endif
+
+    profile_runtime_alloc(out.ptr, out.size);
+    return out;
+}
+
+inline Pages alloc_pages(usize bytes) { return alloc_pages(bytes, PageHint()); }
+
+/// give a block from alloc_pages() back to the OS.
+inline void free_pages(const Pages &pages) noexcept {
+    if (pages.ptr == nullptr) {
+        return;
+    }
+
+    profile_runtime_free(pages.ptr);
+#if defined(_WIN32) || defined(WIN32) || defined(_WIN64) || defined(WIN64)
+    ::VirtualFree(pages.ptr, 0, MEM_RELEASE);
+#else
+    ::munmap(pages.ptr, pages.size);
+#endif
+}
+
+///
+/// \brief Bytes of the block currently backed by huge pages. A Transparent block only gets
+///        them as the kernel finds free huge pages, so this is the way to check; it reads
+///        /proc/self/smaps and is meant for diagnostics, not hot paths. Linux only (0 elsewhere
+///        unless the block is Huge).
+///
+inline usize huge_backed_bytes(const Pages &pages) {
+    if (pages.kind == PageKind::Huge) {
+        return pages.size;
+    }
+
+#if defined(__linux__)
+    if (pages.kind != PageKind::Transparent) {
+        return 0;
+    }
+
+    FILE *f = libcxx::fopen("/proc/self/smaps", "r");
+    if (f == nullptr) {
+        return 0;
+    }
+
+    const auto begin = reinterpret_cast<uintptr_t>(pages.ptr);
+    const auto end   = begin + pages.size;
+
+    // sum AnonHugePages over the mappings inside the block (the kernel may have split it)
+    usize kb     = 0;
+    bool  inside = false;
+    char  line[512];  // NOLINT
+    while (libcxx::fgets(line, sizeof(line), f) != nullptr) {
+        unsigned long lo = 0, hi = 0;  // NOLINT
+        if (libcxx::sscanf(line, "%lx-%lx ", &lo, &hi) == 2) {  // a mapping's header line
+            inside = lo >= begin && hi <= end;
+            continue;
+        }
+
+        if (inside && libcxx::strncmp(line, "AnonHugePages:", 14) == 0) {
+            kb += libcxx::strtoull(line + 14, nullptr, 10);
+        }
+    }
+
+    libcxx::fclose(f);
+    return kb * 1024;
+#else
+    return 0;
+#endif
+}
+
+///
+/// \brief alloc_pages() as a memory_resource, for giving an Arena (or a pmr container) huge
+///        page or node-local chunks:
+/// \code
+///   Memory::PageResource pages({.huge = true});
+///   Memory::Arena arena(8 << 20, &pages);
+/// \endcode
+/// Meant for a few large blocks: every allocation is its own mapping. Thread-safe.
+///
+class PageResource : public libcxx::pmr::memory_resource {
+  public:
+    PageResource() = default;
+    explicit PageResource(const PageHint &hint)
+        : hint_(hint) {}
+
+    PageResource(const PageResource &)            = delete;
+    PageResource &operator=(const PageResource &) = delete;
+
+    ~PageResource() override {
+        for (const auto &[ptr, pages] : live_) {
+            free_pages(pages);
+        }
+    }
+
+    const PageHint &hint() const noexcept { return hint_; }
+
+    /// the mapping behind a pointer returned by allocate(), e.g. to see which pages it got.
+    Pages pages_of(void *ptr) const {
+        libcxx::lock_guard<libcxx::mutex> lock(mutex_);
+        auto it = live_.find(ptr);
+        return it != live_.end() ? it->second : Pages{};
+    }
+
+  protected:
+    void *do_allocate(usize bytes, usize alignment) override {
+        if (alignment > page_size()) {
+            throw libcxx::bad_alloc();
+        }
+
+        Pages pages = alloc_pages(bytes, hint_);
+
+        libcxx::lock_guard<libcxx::mutex> lock(mutex_);
+        live_.emplace(pages.ptr, pages);
+        return pages.ptr;
+    }
+
+    void do_deallocate(void *ptr, usize /*bytes*/, usize /*alignment*/) override {
+        Pages pages;
+        {
+            libcxx::lock_guard<libcxx::mutex> lock(mutex_);
+            auto it = live_.find(ptr);
+            if (it == live_.end()) {
+                return;
+            }
+            pages = it->second;
+            live_.erase(it);
+        }
+        free_pages(pages);
+    }
+
+    bool do_is_equal(const libcxx::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+  private:
+    PageHint                             hint_;
+    mutable libcxx::mutex                mutex_;
+    libcxx::unordered_map<void *, Pages> live_;
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M5PAGES
@@ -17,6 +17,8 @@
 #include <include/c++/libc++.hh>
 #include <include/types/builtins/builtins.hh>
 
+#include "bulk_memory.hh"
+
 H_NAMESPACE_BEGIN
 
 template <typename T>
@@ -46,6 +48,25 @@ inline std::Questionable<T *> find(const T *src, int value, size_t n) noexcept {
     return result ? static_cast<T *>(result) : null;
 }
 
+/// first element equal to either byte value (see memchr2).
+template <typename T>
+inline std::Questionable<T *> find_any(const T *src, int a, int b, size_t n) noexcept {
+    void *result = memchr2(src, a, b, n);
+    return result ? static_cast<T *>(result) : null;
+}
+
+template <typename T>
+inline std::Questionable<T *> find_any(const T *src, int a, int b, int c, size_t n) noexcept {
+    void *result = memchr3(src, a, b, c, n);
+    return result ? static_cast<T *>(result) : null;
+}
+
+template <typename T>
+inline std::Questionable<T *> find_last(const T *src, int value, size_t n) noexcept {
+    void *result = memrchr(src, value, n);
+    return result ? static_cast<T *>(result) : null;
+}
+
 inline int compare(const void *a, const void *b, size_t n) noexcept {
     return LIBCXX_NAMESPACE::memcmp(a, b, n);
 }
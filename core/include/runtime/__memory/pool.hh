@@ -0,0 +1,375 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M4POOL
+#define _$_HX_CORE_M4POOL
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "forwarding.hh"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+/// who may touch a Pool.
+enum class PoolMode : u8 {
+    ThreadLocal,  // one thread at a time: the free list is plain loads and stores
+    Shared        // any thread: the free list is a lock-free stack
+};
+
+///
+/// \brief Counters of a Pool. `capacity` is every slot carved so far, free or live.
+///
+struct PoolStats {
+    u64 acquired{0};
+    u64 released{0};
+    u64 live{0};
+    u64 peak_live{0};
+    u64 capacity{0};
+    u64 chunks{0};
+};
+
+template <typename T>
+class Pool;
+
+///
+/// \brief Owning handle to an object from a Pool; releases it back to the pool when destroyed.
+///
+template <typename T>
+class PoolPtr {
+  public:
+    PoolPtr() noexcept = default;
+    PoolPtr(T *ptr, Pool<T> *pool) noexcept
+        : ptr_(ptr)
+        , pool_(pool) {}
+
+    PoolPtr(const PoolPtr &)            = delete;
+    PoolPtr &operator=(const PoolPtr &) = delete;
+
+    PoolPtr(PoolPtr &&other) noexcept
+        : ptr_(libcxx::exchange(other.ptr_, nullptr))
+        , pool_(other.pool_) {}
+
+    PoolPtr &operator=(PoolPtr &&other) noexcept {
+        if (this != &other) {
+            reset();
+            ptr_  = libcxx::exchange(other.ptr_, nullptr);
+            pool_ = other.pool_;
+        }
+        return *this;
+    }
+
+    ~PoolPtr() { reset(); }
+
+    T *get() const noexcept { return ptr_; }
+    T &operator*() const noexcept { return *ptr_; }
+    T *operator->() const noexcept { return ptr_; }
+
+    explicit operator bool() const noexcept { return ptr_ != nullptr; }
+
+    Pool<T> *pool() const noexcept { return pool_; }
+
+    /// give up ownership; the caller must hand the object back with Pool::release.
+    T *release() noexcept { return libcxx::exchange(ptr_, nullptr); }
+
+    void reset() noexcept {
+        if (ptr_ != nullptr) {
+            pool_->release(libcxx::exchange(ptr_, nullptr));
+        }
+    }
+
+  private:
+    T       *ptr_{nullptr};
+    Pool<T> *pool_{nullptr};
+};
+
+///
+/// \brief Free-list pool of T for objects that are created and destroyed at high rates. Slots
+///        are carved from chunks that grow geometrically and are only returned to the system
+///        when the pool is destroyed, so once the pool has reached its working size acquire()
+///        and release() are a free-list pop and push with no call into the global allocator.
+/// \code
+///   Memory::Pool<Node> nodes;
+///   nodes.reserve(1024);                // optional bulk pre-reservation
+///   Node *n = nodes.acquire(key, value);
+///   nodes.release(n);
+///   auto owned = nodes.make(key, value);  // PoolPtr<Node>, released at scope exit
+/// \endcode
+///
+/// A Shared pool uses a tagged lock-free stack (see __small::Depot); a ThreadLocal pool must
+/// only be used by one thread at a time and skips every atomic read-modify-write. Slots of more
+/// than half a cache line are padded to whole lines so no object straddles two of them, and
+/// chunks start on a cache line.
+///
+/// Every object must be released before the pool is destroyed; the pool frees its chunks but
+/// does not run destructors of objects still out.
+///
+template <typename T>
+class Pool {
+    union Slot {
+        Slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];  // NOLINT
+    };
+
+    struct Chunk {
+        Chunk *next;
+        usize  slots;
+    };
+
+  public:
+    static constexpr usize cache_line = 64;
+
+    /// at least 16, since the lock-free stack packs slot addresses >> 4.
+    static constexpr usize slot_align = alignof(Slot) > 16 ? alignof(Slot) : 16;
+
+    /// distance between slots; whole cache lines for anything over half a line.
+    static constexpr usize slot_size = [] {
+        usize size = (sizeof(Slot) + slot_align - 1) & ~(slot_align - 1);
+        if (size > cache_line / 2) {
+            size = (size + cache_line - 1) & ~(cache_line - 1);
+        }
+        return size;
+    }();
+
+    static constexpr usize header      = (sizeof(Chunk) + slot_align - 1) & ~(slot_align - 1);
+    static constexpr usize chunk_align = slot_align > cache_line ? slot_align : cache_line;
+
+    explicit Pool(PoolMode mode = PoolMode::Shared)
+        : mode_(mode) {}
+
+    Pool(const Pool &)            = delete;
+    Pool &operator=(const Pool &) = delete;
+
+    ~Pool() {
+        Chunk *c = chunks_;
+        while (c != nullptr) {
+            Chunk *next = c->next;
+            ::operator delete(c, libcxx::align_val_t(chunk_align));
+            c = next;
+        }
+    }
+
+    PoolMode mode() const noexcept { return mode_; }
+
+    /// make sure at least `count` objects can be acquired without growing.
+    void reserve(usize count) {
+        auto lock = grow_lock();
+
+        usize cap = static_cast<usize>(capacity_.load(libcxx::memory_order_relaxed));
+        usize out = static_cast<usize>(stats().live);
+        if (cap - out < count) {
+            carve(count - (cap - out));
+        }
+    }
+
+    /// construct a T from `args` in a free slot.
+    template <typename... Args>
+    T *acquire(Args &&...args) {
+        Slot *slot = pop();
+        if (slot == nullptr) [[unlikely]] {
+            slot = grow();
+        }
+
+        T *obj = nullptr;
+        try {
+            obj = ::new (static_cast<void *>(slot->storage)) T(std::Memory::forward<Args>(args)...);
+        } catch (...) {
+            push(slot, slot);
+            throw;
+        }
+
+        // live is derived from the two counters, so each call pays for a single RMW
+        u64 taken = bump(acquired_, 1);
+        u64 given = released_.load(libcxx::memory_order_relaxed);
+        u64 live  = taken > given ? taken - given : 0;
+        if (live > peak_.load(libcxx::memory_order_relaxed)) [[unlikely]] {
+            raise_peak(live);
+        }
+        return obj;
+    }
+
+    /// destroy `obj` and recycle its slot. `obj` must come from this pool.
+    void release(T *obj) noexcept {
+        if (obj == nullptr) {
+            return;
+        }
+
+        obj->~T();
+        Slot *slot = ::new (static_cast<void *>(obj)) Slot;
+        push(slot, slot);
+
+        bump(released_, 1);
+    }
+
+    /// acquire() wrapped in a PoolPtr.
+    template <typename... Args>
+    PoolPtr<T> make(Args &&...args) {
+        return PoolPtr<T>(acquire(std::Memory::forward<Args>(args)...), this);
+    }
+
+    PoolStats stats() const noexcept {
+        PoolStats s;
+        s.acquired  = acquired_.load(libcxx::memory_order_relaxed);
+        s.released  = released_.load(libcxx::memory_order_relaxed);
+        s.live      = s.acquired > s.released ? s.acquired - s.released : 0;
+        s.peak_live = peak_.load(libcxx::memory_order_relaxed);
+        s.capacity  = capacity_.load(libcxx::memory_order_relaxed);
+        s.chunks    = chunk_count_.load(libcxx::memory_order_relaxed);
+        return s;
+    }
+
+  private:
+    static constexpr usize min_chunk_bytes = 16 * 1024;
+    static constexpr usize max_chunk_bytes = 1024 * 1024;
+    static constexpr u64   addr_mask       = (u64(1) << 44) - 1;
+
+    static u64 pack(Slot *s, u64 prev) noexcept {
+        u64 tag = (prev >> 44) + 1;
+        return (static_cast<u64>(reinterpret_cast<libcxx::uintptr_t>(s)) >> 4) | (tag << 44);
+    }
+
+    static Slot *unpack(u64 v) noexcept {
+        return reinterpret_cast<Slot *>(static_cast<libcxx::uintptr_t>((v & addr_mask) << 4));
+    }
+
+    // counters only change under a RMW when other threads can race on them
+    u64 bump(libcxx::atomic<u64> &counter, u64 delta) noexcept {
+        if (mode_ == PoolMode::Shared) {
+            return counter.fetch_add(delta, libcxx::memory_order_relaxed) + delta;
+        }
+        u64 now = counter.load(libcxx::memory_order_relaxed) + delta;
+        counter.store(now, libcxx::memory_order_relaxed);
+        return now;
+    }
+
+    void raise_peak(u64 live) noexcept {
+        if (mode_ == PoolMode::ThreadLocal) {
+            peak_.store(live, libcxx::memory_order_relaxed);  // the caller saw live > peak
+            return;
+        }
+
+        u64 peak = peak_.load(libcxx::memory_order_relaxed);
+        while (live > peak &&
+               !peak_.compare_exchange_weak(peak, live, libcxx::memory_order_relaxed)) {}
+    }
+
+    Slot *pop() noexcept {
+        if (mode_ == PoolMode::ThreadLocal) {
+            Slot *top = unpack(head_.load(libcxx::memory_order_relaxed));
+            if (top != nullptr) {
+                head_.store(pack(top->next, 0), libcxx::memory_order_relaxed);
+            }
+            return top;
+        }
+
+        // chunks outlive every pop, so reading next of a slot another thread just took is
+        // harmless: the CAS then fails on the tag
+        u64 old = head_.load(libcxx::memory_order_acquire);
+        for (;;) {
+            Slot *top = unpack(old);
+            if (top == nullptr) {
+                return nullptr;
+            }
+            Slot *next = libcxx::atomic_ref<Slot *>(top->next).load(libcxx::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old, pack(next, old), libcxx::memory_order_acquire,
+                                            libcxx::memory_order_acquire)) {
+                return top;
+            }
+        }
+    }
+
+    /// push the chain first..last (linked through next).
+    void push(Slot *first, Slot *last) noexcept {
+        if (mode_ == PoolMode::ThreadLocal) {
+            last->next = unpack(head_.load(libcxx::memory_order_relaxed));
+            head_.store(pack(first, 0), libcxx::memory_order_relaxed);
+            return;
+        }
+
+        u64 old = head_.load(libcxx::memory_order_relaxed);
+        for (;;) {
+            libcxx::atomic_ref<Slot *>(last->next).store(unpack(old), libcxx::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old, pack(first, old), libcxx::memory_order_release,
+                                            libcxx::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    Slot *grow() {
+        auto lock = grow_lock();
+
+        // another thread may have refilled the list while we waited
+        if (Slot *slot = pop(); slot != nullptr) {
+            return slot;
+        }
+
+        // double the pool, but keep single chunks under max_chunk_bytes
+        usize want = static_cast<usize>(capacity_.load(libcxx::memory_order_relaxed));
+        want       = want < max_chunk_bytes / slot_size ? want : max_chunk_bytes / slot_size;
+        carve(want > 0 ? want : 1);
+        return pop();
+    }
+
+    // a ThreadLocal pool has no other thread to exclude, so it skips the mutex too
+    libcxx::unique_lock<libcxx::mutex> grow_lock() {
+        if (mode_ == PoolMode::ThreadLocal) {
+            return libcxx::unique_lock<libcxx::mutex>(grow_, libcxx::defer_lock);
+        }
+        return libcxx::unique_lock<libcxx::mutex>(grow_);
+    }
+
+    /// add a chunk of at least `want` slots to the free list. caller holds grow_lock().
+    void carve(usize want) {
+        usize bytes = header + (want * slot_size);
+        bytes       = bytes < min_chunk_bytes ? min_chunk_bytes : bytes;
+
+        const usize slots = (bytes - header) / slot_size;
+        auto *mem = static_cast<unsigned char *>(
+            ::operator new(bytes, libcxx::align_val_t(chunk_align)));
+        chunks_ = ::new (mem) Chunk{chunks_, slots};
+
+        Slot *first = reinterpret_cast<Slot *>(mem + header);
+        for (usize i = 0; i + 1 < slots; ++i) {
+            auto *s = reinterpret_cast<Slot *>(mem + header + (i * slot_size));
+            s->next = reinterpret_cast<Slot *>(mem + header + ((i + 1) * slot_size));
+        }
+        Slot *last = reinterpret_cast<Slot *>(mem + header + ((slots - 1) * slot_size));
+
+        push(first, last);
+        bump(capacity_, slots);
+        bump(chunk_count_, 1);
+    }
+
+    PoolMode mode_;
+
+    alignas(64) libcxx::atomic<u64> head_{0};
+
+    // counters on their own line, away from the free-list head every thread CASes
+    alignas(64) libcxx::atomic<u64> acquired_{0};
+    libcxx::atomic<u64>             released_{0};
+    libcxx::atomic<u64>             peak_{0};
+    libcxx::atomic<u64>             capacity_{0};
+    libcxx::atomic<u64>             chunk_count_{0};
+
+    alignas(64) libcxx::mutex grow_;
+    Chunk *chunks_{nullptr};
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M4POOL
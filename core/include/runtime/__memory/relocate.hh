@@ -0,0 +1,83 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M8RELOCATE
+#define _$_HX_CORE_M8RELOCATE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief True when moving a T to a new address and ending the old one's lifetime is the same
+///        as copying its bytes: it holds no pointer into itself and no registration of its own
+///        address. Containers use it to grow with memcpy/realloc instead of running a move
+///        constructor and a destructor per element.
+///
+/// Trivially copyable types qualify automatically. Other types opt in by specializing:
+/// \code
+///   template <>
+///   struct Memory::is_trivially_relocatable<MyHandle> : libcxx::true_type {};
+/// \endcode
+/// Do not mark types that keep a pointer to their own storage, such as libstdc++'s
+/// std::string (its small-string buffer) or std::list (its sentinel node).
+///
+template <typename T>
+struct is_trivially_relocatable : libcxx::is_trivially_copyable<T> {};
+
+template <typename T>
+struct is_trivially_relocatable<libcxx::unique_ptr<T>> : libcxx::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<libcxx::shared_ptr<T>> : libcxx::true_type {};
+
+template <typename T>
+struct is_trivially_relocatable<libcxx::weak_ptr<T>> : libcxx::true_type {};
+
+template <typename A, typename B>
+struct is_trivially_relocatable<libcxx::pair<A, B>>
+    : libcxx::bool_constant<is_trivially_relocatable<A>::value &&
+                            is_trivially_relocatable<B>::value> {};
+
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+///
+/// \brief Move `count` objects from `src` to uninitialized `dst` and end the originals'
+///        lifetimes. The ranges must not overlap. A bytewise copy for trivially relocatable
+///        types; otherwise move-construct then destroy, one element at a time.
+///
+template <typename T>
+inline void relocate(T *dst, T *src, usize count) noexcept(
+    is_trivially_relocatable_v<T> || libcxx::is_nothrow_move_constructible_v<T>) {
+    if constexpr (is_trivially_relocatable_v<T>) {
+        if (count != 0) {
+            libcxx::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                           count * sizeof(T));
+        }
+    } else {
+        for (usize i = 0; i < count; ++i) {
+            ::new (static_cast<void *>(dst + i)) T(libcxx::move(src[i]));
+            src[i].~T();
+        }
+    }
+}
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M8RELOCATE
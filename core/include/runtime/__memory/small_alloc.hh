@@ -0,0 +1,367 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M11SMALL_ALLOC
+#define _$_HX_CORE_M11SMALL_ALLOC
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "forwarding.hh"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+namespace __small {
+/// size classes: 16..128 by 16, 160..256 by 32, 320..512 by 64. every block is 16-byte aligned.
+inline constexpr usize max_size    = 512;
+inline constexpr usize class_count = 16;
+inline constexpr usize slab_size   = 64 * 1024;
+
+constexpr usize class_of(usize size) noexcept {
+    if (size <= 128) {
+        return size == 0 ? 0 : (size - 1) / 16;
+    }
+    if (size <= 256) {
+        return 8 + (size - 129) / 32;
+    }
+    return 12 + (size - 257) / 64;
+}
+
+constexpr usize size_of(usize cls) noexcept {
+    if (cls < 8) {
+        return (cls + 1) * 16;
+    }
+    if (cls < 12) {
+        return 128 + (cls - 7) * 32;
+    }
+    return 256 + (cls - 11) * 64;
+}
+
+/// blocks moved between a thread and the depot at once.
+constexpr u32 batch_of(usize cls) noexcept {
+    usize n = 8192 / size_of(cls);
+    return static_cast<u32>(n < 8 ? 8 : (n > 64 ? 64 : n));
+}
+
+/// a free block. `next` links blocks of one batch, `next_batch` links batches in the depot.
+struct Block {
+    Block *next;
+    Block *next_batch;
+};
+
+/// lock-free stack of batches, one per size class, shared by all threads. the head carries a
+/// generation tag against ABA; blocks are 16-byte aligned and user-space addresses fit in 48
+/// bits, so (addr >> 4) takes 44 bits and the tag the other 20. slabs are never unmapped, so
+/// reading next_batch of a block another thread just popped is harmless: the CAS then fails.
+class Depot {
+  public:
+    void push(Block *batch) noexcept {
+        u64 old = head_.load(libcxx::memory_order_relaxed);
+        for (;;) {
+            libcxx::atomic_ref<Block *>(batch->next_batch)
+                .store(unpack(old), libcxx::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old, pack(batch, old), libcxx::memory_order_release,
+                                            libcxx::memory_order_relaxed)) {
+                return;
+            }
+        }
+    }
+
+    Block *pop() noexcept {
+        u64 old = head_.load(libcxx::memory_order_acquire);
+        for (;;) {
+            Block *top = unpack(old);
+            if (top == nullptr) {
+                return nullptr;
+            }
+            Block *next = libcxx::atomic_ref<Block *>(top->next_batch)
+                              .load(libcxx::memory_order_relaxed);
+            if (head_.compare_exchange_weak(old, pack(next, old), libcxx::memory_order_acquire,
+                                            libcxx::memory_order_acquire)) {
+                return top;
+            }
+        }
+    }
+
+  private:
+    static constexpr u64 addr_mask = (u64(1) << 44) - 1;
+
+    static u64 pack(Block *b, u64 prev) noexcept {
+        u64 tag = (prev >> 44) + 1;
+        return (static_cast<u64>(reinterpret_cast<libcxx::uintptr_t>(b)) >> 4) | (tag << 44);
+    }
+
+    static Block *unpack(u64 v) noexcept {
+        return reinterpret_cast<Block *>(static_cast<libcxx::uintptr_t>((v & addr_mask) << 4));
+    }
+
+    alignas(64) libcxx::atomic<u64> head_{0};
+};
+
+inline Depot depots[class_count];  // NOLINT
+
+/// carve a fresh slab into batches: the first is returned, the rest go to the depot.
+inline Block *carve(usize cls) {
+    const usize size  = size_of(cls);
+    const u32   batch = batch_of(cls);
+    const usize count = slab_size / size;
+
+    auto *slab = static_cast<unsigned char *>(::operator new(slab_size));
+
+    Block *first = nullptr;
+    for (usize start = 0; start < count; start += batch) {
+        usize end = start + batch < count ? start + batch : count;
+        for (usize i = start; i < end; ++i) {
+            auto *b = reinterpret_cast<Block *>(slab + (i * size));
+            b->next = (i + 1 < end) ? reinterpret_cast<Block *>(slab + ((i + 1) * size)) : nullptr;
+        }
+
+        auto *head = reinterpret_cast<Block *>(slab + (start * size));
+        if (first == nullptr) {
+            first = head;
+        } else {
+            depots[cls].push(head);
+        }
+    }
+
+    return first;
+}
+
+/// per-thread free lists. plain data so the thread_local needs no guard on the fast path; the
+/// Reaper below is only registered once a thread first goes to the depot.
+struct ThreadBins {
+    enum : u8 { Fresh, Live, Dead };
+
+    Block *head[class_count];   // NOLINT
+    u32    count[class_count];  // NOLINT
+    u8     state;
+};
+
+inline thread_local ThreadBins bins{};
+
+inline void flush(usize cls) noexcept {
+    if (bins.head[cls] != nullptr) {
+        depots[cls].push(bins.head[cls]);
+        bins.head[cls]  = nullptr;
+        bins.count[cls] = 0;
+    }
+}
+
+/// hands a dying thread's cached blocks back to the depot.
+struct Reaper {
+    Reaper()               = default;
+    Reaper(const Reaper &) = delete;
+    Reaper &operator=(const Reaper &) = delete;
+
+    ~Reaper() {
+        for (usize cls = 0; cls < class_count; ++cls) {
+            flush(cls);
+        }
+        bins.state = ThreadBins::Dead;
+    }
+};
+
+inline void register_thread() {
+    static thread_local Reaper reaper;
+    (void)reaper;
+    bins.state = ThreadBins::Live;
+}
+
+inline void *alloc_slow(usize cls) {
+    Block *batch = depots[cls].pop();
+    if (batch == nullptr) {
+        batch = carve(cls);
+    }
+
+    if (bins.state == ThreadBins::Dead) {
+        // thread teardown: serve one block and give the rest straight back
+        if (batch->next != nullptr) {
+            depots[cls].push(batch->next);
+        }
+        return batch;
+    }
+    if (bins.state == ThreadBins::Fresh) {
+        register_thread();
+    }
+
+    bins.head[cls]  = batch->next;
+    bins.count[cls] = batch_of(cls) - 1;  // approximate; only steers when to spill
+    return batch;
+}
+
+inline void free_slow(usize cls, Block *b) noexcept {
+    if (bins.state == ThreadBins::Dead) {
+        b->next = nullptr;
+        depots[cls].push(b);
+        return;
+    }
+    if (bins.state == ThreadBins::Fresh) {
+        register_thread();
+    }
+
+    // cache full: spill one batch worth to the depot for other threads, then keep b
+    const u32 batch = batch_of(cls);
+    if (bins.count[cls] >= 2 * batch && bins.head[cls] != nullptr) {
+        Block *spill = bins.head[cls];
+        Block *tail  = spill;
+        u32    n     = 1;
+        while (n < batch && tail->next != nullptr) {
+            tail = tail->next;
+            ++n;
+        }
+
+        bins.head[cls]  = tail->next;
+        tail->next      = nullptr;
+        bins.count[cls] = bins.count[cls] > n ? bins.count[cls] - n : 0;
+        depots[cls].push(spill);
+    }
+
+    b->next        = bins.head[cls];
+    bins.head[cls] = b;
+    ++bins.count[cls];
+}
+}  // namespace __small
+
+///
+/// \brief Allocate from the small-object pool: size-classed slabs with a per-thread cache, so a
+///        typical allocation is a thread-local free-list pop with no locks or atomics. Blocks
+///        freed on another thread are cached there and handed back through a lock-free depot
+///        in batches. Sizes above 512 bytes or alignments above 16 go to global new.
+///
+/// Memory must be released with small_free() and the same size (and alignment).
+///
+inline void *small_alloc(usize size, usize align = alignof(libcxx::max_align_t)) {
+    if (size > __small::max_size || align > alignof(libcxx::max_align_t)) {
+        return align > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+                   ? ::operator new(size, libcxx::align_val_t(align))
+                   : ::operator new(size);
+    }
+
+    const usize cls   = __small::class_of(size);
+    auto       &bins  = __small::bins;
+    __small::Block *b = bins.head[cls];
+    if (b != nullptr) [[likely]] {
+        bins.head[cls] = b->next;
+        bins.count[cls] -= (bins.count[cls] != 0) ? 1 : 0;
+        return b;
+    }
+
+    return __small::alloc_slow(cls);
+}
+
+inline void small_free(void *ptr, usize size, usize align = alignof(libcxx::max_align_t)) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+
+    if (size > __small::max_size || align > alignof(libcxx::max_align_t)) {
+        if (align > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(ptr, libcxx::align_val_t(align));
+        } else {
+            ::operator delete(ptr);
+        }
+        return;
+    }
+
+    const usize cls  = __small::class_of(size);
+    auto       &bins = __small::bins;
+    auto       *b    = static_cast<__small::Block *>(ptr);
+
+    if (bins.count[cls] < 2 * __small::batch_of(cls) && bins.state == __small::ThreadBins::Live)
+        [[likely]] {
+        b->next        = bins.head[cls];
+        bins.head[cls] = b;
+        ++bins.count[cls];
+        return;
+    }
+
+    __small::free_slow(cls, b);
+}
+
+/// small_alloc + placement new.
+template <typename T, typename... Args>
+inline T *small_new(Args &&...args) {
+    void *mem = small_alloc(sizeof(T), alignof(T));
+    try {
+        return ::new (mem) T(std::Memory::forward<Args>(args)...);
+    } catch (...) {
+        small_free(mem, sizeof(T), alignof(T));
+        throw;
+    }
+}
+
+/// destroy an object made by small_new<T>. T must be the exact type that was allocated.
+template <typename T>
+inline void small_delete(T *ptr) noexcept {
+    if (ptr != nullptr) {
+        ptr->~T();
+        small_free(const_cast<libcxx::remove_cv_t<T> *>(ptr), sizeof(T), alignof(T));
+    }
+}
+
+///
+/// \brief Standard allocator over the small-object pool, for node-based containers:
+/// \code
+///   list<Node, Memory::SmallObjectAllocator<Node>> nodes;
+/// \endcode
+///
+template <typename T>
+class SmallObjectAllocator {
+  public:
+    using value_type = T;
+
+    SmallObjectAllocator() noexcept = default;
+
+    template <typename U>
+    SmallObjectAllocator(const SmallObjectAllocator<U> &) noexcept {}  // NOLINT
+
+    T *allocate(usize n) { return static_cast<T *>(small_alloc(n * sizeof(T), alignof(T))); }
+    void deallocate(T *p, usize n) noexcept { small_free(p, n * sizeof(T), alignof(T)); }
+
+    template <typename U>
+    bool operator==(const SmallObjectAllocator<U> &) const noexcept {
+        return true;
+    }
+};
+
+/// tag for APIs that take ownership of an object made by small_new<T>: they release it with
+/// small_delete instead of delete. the untagged forms keep taking `new`-allocated objects.
+struct small_owned_t {
+    explicit small_owned_t() = default;
+};
+
+inline constexpr small_owned_t small_owned{};
+
+///
+/// \brief Base class that routes `new`/`delete` of the derived class through the pool. With a
+///        virtual destructor, deleting through a base pointer still frees the derived size.
+///
+struct SmallObject {
+    static void *operator new(usize size) { return small_alloc(size); }
+    static void *operator new(usize size, libcxx::align_val_t align) {
+        return small_alloc(size, static_cast<usize>(align));
+    }
+
+    static void operator delete(void *ptr, usize size) noexcept { small_free(ptr, size); }
+    static void operator delete(void *ptr, usize size, libcxx::align_val_t align) noexcept {
+        small_free(ptr, size, static_cast<usize>(align));
+    }
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M11SMALL_ALLOC
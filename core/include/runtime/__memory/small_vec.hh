@@ -0,0 +1,498 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M9SMALL_VEC
+#define _$_HX_CORE_M9SMALL_VEC
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#include "c-array.hh"
+#include "forwarding.hh"
+#include "relocate.hh"
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace Memory {
+///
+/// \brief Vector that keeps its first N elements in an inline buffer and only goes to the heap
+///        when it outgrows them, for lists that are usually short (argv/envp arrays, poll sets,
+///        delimiter lists):
+/// \code
+///   Memory::SmallVec<char *, 16> args;
+///   for (auto &a : storage) {
+///       args.push_back(a.data());
+///   }
+///   args.push_back(nullptr);
+///   ::execv(args[0], args.data());
+/// \endcode
+///
+/// The interface follows vec. Growth, insertion and erasure of trivially relocatable types
+/// (see relocate.hh) move bytes instead of running constructors. Unlike vec, moving a
+/// SmallVec that is still inline moves the elements one by one, and iterators are invalidated
+/// by the move.
+///
+template <typename T, usize N>
+class SmallVec {
+    static_assert(N > 0, "SmallVec needs room for at least one inline element");
+
+  public:
+    using value_type             = T;
+    using size_type              = usize;
+    using difference_type        = libcxx::ptrdiff_t;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using iterator               = T *;
+    using const_iterator         = const T *;
+    using reverse_iterator       = libcxx::reverse_iterator<iterator>;
+    using const_reverse_iterator = libcxx::reverse_iterator<const_iterator>;
+
+    static constexpr usize inline_capacity = N;
+
+    SmallVec() noexcept = default;
+
+    explicit SmallVec(usize count) { resize(count); }
+    SmallVec(usize count, const T &value) { assign(count, value); }
+    SmallVec(libcxx::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    SmallVec(It first, It last) {
+        assign(first, last);
+    }
+
+    explicit SmallVec(libcxx::span<const T> items) { assign(items.begin(), items.end()); }
+
+    SmallVec(const SmallVec &other) { assign(other.begin(), other.end()); }
+
+    SmallVec(SmallVec &&other) noexcept(is_trivially_relocatable_v<T> ||
+                                        libcxx::is_nothrow_move_constructible_v<T>) {
+        take(other);
+    }
+
+    SmallVec &operator=(const SmallVec &other) {
+        if (this != &other) {
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    SmallVec &operator=(SmallVec &&other) noexcept(is_trivially_relocatable_v<T> ||
+                                                   libcxx::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            release_heap();
+            take(other);
+        }
+        return *this;
+    }
+
+    SmallVec &operator=(libcxx::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~SmallVec() {
+        clear();
+        release_heap();
+    }
+
+    void assign(usize count, const T &value) {
+        if (&value >= begin() && &value < end()) {
+            T copy(value);  // clear() would destroy it
+            assign(count, copy);
+            return;
+        }
+
+        clear();
+        reserve(count);
+        for (usize i = 0; i < count; ++i) {
+            ::new (static_cast<void *>(data_ + i)) T(value);
+            ++size_;
+        }
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    void assign(It first, It last) {
+        clear();
+        if constexpr (libcxx::is_base_of_v<
+                          libcxx::forward_iterator_tag,
+                          typename libcxx::iterator_traits<It>::iterator_category>) {
+            reserve(static_cast<usize>(libcxx::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(libcxx::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    // element access
+
+    T &operator[](usize i) noexcept { return data_[i]; }
+    const T &operator[](usize i) const noexcept { return data_[i]; }
+
+    T &at(usize i) {
+        if (i >= size_) {
+            throw libcxx::out_of_range("SmallVec::at: index " + libcxx::to_string(i) +
+                                       " >= size " + libcxx::to_string(size_));
+        }
+        return data_[i];
+    }
+
+    const T &at(usize i) const { return const_cast<SmallVec *>(this)->at(i); }
+
+    T       &front() noexcept { return data_[0]; }
+    const T &front() const noexcept { return data_[0]; }
+    T       &back() noexcept { return data_[size_ - 1]; }
+    const T &back() const noexcept { return data_[size_ - 1]; }
+
+    T       *data() noexcept { return data_; }
+    const T *data() const noexcept { return data_; }
+
+    // iterators
+
+    iterator       begin() noexcept { return data_; }
+    const_iterator begin() const noexcept { return data_; }
+    const_iterator cbegin() const noexcept { return data_; }
+    iterator       end() noexcept { return data_ + size_; }
+    const_iterator end() const noexcept { return data_ + size_; }
+    const_iterator cend() const noexcept { return data_ + size_; }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    // capacity
+
+    bool  empty() const noexcept { return size_ == 0; }
+    bool  is_empty() const noexcept { return size_ == 0; }
+    usize size() const noexcept { return size_; }
+    usize capacity() const noexcept { return cap_; }
+    usize max_size() const noexcept { return usize(-1) / sizeof(T); }
+
+    /// true while the elements live in the inline buffer.
+    bool is_inline() const noexcept { return data_ == inline_data(); }
+
+    void reserve(usize count) {
+        if (count > cap_) {
+            reallocate(count);
+        }
+    }
+
+    /// move back into the inline buffer if the elements fit, else trim the heap block.
+    void shrink_to_fit() {
+        if (is_inline() || size_ == cap_) {
+            return;
+        }
+
+        if (size_ <= N) {
+            move_into(inline_data(), data_, size_);
+            release_heap();
+        } else {
+            reallocate(size_);
+        }
+    }
+
+    // modifiers
+
+    void clear() noexcept {
+        libcxx::destroy(data_, data_ + size_);
+        size_ = 0;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(libcxx::move(value)); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (size_ == cap_) [[unlikely]] {
+            return grow_emplace_back(std::Memory::forward<Args>(args)...);
+        }
+
+        T *slot = ::new (static_cast<void *>(data_ + size_)) T(std::Memory::forward<Args>(args)...);
+        ++size_;
+        return *slot;
+    }
+
+    void pop_back() noexcept {
+        --size_;
+        data_[size_].~T();
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        const usize at = static_cast<usize>(pos - begin());
+        if (at == size_) {
+            emplace_back(std::Memory::forward<Args>(args)...);
+            return begin() + at;
+        }
+
+        if constexpr (is_trivially_relocatable_v<T>) {
+            // build the value first (args may refer into the buffer), then open a gap with one
+            // memmove and relocate it in
+            alignas(T) unsigned char tmp[sizeof(T)];  // NOLINT
+            T *value = ::new (static_cast<void *>(tmp)) T(std::Memory::forward<Args>(args)...);
+
+            if (size_ == cap_) {
+                try {
+                    reallocate(next_capacity(size_ + 1));
+                } catch (...) {
+                    value->~T();
+                    throw;
+                }
+            }
+
+            libcxx::memmove(static_cast<void *>(data_ + at + 1), static_cast<void *>(data_ + at),
+                            (size_ - at) * sizeof(T));
+            libcxx::memcpy(static_cast<void *>(data_ + at), tmp, sizeof(T));
+            ++size_;
+        } else {
+            emplace_back(std::Memory::forward<Args>(args)...);
+            libcxx::rotate(begin() + at, end() - 1, end());
+        }
+        return begin() + at;
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, libcxx::move(value)); }
+
+    iterator insert(const_iterator pos, usize count, const T &value) {
+        const usize at = static_cast<usize>(pos - begin());
+        T           copy(value);
+        reserve(size_ + count);
+        for (usize i = 0; i < count; ++i) {
+            emplace_back(copy);
+        }
+        libcxx::rotate(begin() + at, end() - count, end());
+        return begin() + at;
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    iterator insert(const_iterator pos, It first, It last) {
+        const usize at  = static_cast<usize>(pos - begin());
+        const usize old = size_;
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        libcxx::rotate(begin() + at, begin() + old, end());
+        return begin() + at;
+    }
+
+    iterator insert(const_iterator pos, libcxx::initializer_list<T> init) {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T *from = begin() + (first - cbegin());
+        T *to   = begin() + (last - cbegin());
+        if (from == to) {
+            return from;
+        }
+
+        const usize gone = static_cast<usize>(to - from);
+        if constexpr (is_trivially_relocatable_v<T>) {
+            libcxx::destroy(from, to);
+            libcxx::memmove(static_cast<void *>(from), static_cast<void *>(to),
+                            static_cast<usize>(end() - to) * sizeof(T));
+        } else {
+            T *tail = libcxx::move(to, end(), from);
+            libcxx::destroy(tail, end());
+        }
+        size_ -= gone;
+        return from;
+    }
+
+    void resize(usize count) {
+        if (count < size_) {
+            libcxx::destroy(data_ + count, data_ + size_);
+            size_ = count;
+            return;
+        }
+
+        reserve(count);
+        for (; size_ < count; ++size_) {
+            ::new (static_cast<void *>(data_ + size_)) T();
+        }
+    }
+
+    void resize(usize count, const T &value) {
+        if (count <= size_) {
+            resize(count);
+            return;
+        }
+
+        T copy(value);
+        reserve(count);
+        for (; size_ < count; ++size_) {
+            ::new (static_cast<void *>(data_ + size_)) T(copy);
+        }
+    }
+
+    void swap(SmallVec &other) noexcept(is_trivially_relocatable_v<T> ||
+                                        libcxx::is_nothrow_move_constructible_v<T>) {
+        if (this == &other) {
+            return;
+        }
+        if (!is_inline() && !other.is_inline()) {
+            libcxx::swap(data_, other.data_);
+            libcxx::swap(size_, other.size_);
+            libcxx::swap(cap_, other.cap_);
+            return;
+        }
+
+        SmallVec tmp(libcxx::move(other));
+        other = libcxx::move(*this);
+        *this = libcxx::move(tmp);
+    }
+
+    friend void swap(SmallVec &a, SmallVec &b) noexcept(noexcept(a.swap(b))) { a.swap(b); }
+
+    // views
+
+    operator libcxx::span<T>() noexcept { return {data_, size_}; }              // NOLINT
+    operator libcxx::span<const T>() const noexcept { return {data_, size_}; }  // NOLINT
+
+    libcxx::span<T>       as_span() noexcept { return {data_, size_}; }
+    libcxx::span<const T> as_span() const noexcept { return {data_, size_}; }
+
+    friend bool operator==(const SmallVec &a, const SmallVec &b) {
+        return a.size_ == b.size_ && libcxx::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend auto operator<=>(const SmallVec &a, const SmallVec &b)
+        requires libcxx::three_way_comparable<T>
+    {
+        return libcxx::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+  private:
+    T *inline_data() noexcept { return reinterpret_cast<T *>(inline_); }
+    const T *inline_data() const noexcept { return reinterpret_cast<const T *>(inline_); }
+
+    usize next_capacity(usize need) const noexcept {
+        usize grown = cap_ * 2;
+        return grown > need ? grown : need;
+    }
+
+    /// move the elements into a heap block of `count` slots. count >= size_.
+    void reallocate(usize count) {
+        if (count > max_size()) {
+            throw libcxx::length_error("SmallVec: capacity overflow");
+        }
+
+        auto *fresh = static_cast<T *>(
+            ::operator new(count * sizeof(T), libcxx::align_val_t(alignof(T))));
+        try {
+            move_into(fresh, data_, size_);
+        } catch (...) {
+            ::operator delete(fresh, count * sizeof(T), libcxx::align_val_t(alignof(T)));
+            throw;
+        }
+        release_heap();
+
+        data_ = fresh;
+        cap_  = count;
+    }
+
+    template <typename... Args>
+    T &grow_emplace_back(Args &&...args) {
+        // construct into the new block before relocating, since args may refer to an element
+        const usize count = next_capacity(size_ + 1);
+        auto       *fresh = static_cast<T *>(
+            ::operator new(count * sizeof(T), libcxx::align_val_t(alignof(T))));
+
+        try {
+            ::new (static_cast<void *>(fresh + size_)) T(std::Memory::forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(fresh, count * sizeof(T), libcxx::align_val_t(alignof(T)));
+            throw;
+        }
+
+        try {
+            move_into(fresh, data_, size_);
+        } catch (...) {
+            fresh[size_].~T();
+            ::operator delete(fresh, count * sizeof(T), libcxx::align_val_t(alignof(T)));
+            throw;
+        }
+        release_heap();
+
+        data_ = fresh;
+        cap_  = count;
+        return data_[size_++];
+    }
+
+    /// relocate `count` elements from src to dst. types that are neither trivially relocatable
+    /// nor nothrow-movable are copied when they can be, for the strong guarantee: on a throw the
+    /// copies made so far are destroyed and src is left as it was.
+    static void move_into(T *dst, T *src, usize count) {
+        if constexpr (is_trivially_relocatable_v<T> || libcxx::is_nothrow_move_constructible_v<T> ||
+                      !libcxx::is_copy_constructible_v<T>) {
+            relocate(dst, src, count);
+        } else {
+            usize done = 0;
+            try {
+                for (; done < count; ++done) {
+                    ::new (static_cast<void *>(dst + done)) T(src[done]);
+                }
+            } catch (...) {
+                libcxx::destroy(dst, dst + done);
+                throw;
+            }
+            libcxx::destroy(src, src + count);
+        }
+    }
+
+    void release_heap() noexcept {
+        if (!is_inline()) {
+            ::operator delete(data_, cap_ * sizeof(T), libcxx::align_val_t(alignof(T)));
+            data_ = inline_data();
+            cap_  = N;
+        }
+    }
+
+    /// steal other's heap block, or relocate its inline elements. leaves other empty.
+    void take(SmallVec &other) {
+        if (!other.is_inline()) {
+            data_ = libcxx::exchange(other.data_, other.inline_data());
+            size_ = libcxx::exchange(other.size_, 0);
+            cap_  = libcxx::exchange(other.cap_, N);
+            return;
+        }
+
+        move_into(data_, other.data_, other.size_);
+        size_       = other.size_;
+        other.size_ = 0;
+    }
+
+    T    *data_{inline_data()};
+    usize size_{0};
+    usize cap_{N};
+
+    alignas(T) buffer<unsigned char, N * sizeof(T)> inline_;
+};
+}  // namespace Memory
+
+H_NAMESPACE_END
+H_STD_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M9SMALL_VEC
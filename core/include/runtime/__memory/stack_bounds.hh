@@ -20,93 +20,77 @@ H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
 
 namespace Memory {
-inline usize stack_size(usize *size = nullptr) {
-    static size_t stack_size = 0;
-    static bool  called     = false;
-
-    if (called) {
-        return (size != nullptr) ? (*size = usize(stack_size)) : usize(stack_size);
+namespace __stack {
+/// bounds of the calling thread's stack, looked up once per thread. every thread has its own
+/// stack, so these must not be cached in plain function-local statics.
+struct Bounds {
+    uintptr_t low{0};
+    uintptr_t high{0};
+    bool      ready{false};
+};
+
+inline thread_local Bounds current{};
+
+inline const Bounds &lookup() {
+    if (current.ready) [[likely]] {
+        return current;
     }
 
-#if defined(__linux__) || defined(__APPLE__)
 #if defined(__APPLE__)
-    stack_size = pthread_get_stacksize_np(pthread_self());
+    pthread_t self = pthread_self();
+    current.high   = reinterpret_cast<uintptr_t>(pthread_get_stackaddr_np(self));
+    current.low    = current.high - pthread_get_stacksize_np(self);
 #elif defined(__linux__)
     pthread_attr_t attr;
+    void          *addr = nullptr;
+    size_t         size = 0;
 
-    pthread_getattr_np(pthread_self(), &attr);
-    pthread_attr_getstacksize(&attr, &stack_size);
-    pthread_attr_destroy(&attr);
-#endif
-#elif defined(_WIN32)
-    NT_TIB *tib = reinterpret_cast<NT_TIB *>(NtCurrentTeb());
-    stack_size  = usize(reinterpret_cast<uintptr_t>(tib->StackBase) -
-                       reinterpret_cast<uintptr_t>(tib->StackLimit));
-#endif
-    called = true;
-    return (size != nullptr) ? (*size = usize(stack_size)) : usize(stack_size);
-}
-
-inline void *stack_start(void **start = nullptr) {
-    static void *st_addr = nullptr;
-    static bool  called  = false;
-
-    if (called) {
-        return (start != nullptr) ? (*start = st_addr) : (st_addr);
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+        pthread_attr_getstack(&attr, &addr, &size);
+        pthread_attr_destroy(&attr);
     }
 
-#if defined(__linux__) || defined(__APPLE__)
-    static libcxx::size_t st_size = 0;
-    pthread_attr_t        attr;
-
-#if defined(__linux__)
-    pthread_getattr_np(pthread_self(), &attr);
-#endif
-
-    pthread_attr_getstack(&attr, &st_addr, &st_size);
-    pthread_attr_destroy(&attr);
+    current.low  = reinterpret_cast<uintptr_t>(addr);
+    current.high = current.low + size;
 #elif defined(_WIN32)
-    NT_TIB *tib = reinterpret_cast<NT_TIB *>(NtCurrentTeb());
-    st_addr     = tib->StackLimit;
+    NT_TIB *tib  = reinterpret_cast<NT_TIB *>(NtCurrentTeb());
+    current.low  = reinterpret_cast<uintptr_t>(tib->StackLimit);
+    current.high = reinterpret_cast<uintptr_t>(tib->StackBase);
 #endif
-    called = true;
-    return (start != nullptr) ? (*start = st_addr) : (st_addr);
+
+    current.ready = true;
+    return current;
 }
+}  // namespace __stack
 
-inline void *stack_end(void **end = nullptr) {
-    static void *st_end = nullptr;
-    static bool  called = true;
+/// size of the calling thread's stack.
+inline usize stack_size(usize *size = nullptr) {
+    const auto &b = __stack::lookup();
+    usize       n = usize(b.high - b.low);
+    return (size != nullptr) ? (*size = n) : n;
+}
 
-    if (called) {
-        return (end != nullptr) ? (*end = st_end) : (st_end);
-    }
+/// lowest address of the calling thread's stack.
+inline void *stack_start(void **start = nullptr) {
+    void *p = reinterpret_cast<void *>(__stack::lookup().low);
+    return (start != nullptr) ? (*start = p) : p;
+}
 
-#if defined(_WIN32)
-    NT_TIB *tib = reinterpret_cast<NT_TIB *>(NtCurrentTeb());
-    st_end      = tib->StackBase;
-#elif defined(__linux__) || defined(__APPLE__)
-    st_end = static_cast<void *>(static_cast<char *>(stack_start()) +
-                                 static_cast<unsigned long long>(stack_size()));  // NOLINT
-#endif
-    called = true;
-    return (end != nullptr) ? (*end = st_end) : (st_end);
+/// one past the highest address of the calling thread's stack.
+inline void *stack_end(void **end = nullptr) {
+    void *p = reinterpret_cast<void *>(__stack::lookup().high);
+    return (end != nullptr) ? (*end = p) : p;
 }
 
 inline libcxx::pair<void *, void *> stack_bounds(void **start = nullptr, void **end = nullptr) {
-    libcxx::pair<void *, void *> pair;
-
-    static void *s_st = stack_start();
-    static void *s_ed = stack_end();
-
-    pair.first  = (start != nullptr) ? (*start = s_st) : (s_st);
-    pair.second = (end != nullptr) ? (*end = s_ed) : s_ed;
-
-    return pair;
+    return {stack_start(start), stack_end(end)};
 }
 
+/// true if ptr is on the calling thread's stack.
 inline bool in_stack(const void *ptr) {
-    static auto [stack_start, stack_end] = stack_bounds();
-    return (ptr >= stack_start && ptr < stack_end);
+    const auto &b    = __stack::lookup();
+    auto        addr = reinterpret_cast<uintptr_t>(ptr);
+    return (addr - b.low) < (b.high - b.low);
 }
 }  // namespace Memory
 
@@ -88,9 +88,14 @@ class FrameContext {
     inline FrameContext &operator=(FrameContext &&other) noexcept;
     inline ~FrameContext();
 
+    /// takes ownership of obj, which was made with `new`.
     template <typename T>
     inline explicit FrameContext(T *obj);
 
+    /// takes ownership of obj, which was made with `Memory::small_new<T>`.
+    template <typename T>
+    inline FrameContext(Memory::small_owned_t tag, T *obj);
+
     [[noreturn]]  inline void   crash();
     [[nodiscard]] inline void  *object() const;
     [[nodiscard]] inline string type_name() const;
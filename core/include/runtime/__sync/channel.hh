@@ -0,0 +1,796 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M7CHANNEL
+#define _$_HX_CORE_M7CHANNEL
+
+#include <include/config/config.hh>
+
+#include <bit>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/types/builtins/builtins.hh>
+
+#if defined(__linux__)
+#   include <linux/futex.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// in-process channels between threads: the runtime side of `sync::channel`.
+namespace Sync {
+/// outcome of a channel operation. Full and Empty only come from the try_ forms, Timeout only
+/// from a blocking call given a timeout.
+enum class Status : u8 {
+    Ok,
+    Full,
+    Empty,
+    Closed,
+    Timeout,
+};
+
+namespace __channel {
+inline void cpu_relax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+/// waiters re-check their condition this many times, with a pause in between, before they
+/// park: a value that is a few hundred nanoseconds away costs no system call on either side.
+/// on a single cpu the other side cannot make progress while we spin, so there it is zero.
+inline int spin_limit() noexcept {
+    static const int limit = libcxx::thread::hardware_concurrency() > 1 ? 64 : 0;
+    return limit;
+}
+
+/// for waits on a step another thread has already committed to, e.g. a producer that claimed a
+/// slot but has not written it yet: pause for spin_limit() rounds, then yield, since that
+/// thread may have been preempted half way and needs our cpu to finish.
+class Backoff {
+  public:
+    void pause() noexcept {
+        if (spins_ < spin_limit()) {
+            ++spins_;
+            cpu_relax();
+        } else {
+            libcxx::this_thread::yield();
+        }
+    }
+
+  private:
+    int spins_ = 0;
+};
+
+///
+/// \brief Event count: lets a thread sleep until "something changed" without a lock. A waiter
+///        sets the low bit of `seq` to say someone is parked, re-checks its condition and only
+///        then sleeps on `seq`. A notifier publishes first; it makes a system call only if the
+///        bit is set, and clears it while bumping `seq`, so a burst of notifications to a
+///        waiter that has not been scheduled yet costs one wake-up, not one per message.
+///
+/// notify(n) wakes at most n sleepers, for a consumer that freed n slots of a full queue: it
+/// bumps `seq` but leaves the bit set, since the waiters it did not wake are still asleep. The
+/// bit is cleared by the first notification that can wake everyone still parked, so an idle
+/// event stays a load and a branch. A waiter woken this way that gives up without taking
+/// its slot passes the wake on (see block_on).
+///
+class alignas(64) Event {
+  public:
+    static constexpr u32 all = ~u32{0};
+
+    /// announce a sleeper. the caller must re-check its condition afterwards, then either give
+    /// up or wait() with the returned value, and call leave() in both cases.
+    u32 prepare() noexcept {
+        parked_.fetch_add(1, libcxx::memory_order_seq_cst);
+        u32 seen = seq_.fetch_or(1, libcxx::memory_order_seq_cst) | 1;
+        libcxx::atomic_thread_fence(libcxx::memory_order_seq_cst);
+        return seen;
+    }
+
+    void leave() noexcept { parked_.fetch_sub(1, libcxx::memory_order_release); }
+
+    /// sleep until notified after prepare() returned `seen`, or timeout_ns (< 0: forever)
+    /// elapses. may return spuriously.
+    void wait(u32 seen, i64 timeout_ns) noexcept {
+#if defined(__linux__)
+        timespec ts{static_cast<time_t>(timeout_ns / 1000000000),
+                    static_cast<long>(timeout_ns % 1000000000)};
+        ::syscall(SYS_futex, reinterpret_cast<u32 *>(&seq_), FUTEX_WAIT_PRIVATE, seen,
+                  timeout_ns < 0 ? nullptr : &ts, nullptr, 0);
+#else
+        if (timeout_ns < 0) {
+            seq_.wait(seen, libcxx::memory_order_acquire);
+        } else if (seq_.load(libcxx::memory_order_acquire) == seen) {
+            // no timed atomic wait in the standard; nap in short slices instead
+            libcxx::this_thread::sleep_for(
+                libcxx::chrono::nanoseconds(timeout_ns < 100000 ? timeout_ns : 100000));
+        }
+#endif
+    }
+
+    /// wake up to `n` parked threads (all of them by default).
+    void notify(u32 n = all) noexcept {
+        if (n == 0) {
+            return;
+        }
+
+        libcxx::atomic_thread_fence(libcxx::memory_order_seq_cst);
+        u32 s = seq_.load(libcxx::memory_order_relaxed);
+
+        while ((s & 1) != 0) {
+            u32  parked  = parked_.load(libcxx::memory_order_seq_cst);
+            bool partial = n != all && parked > n;
+
+            // odd -> even clears the bit; odd -> odd keeps it for the sleepers left behind.
+            // either way the value differs from every `seen`, so a thread that has parked but
+            // not yet slept returns at once
+            if (seq_.compare_exchange_weak(s, s + (partial ? 2 : 1),
+                                           libcxx::memory_order_release,
+                                           libcxx::memory_order_relaxed)) {
+                if (parked != 0) {
+                    wake(partial ? n : all);
+                }
+                return;
+            }
+        }
+    }
+
+  private:
+    void wake(u32 n) noexcept {
+#if defined(__linux__)
+        int count = n > static_cast<u32>(libcxx::numeric_limits<int>::max())
+                        ? libcxx::numeric_limits<int>::max()
+                        : static_cast<int>(n);
+        ::syscall(SYS_futex, reinterpret_cast<u32 *>(&seq_), FUTEX_WAKE_PRIVATE, count, nullptr,
+                  nullptr, 0);
+#else
+        if (n == all) {
+            seq_.notify_all();
+        } else {
+            for (u32 i = 0; i < n; ++i) {
+                seq_.notify_one();
+            }
+        }
+#endif
+    }
+
+    libcxx::atomic<u32> seq_{0};
+    libcxx::atomic<u32> parked_{0};  // threads between prepare() and leave()
+};
+
+/// run `attempt` until it returns something other than Full / Empty: first a short spin, then
+/// parked on `event` between attempts. timeout_ms < 0 waits forever.
+template <typename Attempt>
+Status block_on(Event &event, int timeout_ms, Attempt &&attempt) {
+    auto retry = [](Status s) { return s == Status::Full || s == Status::Empty; };
+
+    Status st = attempt();
+    for (int spin = 0; retry(st) && spin < spin_limit(); ++spin) {
+        cpu_relax();
+        st = attempt();
+    }
+    if (!retry(st)) {
+        return st;
+    }
+
+    using clock   = libcxx::chrono::steady_clock;
+    auto deadline = clock::now() + libcxx::chrono::milliseconds(timeout_ms);
+
+    struct Parked {
+        Event &event;
+        ~Parked() { event.leave(); }
+    };
+
+    for (;;) {
+        i64 wait_ns = -1;
+        {
+            u32    seen = event.prepare();
+            Parked parked{event};
+
+            st = attempt();
+            if (!retry(st)) {
+                return st;
+            }
+
+            if (timeout_ms >= 0) {
+                wait_ns = libcxx::chrono::duration_cast<libcxx::chrono::nanoseconds>(
+                              deadline - clock::now())
+                              .count();
+                if (wait_ns <= 0) {
+                    break;
+                }
+            }
+
+            event.wait(seen, wait_ns);
+        }
+
+        st = attempt();
+        if (!retry(st)) {
+            return st;
+        }
+    }
+
+    // a partial wake meant for a freed slot may have landed on us; hand it to the next sleeper
+    event.notify(1);
+    return Status::Timeout;
+}
+
+///
+/// \brief Bounded lock-free queue after Dmitry Vyukov's MPMC ring: each cell carries a sequence
+///        number that tells a producer the cell is free for lap `pos` and a consumer that it
+///        holds the value for `pos`, so the two sides share no counter. A single consumer
+///        claims its position with a plain store instead of a CAS.
+///
+/// Positions are stored shifted left by one; the low bit of `tail_` is the closed mark.
+/// Producers always claim with a CAS, even a single one, so a claim and close() are ordered on
+/// the same word and nothing is accepted after the channel closes.
+///
+template <typename T, bool MultiProducer, bool MultiConsumer>
+class Bounded {
+    static_assert(libcxx::is_nothrow_move_constructible_v<T>,
+                  "channel values must be nothrow move constructible");
+
+    struct Cell {
+        libcxx::atomic<usize> seq;
+        alignas(T) unsigned char storage[sizeof(T)];  // NOLINT
+
+        T *value() noexcept { return reinterpret_cast<T *>(storage); }
+    };
+
+  public:
+    using value_type = T;
+
+    static constexpr bool multi_producer = MultiProducer;
+    static constexpr bool multi_consumer = MultiConsumer;
+
+    explicit Bounded(usize capacity)
+        : mask_(libcxx::bit_ceil(capacity < 2 ? usize(2) : capacity) - 1)
+        , cells_(new Cell[mask_ + 1]) {
+        for (usize i = 0; i <= mask_; ++i) {
+            cells_[i].seq.store(i, libcxx::memory_order_relaxed);
+        }
+    }
+
+    Bounded(const Bounded &)            = delete;
+    Bounded &operator=(const Bounded &) = delete;
+
+    ~Bounded() {
+        while (try_pop([](T &&) {}) == Status::Ok) {}
+    }
+
+    usize capacity() const noexcept { return mask_ + 1; }
+
+    /// moves from `value` only when it returns Ok.
+    Status try_push(T &value) noexcept {
+        usize tail = tail_.load(libcxx::memory_order_relaxed);
+
+        for (;;) {
+            if ((tail & 1) != 0) {
+                return Status::Closed;
+            }
+
+            const usize pos  = tail >> 1;
+            Cell       &cell = cells_[pos & mask_];
+            const auto  dif  = static_cast<isize>(cell.seq.load(libcxx::memory_order_acquire) -
+                                                 pos);
+
+            if (dif == 0) {
+                if (tail_.compare_exchange_weak(tail, tail + 2, libcxx::memory_order_relaxed)) {
+                    ::new (static_cast<void *>(cell.value())) T(libcxx::move(value));
+                    cell.seq.store(pos + 1, libcxx::memory_order_release);
+                    return Status::Ok;
+                }
+            } else if (dif < 0) {
+                return Status::Full;  // the cell still holds the value from one lap ago
+            } else {
+                tail = tail_.load(libcxx::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// hands the value to sink(T&&) once the cell has been given back, so a throwing sink
+    /// loses that value but leaves the queue intact.
+    template <typename Sink>
+    Status try_pop(Sink &&sink) {
+        usize pos = head_.load(libcxx::memory_order_relaxed);
+
+        for (;;) {
+            Cell      &cell = cells_[pos & mask_];
+            const auto dif  = static_cast<isize>(cell.seq.load(libcxx::memory_order_acquire) -
+                                                (pos + 1));
+
+            if (dif == 0) {
+                if constexpr (MultiConsumer) {
+                    if (!head_.compare_exchange_weak(pos, pos + 1,
+                                                     libcxx::memory_order_relaxed)) {
+                        continue;
+                    }
+                } else {
+                    head_.store(pos + 1, libcxx::memory_order_relaxed);
+                }
+
+                T value(libcxx::move(*cell.value()));
+                cell.value()->~T();
+                cell.seq.store(pos + mask_ + 1, libcxx::memory_order_release);
+                sink(libcxx::move(value));
+                return Status::Ok;
+            }
+
+            if (dif < 0) {
+                // nothing published at pos. closed-and-drained only if no producer holds a
+                // claim past it; otherwise that value is on its way.
+                const usize tail = tail_.load(libcxx::memory_order_acquire);
+                return (tail & 1) != 0 && (tail >> 1) == pos ? Status::Closed : Status::Empty;
+            }
+
+            pos = head_.load(libcxx::memory_order_relaxed);
+        }
+    }
+
+    void close() noexcept { tail_.fetch_or(1, libcxx::memory_order_acq_rel); }
+    bool closed() const noexcept { return (tail_.load(libcxx::memory_order_acquire) & 1) != 0; }
+
+  private:
+    const usize                  mask_;
+    libcxx::unique_ptr<Cell[]>   cells_;  // NOLINT
+    alignas(64) libcxx::atomic<usize> tail_{0};
+    alignas(64) libcxx::atomic<usize> head_{0};
+};
+
+///
+/// \brief Unbounded lock-free MPSC queue over a linked list of fixed blocks. Producers claim a
+///        position with one CAS on `tail_`; the producer that takes a block's last slot links
+///        the next block. The consumer walks positions without atomics of its own and frees a
+///        block once it has moved past it, so steady-state traffic allocates once per block.
+///
+/// As in Bounded, positions are shifted left by one and the low bit of `tail_` is the closed
+/// mark. Each block also spends one position (offset block_cap) as a marker: a tail sitting on
+/// it means the next block is being linked, and producers wait for that instead of racing.
+///
+template <typename T>
+class Unbounded {
+    static_assert(libcxx::is_nothrow_move_constructible_v<T>,
+                  "channel values must be nothrow move constructible");
+
+    static constexpr usize block_cap = 31;
+    static constexpr usize lap       = block_cap + 1;
+
+    struct Slot {
+        libcxx::atomic<u32> ready{0};
+        alignas(T) unsigned char storage[sizeof(T)];  // NOLINT
+
+        T *value() noexcept { return reinterpret_cast<T *>(storage); }
+    };
+
+    struct Block {
+        libcxx::atomic<Block *> next{nullptr};
+        Slot                    slots[block_cap];  // NOLINT
+    };
+
+  public:
+    using value_type = T;
+
+    static constexpr bool multi_producer = true;
+    static constexpr bool multi_consumer = false;
+
+    Unbounded()
+        : tail_block_(new Block)
+        , head_block_(tail_block_.load(libcxx::memory_order_relaxed)) {}
+
+    Unbounded(const Unbounded &)            = delete;
+    Unbounded &operator=(const Unbounded &) = delete;
+
+    ~Unbounded() {
+        while (try_pop([](T &&) {}) == Status::Ok) {}
+        delete head_block_;
+    }
+
+    /// moves from `value` only when it returns Ok; never Full.
+    Status try_push(T &value) {
+        usize  tail  = tail_.load(libcxx::memory_order_acquire);
+        Block  *block = tail_block_.load(libcxx::memory_order_acquire);
+        Block  *next  = nullptr;
+        Backoff backoff;
+
+        for (;;) {
+            if ((tail & 1) != 0) {
+                delete next;
+                return Status::Closed;
+            }
+
+            const usize offset = (tail >> 1) % lap;
+
+            if (offset == block_cap) {
+                // another producer is linking the next block
+                backoff.pause();
+                tail  = tail_.load(libcxx::memory_order_acquire);
+                block = tail_block_.load(libcxx::memory_order_acquire);
+                continue;
+            }
+
+            // allocate before claiming the last slot, so the claim never fails half way
+            if (offset + 1 == block_cap && next == nullptr) {
+                next = new Block;
+            }
+
+            if (tail_.compare_exchange_weak(tail, tail + 2, libcxx::memory_order_seq_cst,
+                                            libcxx::memory_order_acquire)) {
+                if (offset + 1 == block_cap) {
+                    tail_block_.store(next, libcxx::memory_order_release);
+                    tail_.fetch_add(2, libcxx::memory_order_release);  // step over the marker
+                    block->next.store(next, libcxx::memory_order_release);
+                    next = nullptr;
+                }
+
+                Slot &slot = block->slots[offset];
+                ::new (static_cast<void *>(slot.value())) T(libcxx::move(value));
+                slot.ready.store(1, libcxx::memory_order_release);
+                delete next;
+                return Status::Ok;
+            }
+
+            block = tail_block_.load(libcxx::memory_order_acquire);
+        }
+    }
+
+    template <typename Sink>
+    Status try_pop(Sink &&sink) {
+        const usize pos = head_;
+
+        // positions below the last tail we read are known to be claimed; only look at the
+        // producers' cache line again once we have caught up with it. `<=`: a tail read while
+        // a block was being linked sits on its marker, one short of where we continue.
+        if ((tail_seen_ >> 1) <= pos) {
+            tail_seen_ = tail_.load(libcxx::memory_order_acquire);
+            if ((tail_seen_ >> 1) <= pos) {
+                return (tail_seen_ & 1) != 0 ? Status::Closed : Status::Empty;
+            }
+        }
+
+        // the position is claimed; its producer may still be writing the value
+        const usize offset = pos % lap;
+        Slot       &slot   = head_block_->slots[offset];
+        Backoff     backoff;
+        while (slot.ready.load(libcxx::memory_order_acquire) == 0) {
+            backoff.pause();
+        }
+
+        T value(libcxx::move(*slot.value()));
+        slot.value()->~T();
+
+        if (offset + 1 == block_cap) {
+            Block *next = head_block_->next.load(libcxx::memory_order_acquire);
+            while (next == nullptr) {
+                backoff.pause();
+                next = head_block_->next.load(libcxx::memory_order_acquire);
+            }
+            delete head_block_;
+            head_block_ = next;
+            head_       = pos + 2;
+        } else {
+            head_ = pos + 1;
+        }
+
+        sink(libcxx::move(value));
+        return Status::Ok;
+    }
+
+    void close() noexcept { tail_.fetch_or(1, libcxx::memory_order_acq_rel); }
+    bool closed() const noexcept { return (tail_.load(libcxx::memory_order_acquire) & 1) != 0; }
+
+  private:
+    alignas(64) libcxx::atomic<usize> tail_{0};
+    libcxx::atomic<Block *>           tail_block_;
+
+    // consumer only
+    alignas(64) usize head_{0};
+    usize             tail_seen_{0};
+    Block            *head_block_;
+};
+
+/// the queue plus what the handles need around it: one event per direction and the handle
+/// counts that close the channel when either side is gone.
+template <typename Q>
+struct Shared {
+    template <typename... Args>
+    explicit Shared(Args &&...args)
+        : queue(std::Memory::forward<Args>(args)...) {}
+
+    void close() noexcept {
+        queue.close();
+        readable.notify();
+        writable.notify();
+    }
+
+    Q                     queue;
+    Event                 readable;  // consumers park here
+    Event                 writable;  // producers park here while a bounded queue is full
+    libcxx::atomic<usize> senders{1};
+    libcxx::atomic<usize> receivers{1};
+};
+}  // namespace __channel
+
+/// unbounded multi-producer / single-consumer channel. sends never block.
+template <typename T>
+using MpSc = __channel::Unbounded<T>;
+
+/// bounded multi-producer / single-consumer channel. sends block (or fail, for try_send) while
+/// it holds `capacity` values.
+template <typename T>
+using BoundedMpSc = __channel::Bounded<T, true, false>;
+
+/// bounded single-producer / multi-consumer channel: one thread hands out work, any number of
+/// receivers take it, each value going to exactly one of them.
+template <typename T>
+using SpMc = __channel::Bounded<T, false, true>;
+
+///
+/// \brief Sending half of a channel of kind Q (MpSc, BoundedMpSc or SpMc). Copyable when the
+///        channel has several producers; the channel closes when the last Sender or the last
+///        Receiver is destroyed, or when either side calls close().
+///
+template <typename Q>
+class Sender {
+    using T = typename Q::value_type;
+
+  public:
+    Sender() = default;
+    explicit Sender(libcxx::shared_ptr<__channel::Shared<Q>> shared) noexcept
+        : shared_(std::Memory::move(shared)) {}
+
+    Sender(const Sender &other) noexcept
+        requires(Q::multi_producer)
+        : shared_(other.shared_) {
+        if (shared_) {
+            shared_->senders.fetch_add(1, libcxx::memory_order_relaxed);
+        }
+    }
+
+    Sender &operator=(const Sender &other) noexcept
+        requires(Q::multi_producer)
+    {
+        if (this != &other) {
+            Sender(other).swap(*this);
+        }
+        return *this;
+    }
+
+    Sender(Sender &&other) noexcept = default;
+    Sender &operator=(Sender &&other) noexcept {
+        Sender(std::Memory::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~Sender() { release(); }
+
+    /// queue `value`, waiting while a bounded channel is full. Ok, Closed, or Timeout after
+    /// timeout_ms (< 0: no limit); `value` is moved from only on Ok.
+    Status send(T &&value, int timeout_ms = -1) {
+        Status st = __channel::block_on(shared_->writable, timeout_ms,
+                                        [&] { return shared_->queue.try_push(value); });
+        if (st == Status::Ok) {
+            shared_->readable.notify();
+        }
+        return st;
+    }
+
+    Status send(const T &value, int timeout_ms = -1) {
+        T copy(value);
+        return send(std::Memory::move(copy), timeout_ms);
+    }
+
+    /// Ok, Full or Closed, without waiting.
+    Status try_send(T &&value) {
+        Status st = shared_->queue.try_push(value);
+        if (st == Status::Ok) {
+            shared_->readable.notify();
+        }
+        return st;
+    }
+
+    Status try_send(const T &value) {
+        T copy(value);
+        return try_send(std::Memory::move(copy));
+    }
+
+    /// close the channel for both sides: later sends fail, receivers drain what is queued.
+    void close() noexcept { shared_->close(); }
+    bool is_closed() const noexcept { return shared_->queue.closed(); }
+
+    void swap(Sender &other) noexcept { shared_.swap(other.shared_); }
+
+  private:
+    void release() noexcept {
+        if (shared_ && shared_->senders.fetch_sub(1, libcxx::memory_order_acq_rel) == 1) {
+            shared_->close();
+        }
+        shared_.reset();
+    }
+
+    libcxx::shared_ptr<__channel::Shared<Q>> shared_;
+};
+
+///
+/// \brief Receiving half of a channel of kind Q. Copyable when the channel has several
+///        consumers (SpMc); each value is received exactly once.
+///
+/// \code
+///   auto [tx, rx] = Sync::mpsc<Job>();
+///   for (int i = 0; i < 8; ++i) {
+///       pool.emplace_back([tx] () mutable { tx.send(make_job()); });
+///   }
+///   tx = {};  // only the workers' copies keep it open
+///   vec<Job> batch;
+///   while (rx.recv_many(libcxx::back_inserter(batch), 64) != 0) {
+///       run(batch);
+///       batch.clear();
+///   }
+/// \endcode
+///
+template <typename Q>
+class Receiver {
+    using T = typename Q::value_type;
+
+  public:
+    Receiver() = default;
+    explicit Receiver(libcxx::shared_ptr<__channel::Shared<Q>> shared) noexcept
+        : shared_(std::Memory::move(shared)) {}
+
+    Receiver(const Receiver &other) noexcept
+        requires(Q::multi_consumer)
+        : shared_(other.shared_) {
+        if (shared_) {
+            shared_->receivers.fetch_add(1, libcxx::memory_order_relaxed);
+        }
+    }
+
+    Receiver &operator=(const Receiver &other) noexcept
+        requires(Q::multi_consumer)
+    {
+        if (this != &other) {
+            Receiver(other).swap(*this);
+        }
+        return *this;
+    }
+
+    Receiver(Receiver &&other) noexcept = default;
+    Receiver &operator=(Receiver &&other) noexcept {
+        Receiver(std::Memory::move(other)).swap(*this);
+        return *this;
+    }
+
+    ~Receiver() { release(); }
+
+    /// the next value, waiting for one; empty once the channel is closed and drained.
+    libcxx::optional<T> recv() {
+        libcxx::optional<T> out;
+        wait_pop(-1, [&](T &&v) { out.emplace(std::Memory::move(v)); });
+        return out;
+    }
+
+    /// Ok with the value in `out`, Closed once closed and drained, or Timeout.
+    Status recv(T &out, int timeout_ms = -1) {
+        return wait_pop(timeout_ms, [&](T &&v) { out = std::Memory::move(v); });
+    }
+
+    /// Ok, Empty or Closed, without waiting.
+    Status try_recv(T &out) {
+        Status st = shared_->queue.try_pop([&](T &&v) { out = std::Memory::move(v); });
+        if (st == Status::Ok) {
+            shared_->writable.notify(1);
+        }
+        return st;
+    }
+
+    /// wait for at least one value, then take whatever else is already queued, up to `max`,
+    /// writing each through `out`. returns the count: 0 means closed and drained, or timed out.
+    template <typename Out>
+    usize recv_many(Out out, usize max, int timeout_ms = -1) {
+        if (max == 0) {
+            return 0;
+        }
+
+        auto sink = [&](T &&v) {
+            *out = std::Memory::move(v);
+            ++out;
+        };
+
+        Status st = __channel::block_on(shared_->readable, timeout_ms,
+                                        [&] { return shared_->queue.try_pop(sink); });
+        if (st != Status::Ok) {
+            return 0;
+        }
+        return 1 + drain(sink, max - 1, 1);
+    }
+
+    /// take up to `max` values that are already queued, without waiting.
+    template <typename Out>
+    usize try_recv_many(Out out, usize max) {
+        auto sink = [&](T &&v) {
+            *out = std::Memory::move(v);
+            ++out;
+        };
+        return drain(sink, max, 0);
+    }
+
+    void close() noexcept { shared_->close(); }
+    bool is_closed() const noexcept { return shared_->queue.closed(); }
+
+    void swap(Receiver &other) noexcept { shared_.swap(other.shared_); }
+
+  private:
+    template <typename Sink>
+    Status wait_pop(int timeout_ms, Sink &&sink) {
+        Status st = __channel::block_on(shared_->readable, timeout_ms,
+                                        [&] { return shared_->queue.try_pop(sink); });
+        if (st == Status::Ok) {
+            shared_->writable.notify(1);
+        }
+        return st;
+    }
+
+    /// pop up to n more values; wakes as many blocked producers as slots were freed, counting
+    /// the `popped` the caller already took, once for the whole batch.
+    template <typename Sink>
+    usize drain(Sink &sink, usize n, usize popped) {
+        usize got = 0;
+        while (got < n && shared_->queue.try_pop(sink) == Status::Ok) {
+            ++got;
+        }
+        usize freed = got + popped;
+        shared_->writable.notify(freed < __channel::Event::all ? static_cast<u32>(freed)
+                                                               : __channel::Event::all);
+        return got;
+    }
+
+    void release() noexcept {
+        if (shared_ && shared_->receivers.fetch_sub(1, libcxx::memory_order_acq_rel) == 1) {
+            shared_->close();
+        }
+        shared_.reset();
+    }
+
+    libcxx::shared_ptr<__channel::Shared<Q>> shared_;
+};
+
+/// an unbounded MPSC channel.
+template <typename T>
+libcxx::pair<Sender<MpSc<T>>, Receiver<MpSc<T>>> mpsc() {
+    auto shared = libcxx::make_shared<__channel::Shared<MpSc<T>>>();
+    return {Sender<MpSc<T>>(shared), Receiver<MpSc<T>>(shared)};
+}
+
+/// a bounded MPSC channel holding at most `capacity` values (rounded up to a power of two).
+template <typename T>
+libcxx::pair<Sender<BoundedMpSc<T>>, Receiver<BoundedMpSc<T>>> mpsc(usize capacity) {
+    auto shared = libcxx::make_shared<__channel::Shared<BoundedMpSc<T>>>(capacity);
+    return {Sender<BoundedMpSc<T>>(shared), Receiver<BoundedMpSc<T>>(shared)};
+}
+
+/// a bounded SPMC channel holding at most `capacity` values (rounded up to a power of two).
+template <typename T>
+libcxx::pair<Sender<SpMc<T>>, Receiver<SpMc<T>>> spmc(usize capacity) {
+    auto shared = libcxx::make_shared<__channel::Shared<SpMc<T>>>(capacity);
+    return {Sender<SpMc<T>>(shared), Receiver<SpMc<T>>(shared)};
+}
+}  // namespace Sync
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M7CHANNEL
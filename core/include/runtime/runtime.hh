@@ -16,7 +16,9 @@
 #include <include/runtime/__panic/panic.hh>
 #include <include/runtime/__panic/stacktrace.hh>
 #include <include/runtime/__memory/memory.hh>
+#include <include/runtime/__memory/alloc_profile.hh>
 #include <include/runtime/__io/io.hh>
+#include <include/runtime/__sync/channel.hh>
 #include <include/runtime/__generator/generator.hh>
 #include <include/runtime/__finally/finally.hh>
 
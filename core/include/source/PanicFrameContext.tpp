@@ -83,6 +83,20 @@ FrameContext::FrameContext(T *obj)
     handler = &FrameContext::throw_object<T>;
 }
 
+template <typename T>
+FrameContext::FrameContext(Memory::small_owned_t tag, T *obj)
+    : error(std::erase_type(tag, obj)) {
+    if constexpr (!Panic::Interface::Panicking<T>) {
+        static_assert(Panic::Interface::Panicking<T>,
+                      "Frame invoked with an object that does not have a panic method, add "
+                      "`class ... impl Panic::Interface::Panicking` "
+                      "to the definition, and implement 'fn op panic (self) -> string' or the "
+                      "static variant.");
+    }
+
+    handler = &FrameContext::throw_object<T>;
+}
+
 bool FrameContext::operator!=(const libcxx::type_info *rhs) const { return !(*this == rhs); }
 
 bool FrameContext::operator==(const libcxx::type_info *rhs) const {
@@ -16,6 +16,8 @@
 #include <include/config/config.hh>
 #include <include/meta/enable_if.hh>
 #include <include/meta/traits.hh>
+#include <include/types/maping/btree_fwd.hh>
+#include <include/types/vector/vector_fwd.hh>
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -88,8 +90,13 @@ inline constexpr kairo::std::null_t null;
 [" hi ", "wsg"]
 */
 
+#if defined(KAIRO_NATIVE_VEC)
+template <typename T>
+using vec = kairo::std::Vector<T>;
+#else
 template <typename T>
 using vec = kairo::libcxx::vector<T>;
+#endif
 
 template <typename K,
           typename V,
@@ -97,6 +104,16 @@ template <typename K,
           class A = kairo::libcxx::allocator<kairo::libcxx::pair<const K, V>>>
 using map = kairo::libcxx::map<K, V, C, A>;
 
+// a name of its own rather than a retargeted `map`: code written against map may hold
+// iterators or references across an insert, which a B-tree invalidates
+#if defined(KAIRO_BTREE_MAP)
+template <typename K,
+          typename V,
+          class C = kairo::libcxx::less<K>,
+          class A = kairo::libcxx::allocator<kairo::libcxx::pair<const K, V>>>
+using btree_map = kairo::std::btree_map<K, V, C, A>;
+#endif
+
 template <typename T, usize S>
 using array = kairo::libcxx::array<T, S>;
 
@@ -247,4 +264,13 @@ struct i128 {
     inline i128 operator-() const;
 };
 
+// the runtime headers use vec<T> in non-template code, so the class has to be complete as soon
+// as the alias is
+#if defined(KAIRO_NATIVE_VEC)
+#   include <include/types/vector/vector.hh>
+#endif
+#if defined(KAIRO_BTREE_MAP)
+#   include <include/types/maping/btree.hh>
+#endif
+
 #endif  // _$_HX_CORE_M10PRIMITIVES
@@ -14,8 +14,933 @@
 
 #include <include/config/config.hh>
 
+#include <bit>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/runtime/__memory/relocate.hh>
+
 H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace __ring {
+/// random-access iterator over a ring. `pos` is the unmasked slot index (head + i), so two
+/// iterators compare and subtract as plain integers and only a dereference applies the mask.
+template <typename T, bool Const>
+class Iterator {
+    using slot = libcxx::conditional_t<Const, const T, T>;
+
+  public:
+    using iterator_category = libcxx::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = libcxx::ptrdiff_t;
+    using pointer           = slot *;
+    using reference         = slot &;
+
+    Iterator() = default;
+    Iterator(slot *slots, usize mask, usize pos) noexcept
+        : slots_(slots)
+        , mask_(mask)
+        , pos_(pos) {}
+
+    operator Iterator<T, true>() const noexcept  // NOLINT(google-explicit-constructor)
+        requires(!Const)
+    {
+        return {slots_, mask_, pos_};
+    }
+
+    reference operator*() const noexcept { return slots_[pos_ & mask_]; }
+    pointer   operator->() const noexcept { return slots_ + (pos_ & mask_); }
+    reference operator[](difference_type n) const noexcept {
+        return slots_[(pos_ + static_cast<usize>(n)) & mask_];
+    }
+
+    Iterator &operator++() noexcept {
+        ++pos_;
+        return *this;
+    }
+    Iterator operator++(int) noexcept { return {slots_, mask_, pos_++}; }
+    Iterator &operator--() noexcept {
+        --pos_;
+        return *this;
+    }
+    Iterator operator--(int) noexcept { return {slots_, mask_, pos_--}; }
+
+    Iterator &operator+=(difference_type n) noexcept {
+        pos_ += static_cast<usize>(n);
+        return *this;
+    }
+    Iterator &operator-=(difference_type n) noexcept {
+        pos_ -= static_cast<usize>(n);
+        return *this;
+    }
+
+    friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+    friend difference_type operator-(const Iterator &a, const Iterator &b) noexcept {
+        return static_cast<difference_type>(a.pos_ - b.pos_);
+    }
+
+    friend bool operator==(const Iterator &a, const Iterator &b) noexcept {
+        return a.pos_ == b.pos_;
+    }
+    friend auto operator<=>(const Iterator &a, const Iterator &b) noexcept {
+        return a.pos_ <=> b.pos_;
+    }
+
+  private:
+    slot *slots_{nullptr};
+    usize mask_{0};
+    usize pos_{0};
+};
+
+/// everything ring_deque and bounded_ring share: element access, iteration, the two-slice view
+/// and the operations that never need more room. `D` supplies slots(), mask() (capacity - 1)
+/// and the capacity check before any construct_*.
+template <typename D, typename T>
+class Ring {
+  public:
+    using value_type             = T;
+    using size_type              = usize;
+    using difference_type        = libcxx::ptrdiff_t;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using iterator               = Iterator<T, false>;
+    using const_iterator         = Iterator<T, true>;
+    using reverse_iterator       = libcxx::reverse_iterator<iterator>;
+    using const_reverse_iterator = libcxx::reverse_iterator<const_iterator>;
+
+    // element access
+
+    T       &operator[](usize i) noexcept { return *slot(i); }
+    const T &operator[](usize i) const noexcept { return *slot(i); }
+
+    T &at(usize i) {
+        if (i >= size_) {
+            throw libcxx::out_of_range(libcxx::string(D::kind) + "::at: index " +
+                                       libcxx::to_string(i) + " >= size " +
+                                       libcxx::to_string(size_));
+        }
+        return *slot(i);
+    }
+
+    const T &at(usize i) const { return const_cast<Ring *>(this)->at(i); }
+
+    T       &front() noexcept { return *slot(0); }
+    const T &front() const noexcept { return *slot(0); }
+    T       &back() noexcept { return *slot(size_ - 1); }
+    const T &back() const noexcept { return *slot(size_ - 1); }
+
+    /// the elements as at most two contiguous runs, oldest first: [head, end of storage) and
+    /// [start of storage, tail). the second is empty unless the ring has wrapped.
+    libcxx::pair<libcxx::span<T>, libcxx::span<T>> as_slices() noexcept {
+        auto [a, b] = split();
+        return {{self().slots() + head_, a}, {self().slots(), b}};
+    }
+
+    libcxx::pair<libcxx::span<const T>, libcxx::span<const T>> as_slices() const noexcept {
+        auto [a, b] = split();
+        return {{self().slots() + head_, a}, {self().slots(), b}};
+    }
+
+    // iterators
+
+    iterator       begin() noexcept { return {self().slots(), self().mask(), head_}; }
+    const_iterator begin() const noexcept { return {self().slots(), self().mask(), head_}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return {self().slots(), self().mask(), head_ + size_}; }
+    const_iterator end() const noexcept { return {self().slots(), self().mask(), head_ + size_}; }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // capacity
+
+    bool  empty() const noexcept { return size_ == 0; }
+    bool  is_empty() const noexcept { return size_ == 0; }
+    bool  full() const noexcept { return size_ == self().capacity(); }
+    usize size() const noexcept { return size_; }
+
+    // modifiers
+
+    void pop_front() noexcept {
+        self().destroy(slot(0));
+        head_ = (head_ + 1) & self().mask();
+        --size_;
+    }
+
+    void pop_back() noexcept {
+        self().destroy(slot(size_ - 1));
+        --size_;
+    }
+
+    /// move the front element out and pop it; the queue-style pop.
+    T take_front() {
+        T out(libcxx::move(front()));
+        pop_front();
+        return out;
+    }
+
+    T take_back() {
+        T out(libcxx::move(back()));
+        pop_back();
+        return out;
+    }
+
+    /// pop the first / last `n` elements (n <= size()).
+    void drop_front(usize n) noexcept {
+        assert(n <= size_ && "ring: drop_front past the end");
+        destroy_range(0, n);
+        head_ = (head_ + n) & self().mask();
+        size_ -= n;
+    }
+
+    void drop_back(usize n) noexcept {
+        assert(n <= size_ && "ring: drop_back past the front");
+        destroy_range(size_ - n, n);
+        size_ -= n;
+    }
+
+    void clear() noexcept {
+        destroy_range(0, size_);
+        head_ = 0;
+        size_ = 0;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    /// shifts whichever side of the gap is shorter, so erasing near either end is cheap.
+    iterator erase(const_iterator first, const_iterator last) {
+        const usize at = static_cast<usize>(first - cbegin());
+        const usize n  = static_cast<usize>(last - first);
+
+        if (n == 0) {
+            return begin() + static_cast<difference_type>(at);
+        }
+
+        if (at < size_ - at - n) {
+            libcxx::move_backward(begin(), begin() + at, begin() + (at + n));
+            drop_front(n);
+        } else {
+            libcxx::move(begin() + (at + n), end(), begin() + at);
+            drop_back(n);
+        }
+        return begin() + static_cast<difference_type>(at);
+    }
+
+    friend bool operator==(const D &a, const D &b) {
+        return a.size() == b.size() && libcxx::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend auto operator<=>(const D &a, const D &b)
+        requires libcxx::three_way_comparable<T>
+    {
+        return libcxx::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+  protected:
+    D       &self() noexcept { return static_cast<D &>(*this); }
+    const D &self() const noexcept { return static_cast<const D &>(*this); }
+
+    T *slot(usize i) const noexcept {
+        return const_cast<T *>(self().slots()) + ((head_ + i) & self().mask());
+    }
+
+    /// lengths of the two runs as_slices() returns.
+    libcxx::pair<usize, usize> split() const noexcept {
+        const usize room = self().capacity() - head_;
+        return size_ <= room ? libcxx::pair<usize, usize>{size_, 0}
+                             : libcxx::pair<usize, usize>{room, size_ - room};
+    }
+
+    // the construct_* helpers assume a free slot; args may refer to an element, which stays
+    // where it is since nothing else moves.
+
+    template <typename... Args>
+    T &construct_back(Args &&...args) {
+        T *at = slot(size_);
+        self().construct(at, std::Memory::forward<Args>(args)...);
+        ++size_;
+        return *at;
+    }
+
+    template <typename... Args>
+    T &construct_front(Args &&...args) {
+        const usize head = (head_ - 1) & self().mask();
+        T          *at   = self().slots() + head;
+        self().construct(at, std::Memory::forward<Args>(args)...);
+        head_ = head;
+        ++size_;
+        return *at;
+    }
+
+    /// copy n elements from `src` onto the back; the caller has made room.
+    void construct_back_n(const T *src, usize n) {
+        if (n == 0) {
+            return;
+        }
+
+        if constexpr (libcxx::is_trivially_copyable_v<T>) {
+            const usize tail = (head_ + size_) & self().mask();
+            const usize run  = libcxx::min(n, self().capacity() - tail);
+            libcxx::memcpy(static_cast<void *>(self().slots() + tail),
+                           static_cast<const void *>(src), run * sizeof(T));
+            libcxx::memcpy(static_cast<void *>(self().slots()),
+                           static_cast<const void *>(src + run), (n - run) * sizeof(T));
+            size_ += n;
+        } else {
+            for (usize i = 0; i < n; ++i) {
+                construct_back(src[i]);
+            }
+        }
+    }
+
+    void destroy_range(usize from, usize n) noexcept {
+        if constexpr (!libcxx::is_trivially_destructible_v<T>) {
+            for (usize i = 0; i < n; ++i) {
+                self().destroy(slot(from + i));
+            }
+        }
+    }
+
+    usize head_{0};
+    usize size_{0};
+};
+}  // namespace __ring
+
+///
+/// \brief Double-ended queue in one power-of-two circular buffer. Pushing or popping at either
+///        end is O(1) and allocation-free until the buffer is full, when it doubles; indexing
+///        is a mask instead of std::deque's block lookup, and iteration walks at most two
+///        contiguous runs.
+///
+/// It has the std::deque interface, except that growing relocates the elements: any push that
+/// grows invalidates pointers, references and iterators. as_slices() hands out the two runs
+/// directly, e.g. for writev or a bulk copy:
+/// \code
+///   ring_deque<char> pending;
+///   pending.append(buf, got);
+///   auto [a, b] = pending.as_slices();
+///   out.append(a.data(), a.size()).append(b.data(), b.size());
+///   pending.drop_front(a.size() + b.size());
+/// \endcode
+///
+template <typename T, typename A = libcxx::allocator<T>>
+class ring_deque : public __ring::Ring<ring_deque<T, A>, T> {
+    using base   = __ring::Ring<ring_deque<T, A>, T>;
+    using traits = libcxx::allocator_traits<A>;
+
+    friend base;
+
+    using base::head_;
+    using base::size_;
+
+  public:
+    using allocator_type = A;
+    using typename base::const_iterator;
+    using typename base::iterator;
+
+    static constexpr const char *kind = "ring_deque";
+
+    ring_deque() noexcept(noexcept(A())) = default;
+    explicit ring_deque(const A &alloc) noexcept
+        : alloc_(alloc) {}
+
+    explicit ring_deque(usize count, const A &alloc = A())
+        : alloc_(alloc) {
+        resize(count);
+    }
+
+    ring_deque(usize count, const T &value, const A &alloc = A())
+        : alloc_(alloc) {
+        assign(count, value);
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    ring_deque(It first, It last, const A &alloc = A())
+        : alloc_(alloc) {
+        assign(first, last);
+    }
+
+    ring_deque(libcxx::initializer_list<T> init, const A &alloc = A())
+        : alloc_(alloc) {
+        assign(init.begin(), init.end());
+    }
+
+    ring_deque(const ring_deque &other)
+        : alloc_(traits::select_on_container_copy_construction(other.alloc_)) {
+        reserve(other.size());
+        copy_from(other);
+    }
+
+    ring_deque(ring_deque &&other) noexcept
+        : alloc_(libcxx::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ring_deque &operator=(const ring_deque &other) {
+        if (this != &other) {
+            if constexpr (traits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != other.alloc_) {
+                    clear();
+                    release();
+                }
+                alloc_ = other.alloc_;
+            }
+            clear();
+            reserve(other.size());
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    ring_deque &operator=(ring_deque &&other) noexcept(
+        traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (traits::propagate_on_container_move_assignment::value ||
+                      traits::is_always_equal::value) {
+            clear();
+            release();
+            if constexpr (traits::propagate_on_container_move_assignment::value) {
+                alloc_ = libcxx::move(other.alloc_);
+            }
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                clear();
+                release();
+                steal(other);
+            } else {
+                assign(libcxx::make_move_iterator(other.begin()),
+                       libcxx::make_move_iterator(other.end()));
+            }
+        }
+        return *this;
+    }
+
+    ring_deque &operator=(libcxx::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~ring_deque() {
+        clear();
+        release();
+    }
+
+    using base::clear;
+
+    void assign(usize count, const T &value) {
+        T copy(value);  // value may live in the ring
+        clear();
+        reserve(count);
+        for (usize i = 0; i < count; ++i) {
+            this->construct_back(copy);
+        }
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    void assign(It first, It last) {
+        clear();
+        if constexpr (libcxx::is_base_of_v<
+                          libcxx::forward_iterator_tag,
+                          typename libcxx::iterator_traits<It>::iterator_category>) {
+            reserve(static_cast<usize>(libcxx::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    }
+
+    void assign(libcxx::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    A get_allocator() const noexcept { return alloc_; }
+
+    // capacity
+
+    usize capacity() const noexcept { return cap_; }
+
+    usize max_size() const noexcept {
+        usize by_alloc = traits::max_size(alloc_);
+        usize by_bytes = usize(libcxx::numeric_limits<libcxx::ptrdiff_t>::max()) / sizeof(T);
+        return libcxx::bit_floor(by_alloc < by_bytes ? by_alloc : by_bytes);
+    }
+
+    /// room for at least `count` elements; the capacity is always a power of two.
+    void reserve(usize count) {
+        if (count > cap_) {
+            reallocate(round_capacity(count));
+        }
+    }
+
+    void shrink_to_fit() {
+        if (size_ == 0) {
+            release();
+        } else if (libcxx::bit_ceil(size_) < cap_) {
+            reallocate(libcxx::bit_ceil(size_));
+        }
+    }
+
+    /// rotate the elements to the start of the buffer so they form one run, and return it.
+    /// O(size()) when the ring has wrapped, O(1) otherwise.
+    libcxx::span<T> make_contiguous() {
+        if (head_ + size_ > cap_) {
+            reallocate(cap_);
+        }
+        return {buf_ + head_, size_};
+    }
+
+    // modifiers
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(libcxx::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(libcxx::move(value)); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (size_ == cap_) [[unlikely]] {
+            return grow_emplace(size_, std::Memory::forward<Args>(args)...);
+        }
+        return this->construct_back(std::Memory::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    T &emplace_front(Args &&...args) {
+        if (size_ == cap_) [[unlikely]] {
+            return grow_emplace(usize(-1), std::Memory::forward<Args>(args)...);
+        }
+        return this->construct_front(std::Memory::forward<Args>(args)...);
+    }
+
+    /// copy `n` elements from `src` onto the back: at most two memcpy calls for trivially
+    /// copyable T. `src` must not point into this ring.
+    ring_deque &append(const T *src, usize n) {
+        reserve(size_ + n);
+        this->construct_back_n(src, n);
+        return *this;
+    }
+
+    template <typename R>
+    ring_deque &extend(R &&range) {
+        if constexpr (libcxx::ranges::sized_range<R>) {
+            reserve(size_ + static_cast<usize>(libcxx::ranges::size(range)));
+        }
+        for (auto &&item : range) {
+            emplace_back(std::Memory::forward<decltype(item)>(item));
+        }
+        return *this;
+    }
+
+    template <typename R>
+    void append_range(R &&range) {
+        extend(std::Memory::forward<R>(range));
+    }
+
+    /// constructs at whichever end is nearer `pos` and rotates the new element into place.
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        const usize at = static_cast<usize>(pos - this->cbegin());
+        const auto  d  = static_cast<libcxx::ptrdiff_t>(at);
+
+        if (at < size_ / 2) {
+            emplace_front(std::Memory::forward<Args>(args)...);
+            libcxx::rotate(this->begin(), this->begin() + 1, this->begin() + (d + 1));
+        } else {
+            emplace_back(std::Memory::forward<Args>(args)...);
+            libcxx::rotate(this->begin() + d, this->end() - 1, this->end());
+        }
+        return this->begin() + d;
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, libcxx::move(value)); }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    iterator insert(const_iterator pos, It first, It last) {
+        const usize at  = static_cast<usize>(pos - this->cbegin());
+        const usize old = size_;
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        const auto d = static_cast<libcxx::ptrdiff_t>(at);
+        libcxx::rotate(this->begin() + d,
+                       this->begin() + static_cast<libcxx::ptrdiff_t>(old),
+                       this->end());
+        return this->begin() + d;
+    }
+
+    iterator insert(const_iterator pos, libcxx::initializer_list<T> init) {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    void resize(usize count) {
+        if (count <= size_) {
+            this->drop_back(size_ - count);
+            return;
+        }
+
+        reserve(count);
+        while (size_ < count) {
+            this->construct_back();
+        }
+    }
+
+    void resize(usize count, const T &value) {
+        if (count <= size_) {
+            this->drop_back(size_ - count);
+            return;
+        }
+
+        T copy(value);
+        reserve(count);
+        while (size_ < count) {
+            this->construct_back(copy);
+        }
+    }
+
+    void swap(ring_deque &other) noexcept {
+        libcxx::swap(buf_, other.buf_);
+        libcxx::swap(cap_, other.cap_);
+        libcxx::swap(head_, other.head_);
+        libcxx::swap(size_, other.size_);
+        if constexpr (traits::propagate_on_container_swap::value) {
+            libcxx::swap(alloc_, other.alloc_);
+        }
+    }
+
+    friend void swap(ring_deque &a, ring_deque &b) noexcept { a.swap(b); }
+
+  private:
+    T    *slots() const noexcept { return buf_; }
+    usize mask() const noexcept { return cap_ - 1; }
+
+    template <typename... Args>
+    void construct(T *at, Args &&...args) {
+        traits::construct(alloc_, at, std::Memory::forward<Args>(args)...);
+    }
+
+    void destroy(T *at) noexcept { traits::destroy(alloc_, at); }
+
+    usize round_capacity(usize need) const {
+        if (need > max_size()) {
+            throw libcxx::length_error("ring_deque: capacity overflow");
+        }
+
+        usize floor = sizeof(T) < 64 ? 64 / sizeof(T) : 1;  // first block: a cache line
+        return libcxx::bit_ceil(need > floor ? need : floor);
+    }
+
+    /// move the elements to the start of a fresh block of `count` (a power of two >= size()).
+    void reallocate(usize count) {
+        T *fresh = traits::allocate(alloc_, count);
+        try {
+            move_into(fresh);
+        } catch (...) {
+            traits::deallocate(alloc_, fresh, count);
+            throw;
+        }
+        if (buf_ != nullptr) {
+            traits::deallocate(alloc_, buf_, cap_);
+        }
+        buf_  = fresh;
+        cap_  = count;
+        head_ = 0;
+    }
+
+    /// relocate both runs into `fresh`. types that are neither trivially relocatable nor
+    /// nothrow-movable are copied when they can be, for the strong guarantee: on a throw the
+    /// copies made so far are destroyed and the caller still owns (and frees) `fresh`.
+    void move_into(T *fresh) {
+        auto [a, b] = this->split();
+
+        if constexpr (Memory::is_trivially_relocatable_v<T> ||
+                      libcxx::is_nothrow_move_constructible_v<T> ||
+                      !libcxx::is_copy_constructible_v<T>) {
+            if (buf_ != nullptr) {
+                Memory::relocate(fresh, buf_ + head_, a);
+                Memory::relocate(fresh + a, buf_, b);
+            }
+        } else {
+            usize done = 0;
+            try {
+                for (; done < size_; ++done) {
+                    traits::construct(alloc_, fresh + done, *this->slot(done));
+                }
+            } catch (...) {
+                for (usize i = 0; i < done; ++i) {
+                    traits::destroy(alloc_, fresh + i);
+                }
+                throw;
+            }
+            this->destroy_range(0, size_);
+        }
+    }
+
+    /// grow, then construct the new element at the back (`where` == size()) or the front. it is
+    /// built in the fresh block before the old one is released, since args may refer into it.
+    template <typename... Args>
+    T &grow_emplace(usize where, Args &&...args) {
+        const usize count = round_capacity(size_ + 1);
+        T          *fresh = traits::allocate(alloc_, count);
+        T          *at    = fresh + (where == size_ ? size_ : count - 1);
+
+        try {
+            traits::construct(alloc_, at, std::Memory::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(alloc_, fresh, count);
+            throw;
+        }
+
+        try {
+            move_into(fresh);
+        } catch (...) {
+            traits::destroy(alloc_, at);
+            traits::deallocate(alloc_, fresh, count);
+            throw;
+        }
+
+        if (buf_ != nullptr) {
+            traits::deallocate(alloc_, buf_, cap_);
+        }
+        buf_  = fresh;
+        cap_  = count;
+        head_ = where == size_ ? 0 : count - 1;
+        ++size_;
+        return *at;
+    }
+
+    void copy_from(const ring_deque &other) {
+        auto [a, b] = other.as_slices();
+        this->construct_back_n(a.data(), a.size());
+        this->construct_back_n(b.data(), b.size());
+    }
+
+    void release() noexcept {
+        if (buf_ != nullptr) {
+            traits::deallocate(alloc_, buf_, cap_);
+        }
+        buf_  = nullptr;
+        cap_  = 0;
+        head_ = 0;
+    }
+
+    void steal(ring_deque &other) noexcept {
+        buf_  = libcxx::exchange(other.buf_, nullptr);
+        cap_  = libcxx::exchange(other.cap_, 0);
+        head_ = libcxx::exchange(other.head_, 0);
+        size_ = libcxx::exchange(other.size_, 0);
+    }
+
+    T    *buf_{nullptr};
+    usize cap_{0};
+
+    [[no_unique_address]] A alloc_{};
+};
+
+///
+/// \brief Fixed-capacity ring of at most N elements (N a power of two) stored inline: no
+///        allocation ever, so it suits bounded work queues, recent-history windows and
+///        per-thread buffers.
+///
+/// Pushing onto a full ring is a caller error; use the try_ forms to test for room, or
+/// overwrite_back() to drop the oldest element instead:
+/// \code
+///   bounded_ring<Task *, 256> ready;
+///   if (!ready.try_push_back(task)) { spill(task); }
+///   while (!ready.empty()) { run(ready.take_front()); }
+/// \endcode
+///
+template <typename T, usize N>
+class bounded_ring : public __ring::Ring<bounded_ring<T, N>, T> {
+    static_assert(N != 0 && (N & (N - 1)) == 0, "bounded_ring: N must be a power of two");
+
+    using base = __ring::Ring<bounded_ring<T, N>, T>;
+
+    friend base;
+
+    using base::head_;
+    using base::size_;
+
+  public:
+    static constexpr const char *kind = "bounded_ring";
+
+    bounded_ring() noexcept = default;
+
+    bounded_ring(libcxx::initializer_list<T> init) {
+        assert(init.size() <= N && "bounded_ring: initializer longer than N");
+        for (const T &v : init) {
+            this->construct_back(v);
+        }
+    }
+
+    bounded_ring(const bounded_ring &other) { copy_from(other); }
+
+    bounded_ring(bounded_ring &&other) noexcept(libcxx::is_nothrow_move_constructible_v<T>) {
+        for (T &v : other) {
+            this->construct_back(libcxx::move(v));
+        }
+        other.clear();
+    }
+
+    bounded_ring &operator=(const bounded_ring &other) {
+        if (this != &other) {
+            this->clear();
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    bounded_ring &operator=(bounded_ring &&other) noexcept(
+        libcxx::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            this->clear();
+            for (T &v : other) {
+                this->construct_back(libcxx::move(v));
+            }
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~bounded_ring() { this->clear(); }
+
+    static constexpr usize capacity() noexcept { return N; }
+    static constexpr usize max_size() noexcept { return N; }
+
+    // modifiers
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(libcxx::move(value)); }
+    void push_front(const T &value) { emplace_front(value); }
+    void push_front(T &&value) { emplace_front(libcxx::move(value)); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        assert(size_ != N && "bounded_ring: push onto a full ring");
+        return this->construct_back(std::Memory::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    T &emplace_front(Args &&...args) {
+        assert(size_ != N && "bounded_ring: push onto a full ring");
+        return this->construct_front(std::Memory::forward<Args>(args)...);
+    }
+
+    /// false, and nothing constructed, when the ring is full.
+    bool try_push_back(const T &value) { return try_emplace_back(value) != nullptr; }
+    bool try_push_back(T &&value) { return try_emplace_back(libcxx::move(value)) != nullptr; }
+    bool try_push_front(const T &value) { return try_emplace_front(value) != nullptr; }
+    bool try_push_front(T &&value) { return try_emplace_front(libcxx::move(value)) != nullptr; }
+
+    template <typename... Args>
+    T *try_emplace_back(Args &&...args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        return &this->construct_back(std::Memory::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    T *try_emplace_front(Args &&...args) {
+        if (size_ == N) {
+            return nullptr;
+        }
+        return &this->construct_front(std::Memory::forward<Args>(args)...);
+    }
+
+    /// push onto the back, first dropping the front element if the ring is full: a sliding
+    /// window over the last N values.
+    template <typename... Args>
+    T &overwrite_back(Args &&...args) {
+        if (size_ == N) {
+            T value(std::Memory::forward<Args>(args)...);  // args may refer to the front
+            this->pop_front();
+            return this->construct_back(libcxx::move(value));
+        }
+        return this->construct_back(std::Memory::forward<Args>(args)...);
+    }
+
+    /// copy `n` elements (n <= N - size()) from `src` onto the back.
+    bounded_ring &append(const T *src, usize n) {
+        assert(n <= N - size_ && "bounded_ring: append past capacity");
+        this->construct_back_n(src, n);
+        return *this;
+    }
+
+  private:
+    T *slots() const noexcept {
+        return const_cast<T *>(reinterpret_cast<const T *>(storage_));
+    }
+    static constexpr usize mask() noexcept { return N - 1; }
+
+    template <typename... Args>
+    void construct(T *at, Args &&...args) {
+        ::new (static_cast<void *>(at)) T(std::Memory::forward<Args>(args)...);
+    }
+
+    void destroy(T *at) noexcept { at->~T(); }
+
+    void copy_from(const bounded_ring &other) {
+        auto [a, b] = other.as_slices();
+        this->construct_back_n(a.data(), a.size());
+        this->construct_back_n(b.data(), b.size());
+    }
+
+    alignas(T) unsigned char storage_[sizeof(T) * N];  // NOLINT
+};
+
+template <typename T, typename A, typename U>
+usize erase(ring_deque<T, A> &d, const U &value) {
+    auto  it  = libcxx::remove(d.begin(), d.end(), value);
+    usize out = static_cast<usize>(d.end() - it);
+    d.drop_back(out);
+    return out;
+}
+
+template <typename T, typename A, typename Pred>
+usize erase_if(ring_deque<T, A> &d, Pred pred) {
+    auto  it  = libcxx::remove_if(d.begin(), d.end(), pred);
+    usize out = static_cast<usize>(d.end() - it);
+    d.drop_back(out);
+    return out;
+}
+
+template <typename T, usize N, typename Pred>
+usize erase_if(bounded_ring<T, N> &r, Pred pred) {
+    auto  it  = libcxx::remove_if(r.begin(), r.end(), pred);
+    usize out = static_cast<usize>(r.end() - it);
+    r.drop_back(out);
+    return out;
+}
+
+namespace Memory {
+/// a ring_deque is a pointer to its own heap block plus counters; a bounded_ring holds its
+/// elements inline and moves with them.
+template <typename T, typename A>
+struct is_trivially_relocatable<ring_deque<T, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<A>> {};
+
+template <typename T, usize N>
+struct is_trivially_relocatable<bounded_ring<T, N>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<T>> {};
+}  // namespace Memory
 
+H_STD_NAMESPACE_END
 H_NAMESPACE_END
 
 #endif  // _$_HX_CORE_M10COLLECTION
@@ -0,0 +1,1157 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M5BTREE
+#define _$_HX_CORE_M5BTREE
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/types/maping/btree_fwd.hh>
+#include <include/types/maping/key_search.hh>
+#include <include/types/maping/map_api.hh>
+#include <include/types/maping/slot_policy.hh>
+
+/// bytes of elements (plus the key copies used for SIMD search) per node. 256-512 keeps a node
+/// within a few cache lines while holding enough keys to make the tree shallow.
+#ifndef KAIRO_BTREE_NODE_BYTES
+#   define KAIRO_BTREE_NODE_BYTES 512
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace __btree {
+/// integral keys under the natural order keep a packed copy of the node's keys next to the
+/// elements; the copies past the count hold the largest key, so a search scans all N.
+template <typename K, usize N, bool Enabled>
+struct KeyCopies {
+    K keys[N];
+};
+
+template <typename K, usize N>
+struct KeyCopies<K, N, false> {};
+
+/// a leaf node; internal nodes extend it with child pointers.
+template <typename Policy, usize N, bool Mirror>
+struct Node {
+    using slot_type = typename Policy::slot_type;
+
+    Node *parent{nullptr};
+    u16   position{0};  // index among the parent's children
+    u16   count{0};
+    bool  leaf{true};
+
+    [[no_unique_address]] KeyCopies<typename Policy::key_type, N, Mirror> mirror;
+    slot_type slots[N];
+};
+
+template <typename Policy, usize N, bool Mirror>
+struct Inner : Node<Policy, N, Mirror> {
+    Node<Policy, N, Mirror> *children[N + 1];
+};
+
+/// elements per node: as many as fit in KAIRO_BTREE_NODE_BYTES, at least 3 and at most 254.
+template <typename Policy, bool Mirror>
+constexpr usize node_slots() noexcept {
+    constexpr usize header = sizeof(void *) + 8;
+    constexpr usize per    = sizeof(typename Policy::slot_type) +
+                          (Mirror ? sizeof(typename Policy::key_type) : 0);
+    constexpr usize fit = KAIRO_BTREE_NODE_BYTES > header ? (KAIRO_BTREE_NODE_BYTES - header) / per
+                                                          : 0;
+    return fit < 3 ? 3 : (fit > 254 ? 254 : fit);
+}
+
+///
+/// \brief The B-tree behind btree_map and btree_set. Elements sit in every node, in order;
+///        an internal node with n elements has n + 1 children. Nodes are filled to at least
+///        half except transiently at the edges, and a split biases toward the side being
+///        inserted into, so ascending inserts fill nodes almost completely.
+///
+/// Iterators are a (node, index) pair and walk the tree through parent pointers. Any insert or
+/// erase may move elements between nodes, so like a hash_map (and unlike std::map), it
+/// invalidates iterators and references.
+///
+/// The Policy is one of the slot policies the hash tables use (see slot_policy.hh); with
+/// `trivially_relocatable` elements shift within and between nodes by memmove.
+///
+template <typename Policy, typename Compare, typename Alloc>
+class Tree {
+  public:
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using slot_type       = typename Policy::slot_type;
+    using key_compare     = Compare;
+    using allocator_type  = Alloc;
+    using size_type       = usize;
+    using difference_type = libcxx::ptrdiff_t;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+
+    static constexpr bool transparent = requires { typename Compare::is_transparent; };
+
+    template <typename K>
+    using key_arg = typename __maping::KeyArg<transparent>::template type<K, key_type>;
+
+  private:
+    static constexpr bool  mirror = __maping::simd_keys<key_type, Compare>;
+    static constexpr usize N      = node_slots<Policy, mirror>();
+    static constexpr usize min    = N / 2;
+
+    using Leaf  = Node<Policy, N, mirror>;
+    using Inner = __btree::Inner<Policy, N, mirror>;
+
+    using traits       = libcxx::allocator_traits<Alloc>;
+    using leaf_alloc   = typename traits::template rebind_alloc<Leaf>;
+    using inner_alloc  = typename traits::template rebind_alloc<Inner>;
+    using leaf_traits  = libcxx::allocator_traits<leaf_alloc>;
+    using inner_traits = libcxx::allocator_traits<inner_alloc>;
+
+    template <bool Const>
+    class basic_iterator {
+        friend class Tree;
+
+      public:
+        using iterator_category = libcxx::bidirectional_iterator_tag;
+        using value_type        = Tree::value_type;
+        using difference_type   = libcxx::ptrdiff_t;
+        // sets only hand out const elements
+        using reference = libcxx::conditional_t<
+            Const,
+            const value_type &,
+            decltype(Policy::element(libcxx::declval<slot_type *>()))>;
+        using pointer = libcxx::add_pointer_t<reference>;
+
+        basic_iterator() noexcept = default;
+
+        template <bool C = Const>
+            requires C
+        basic_iterator(const basic_iterator<false> &other) noexcept  // NOLINT
+            : node_(other.node_)
+            , pos_(other.pos_) {}
+
+        reference operator*() const noexcept { return Policy::element(node_->slots + pos_); }
+        pointer   operator->() const noexcept { return libcxx::addressof(**this); }
+
+        basic_iterator &operator++() noexcept {
+            if (node_->leaf) {
+                if (++pos_ < node_->count) {
+                    return *this;
+                }
+                // past the leaf's end: the next element is in the first ancestor we entered
+                // from a child that is not its last
+                const basic_iterator save = *this;
+                while (pos_ == node_->count && node_->parent != nullptr) {
+                    pos_  = node_->position;
+                    node_ = node_->parent;
+                }
+                if (pos_ == node_->count) {
+                    *this = save;  // end()
+                }
+            } else {
+                node_ = static_cast<Inner *>(node_)->children[pos_ + 1];
+                while (!node_->leaf) {
+                    node_ = static_cast<Inner *>(node_)->children[0];
+                }
+                pos_ = 0;
+            }
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            basic_iterator out = *this;
+            ++*this;
+            return out;
+        }
+
+        basic_iterator &operator--() noexcept {
+            if (node_->leaf) {
+                if (pos_ > 0) {
+                    --pos_;
+                    return *this;
+                }
+                while (pos_ == 0 && node_->parent != nullptr) {
+                    pos_  = node_->position;
+                    node_ = node_->parent;
+                }
+                --pos_;
+            } else {
+                node_ = static_cast<Inner *>(node_)->children[pos_];
+                while (!node_->leaf) {
+                    node_ = static_cast<Inner *>(node_)->children[node_->count];
+                }
+                pos_ = node_->count - 1;
+            }
+            return *this;
+        }
+
+        basic_iterator operator--(int) noexcept {
+            basic_iterator out = *this;
+            --*this;
+            return out;
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) noexcept {
+            return a.node_ == b.node_ && a.pos_ == b.pos_;
+        }
+
+      private:
+        basic_iterator(Leaf *node, usize pos) noexcept
+            : node_(node)
+            , pos_(pos) {}
+
+        Leaf *node_{nullptr};
+        usize pos_{0};
+    };
+
+  public:
+    using iterator               = basic_iterator<false>;
+    using const_iterator         = basic_iterator<true>;
+    using reverse_iterator       = libcxx::reverse_iterator<iterator>;
+    using const_reverse_iterator = libcxx::reverse_iterator<const_iterator>;
+
+    Tree() noexcept(noexcept(Compare()) && noexcept(Alloc())) = default;
+
+    explicit Tree(const Compare &comp, const Alloc &alloc = Alloc())
+        : comp_(comp)
+        , alloc_(alloc) {}
+
+    explicit Tree(const Alloc &alloc)
+        : alloc_(alloc) {}
+
+    template <typename InputIt>
+    Tree(InputIt first, InputIt last, const Compare &comp = Compare(), const Alloc &alloc = Alloc())
+        : Tree(comp, alloc) {
+        insert(first, last);
+    }
+
+    /// bulk load from input already sorted and free of duplicates: each element is appended to
+    /// the rightmost leaf, no comparisons, and nodes end up nearly full.
+    template <typename InputIt>
+    Tree(sorted_unique_t,
+         InputIt        first,
+         InputIt        last,
+         const Compare &comp  = Compare(),
+         const Alloc   &alloc = Alloc())
+        : Tree(comp, alloc) {
+        for (; first != last; ++first) {
+            append(*first);
+        }
+    }
+
+    Tree(libcxx::initializer_list<value_type> init,
+         const Compare                       &comp  = Compare(),
+         const Alloc                         &alloc = Alloc())
+        : Tree(init.begin(), init.end(), comp, alloc) {}
+
+    Tree(const Tree &other)
+        : Tree(other, traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    Tree(const Tree &other, const Alloc &alloc)
+        : comp_(other.comp_)
+        , alloc_(alloc) {
+        copy_from(other);
+    }
+
+    Tree(Tree &&other) noexcept
+        : comp_(libcxx::move(other.comp_))
+        , alloc_(libcxx::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ~Tree() { clear(); }
+
+    Tree &operator=(const Tree &other) {
+        if (this != &other) {
+            clear();
+            if constexpr (traits::propagate_on_container_copy_assignment::value) {
+                alloc_ = other.alloc_;
+            }
+            comp_ = other.comp_;
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    Tree &operator=(Tree &&other) noexcept(traits::propagate_on_container_move_assignment::value ||
+                                           traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+        comp_ = libcxx::move(other.comp_);
+
+        if constexpr (traits::propagate_on_container_move_assignment::value ||
+                      traits::is_always_equal::value) {
+            if constexpr (traits::propagate_on_container_move_assignment::value) {
+                alloc_ = libcxx::move(other.alloc_);
+            }
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                steal(other);
+            } else {
+                for (auto &v : other) {
+                    append(libcxx::move(v));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // --- iteration ---
+
+    iterator begin() noexcept { return iterator(leftmost_, 0); }
+    iterator end() noexcept {
+        return iterator(rightmost_, rightmost_ != nullptr ? rightmost_->count : 0);
+    }
+    const_iterator begin() const noexcept { return const_cast<Tree *>(this)->begin(); }
+    const_iterator end() const noexcept { return const_cast<Tree *>(this)->end(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    // --- capacity ---
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    usize              size() const noexcept { return size_; }
+    usize              max_size() const noexcept {
+        return (libcxx::numeric_limits<usize>::max)() / sizeof(slot_type);
+    }
+
+    /// elements per node for this element type.
+    static constexpr usize node_capacity() noexcept { return N; }
+
+    /// bytes held in nodes, for comparing footprints; excludes what elements own themselves.
+    usize bytes_used() const noexcept { return root_ != nullptr ? bytes_below(root_) : 0; }
+
+    // --- lookup ---
+
+    template <typename K = key_type>
+    iterator find(const key_arg<K> &key) {
+        if (root_ == nullptr) {
+            return end();
+        }
+        const Spot at = locate(key);
+        return at.exact ? iterator(at.node, at.pos) : end();
+    }
+
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K> &key) const {
+        return const_cast<Tree *>(this)->template find<K>(key);
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K> &key) const {
+        return root_ != nullptr && locate(key).exact;
+    }
+
+    template <typename K = key_type>
+    usize count(const key_arg<K> &key) const {
+        return contains<K>(key) ? 1 : 0;
+    }
+
+    /// first element not ordered before `key`.
+    template <typename K = key_type>
+    iterator lower_bound(const key_arg<K> &key) {
+        if (root_ == nullptr) {
+            return end();
+        }
+        Leaf *n = root_;
+        while (true) {
+            const usize i = lower_in(n, key);
+            if (i < n->count && !comp_(key, key_at(n, i))) {
+                return iterator(n, i);
+            }
+            if (n->leaf) {
+                return settle(n, i);
+            }
+            n = child(n, i);
+        }
+    }
+
+    template <typename K = key_type>
+    const_iterator lower_bound(const key_arg<K> &key) const {
+        return const_cast<Tree *>(this)->template lower_bound<K>(key);
+    }
+
+    /// first element ordered after `key`.
+    template <typename K = key_type>
+    iterator upper_bound(const key_arg<K> &key) {
+        if (root_ == nullptr) {
+            return end();
+        }
+        Leaf *n = root_;
+        while (true) {
+            const usize i = upper_in(n, key);
+            if (n->leaf) {
+                return settle(n, i);
+            }
+            n = child(n, i);
+        }
+    }
+
+    template <typename K = key_type>
+    const_iterator upper_bound(const key_arg<K> &key) const {
+        return const_cast<Tree *>(this)->template upper_bound<K>(key);
+    }
+
+    template <typename K = key_type>
+    libcxx::pair<iterator, iterator> equal_range(const key_arg<K> &key) {
+        iterator it = lower_bound<K>(key);
+        if (it == end() || comp_(key, Policy::key(it.node_->slots + it.pos_))) {
+            return {it, it};
+        }
+        iterator next = it;
+        return {it, ++next};
+    }
+
+    template <typename K = key_type>
+    libcxx::pair<const_iterator, const_iterator> equal_range(const key_arg<K> &key) const {
+        auto r = const_cast<Tree *>(this)->template equal_range<K>(key);
+        return {r.first, r.second};
+    }
+
+    // --- modifiers ---
+
+    template <typename... Args>
+    libcxx::pair<iterator, bool> emplace(Args &&...args) {
+        return emplace_built(end(), false, std::Memory::forward<Args>(args)...);
+    }
+
+    /// a correct hint (the element would go right before it) skips the search; appending in
+    /// ascending order with end() as the hint costs amortized O(1) per element.
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args &&...args) {
+        return emplace_built(iterator(hint.node_, hint.pos_), true,
+                             std::Memory::forward<Args>(args)...)
+            .first;
+    }
+
+    template <typename K, typename... Args>
+    libcxx::pair<iterator, bool> emplace_key(const K &key, Args &&...args) {
+        if (root_ == nullptr) {
+            return {insert_new(nullptr, 0, std::Memory::forward<Args>(args)...), true};
+        }
+        const Spot at = locate(key);
+        if (at.exact) {
+            return {iterator(at.node, at.pos), false};
+        }
+        return {insert_new(at.node, at.pos, std::Memory::forward<Args>(args)...), true};
+    }
+
+    template <typename K, typename... Args>
+    libcxx::pair<iterator, bool> emplace_key_hint(const_iterator hint,
+                                                  const K       &key,
+                                                  Args &&...args) {
+        iterator pos(hint.node_, hint.pos_);
+        switch (check_hint(pos, key)) {
+            case Hint::Before: {
+                Spot at = leaf_before(pos);
+                return {insert_new(at.node, at.pos, std::Memory::forward<Args>(args)...), true};
+            }
+            case Hint::Equal:
+                return {pos, false};
+            case Hint::Wrong:
+                break;
+        }
+        return emplace_key(key, std::Memory::forward<Args>(args)...);
+    }
+
+    /// inserts each element with end() as the hint, so sorted input is appended without
+    /// searching.
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            emplace_hint(end(), *first);
+        }
+    }
+
+    template <typename InputIt>
+    void insert(sorted_unique_t, InputIt first, InputIt last) {
+        insert(first, last);
+    }
+
+    iterator erase(const_iterator pos) noexcept { return erase(iterator(pos.node_, pos.pos_)); }
+
+    iterator erase(iterator pos) noexcept {
+        Leaf       *node     = pos.node_;
+        usize       at       = pos.pos_;
+        const bool  internal = !node->leaf;
+
+        Policy::destroy(alloc_, node->slots + at);
+        if (internal) {
+            // refill the hole with the predecessor, which is the last element of a leaf
+            iterator pred = pos;
+            --pred;
+            place(node, at, pred.node_->slots + pred.pos_);
+            node = pred.node_;
+            at   = pred.pos_;
+        }
+
+        move_slots(node, at, node, at + 1, node->count - at - 1);
+        --node->count;
+        pad(node);
+        --size_;
+
+        Spot next{node, at, false};
+        rebalance(node, next);
+        if (root_ == nullptr) {
+            return end();
+        }
+
+        iterator out = settle(next.node, next.pos);
+        if (internal) {
+            ++out;  // `next` tracked the predecessor, now back in order before the successor
+        }
+        return out;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        if (first == cbegin() && last == cend()) {
+            clear();
+            return end();
+        }
+        // positions shift under erase, so count instead of comparing against `last`
+        usize    n  = static_cast<usize>(libcxx::distance(first, last));
+        iterator it(first.node_, first.pos_);
+        while (n-- != 0) {
+            it = erase(it);
+        }
+        return it;
+    }
+
+    template <typename K = key_type>
+    usize erase(const key_arg<K> &key) {
+        iterator it = find<K>(key);
+        if (it == end()) {
+            return 0;
+        }
+        erase(it);
+        return 1;
+    }
+
+    void clear() noexcept {
+        if (root_ != nullptr) {
+            destroy_below(root_);
+        }
+        root_ = leftmost_ = rightmost_ = nullptr;
+        size_                          = 0;
+    }
+
+    void swap(Tree &other) noexcept {
+        using libcxx::swap;
+        swap(root_, other.root_);
+        swap(leftmost_, other.leftmost_);
+        swap(rightmost_, other.rightmost_);
+        swap(size_, other.size_);
+        swap(comp_, other.comp_);
+        if constexpr (traits::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
+    }
+
+    friend void swap(Tree &a, Tree &b) noexcept { a.swap(b); }
+
+    key_compare    key_comp() const { return comp_; }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    friend bool operator==(const Tree &a, const Tree &b) {
+        return a.size() == b.size() && libcxx::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend auto operator<=>(const Tree &a, const Tree &b)
+        requires libcxx::three_way_comparable<value_type>
+    {
+        return libcxx::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+  private:
+    /// a position in a node; `exact` when it holds the key searched for.
+    struct Spot {
+        Leaf *node;
+        usize pos;
+        bool  exact;
+    };
+
+    enum class Hint : u8 { Before, Equal, Wrong };
+
+    static Inner *inner(Leaf *n) noexcept { return static_cast<Inner *>(n); }
+    static Leaf  *child(Leaf *n, usize i) noexcept { return inner(n)->children[i]; }
+
+    static const key_type &key_at(const Leaf *n, usize i) noexcept {
+        return Policy::key(n->slots + i);
+    }
+
+    // --- in-node search ---
+
+    template <typename K>
+    usize lower_in(const Leaf *n, const K &key) const {
+        if constexpr (mirror && libcxx::is_same_v<K, key_type>) {
+            return __maping::count_keys<true>(n->mirror.keys, N, key);
+        } else {
+            usize lo = 0;
+            usize hi = n->count;
+            while (lo < hi) {
+                const usize mid = (lo + hi) / 2;
+                if (comp_(key_at(n, mid), key)) {
+                    lo = mid + 1;
+                } else {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+    }
+
+    template <typename K>
+    usize upper_in(const Leaf *n, const K &key) const {
+        if constexpr (mirror && libcxx::is_same_v<K, key_type>) {
+            const usize c = __maping::count_keys<false>(n->mirror.keys, N, key);
+            return c < n->count ? c : n->count;  // padding equals the largest key
+        } else {
+            usize lo = 0;
+            usize hi = n->count;
+            while (lo < hi) {
+                const usize mid = (lo + hi) / 2;
+                if (comp_(key, key_at(n, mid))) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+    }
+
+    /// the node and index holding `key`, or the leaf position it would be inserted at.
+    template <typename K>
+    Spot locate(const K &key) const {
+        Leaf *n = root_;
+        while (true) {
+            const usize i = lower_in(n, key);
+            if (i < n->count && !comp_(key, key_at(n, i))) {
+                return {n, i, true};
+            }
+            if (n->leaf) {
+                return {n, i, false};
+            }
+            n = child(n, i);
+        }
+    }
+
+    /// turn a position one past a leaf's last element into the element that follows it.
+    iterator settle(Leaf *n, usize pos) noexcept {
+        if (pos < n->count) {
+            return iterator(n, pos);
+        }
+        while (pos == n->count && n->parent != nullptr) {
+            pos = n->position;
+            n   = n->parent;
+        }
+        return pos == n->count ? end() : iterator(n, pos);
+    }
+
+    /// the leaf position right before element `pos` (or the end).
+    Spot leaf_before(iterator pos) noexcept {
+        if (pos.node_->leaf) {
+            return {pos.node_, pos.pos_, false};
+        }
+        Leaf *n = child(pos.node_, pos.pos_);
+        while (!n->leaf) {
+            n = child(n, n->count);
+        }
+        return {n, n->count, false};
+    }
+
+    template <typename K>
+    Hint check_hint(iterator pos, const K &key) const {
+        if (root_ == nullptr) {
+            return Hint::Wrong;
+        }
+        iterator first = const_cast<Tree *>(this)->begin();
+        iterator last  = const_cast<Tree *>(this)->end();
+        if (pos != last) {
+            const key_type &at = Policy::key(pos.node_->slots + pos.pos_);
+            if (!comp_(key, at)) {
+                return comp_(at, key) ? Hint::Wrong : Hint::Equal;
+            }
+        }
+        if (pos != first) {
+            iterator prev = pos;
+            --prev;
+            if (!comp_(Policy::key(prev.node_->slots + prev.pos_), key)) {
+                return Hint::Wrong;
+            }
+        }
+        return Hint::Before;
+    }
+
+    // --- insertion ---
+
+    /// build the element off to the side, since its key decides where it goes.
+    template <typename... Args>
+    libcxx::pair<iterator, bool> emplace_built(iterator hint, bool use_hint, Args &&...args) {
+        alignas(slot_type) unsigned char buf[sizeof(slot_type)];  // NOLINT
+        auto *tmp = reinterpret_cast<slot_type *>(buf);
+        Policy::construct(alloc_, tmp, std::Memory::forward<Args>(args)...);
+
+        try {
+            const key_type &key = Policy::key(tmp);
+            Spot            at{nullptr, 0, false};
+
+            if (root_ != nullptr) {
+                Hint h = use_hint ? check_hint(hint, key) : Hint::Wrong;
+                if (h == Hint::Equal) {
+                    Policy::destroy(alloc_, tmp);
+                    return {hint, false};
+                }
+                if (h == Hint::Before) {
+                    at = leaf_before(hint);
+                } else {
+                    at = locate(key);
+                    if (at.exact) {
+                        Policy::destroy(alloc_, tmp);
+                        return {iterator(at.node, at.pos), false};
+                    }
+                }
+            }
+            return {insert_slot(at.node, at.pos, tmp), true};
+        } catch (...) {
+            Policy::destroy(alloc_, tmp);
+            throw;
+        }
+    }
+
+    template <typename... Args>
+    iterator insert_new(Leaf *leaf, usize pos, Args &&...args) {
+        alignas(slot_type) unsigned char buf[sizeof(slot_type)];  // NOLINT
+        auto *tmp = reinterpret_cast<slot_type *>(buf);
+        Policy::construct(alloc_, tmp, std::Memory::forward<Args>(args)...);
+        try {
+            return insert_slot(leaf, pos, tmp);
+        } catch (...) {
+            Policy::destroy(alloc_, tmp);
+            throw;
+        }
+    }
+
+    template <typename... Args>
+    void append(Args &&...args) {
+        insert_new(rightmost_, rightmost_ != nullptr ? rightmost_->count : 0,
+                   std::Memory::forward<Args>(args)...);
+    }
+
+    /// move the built element `tmp` into `leaf` at `pos`, splitting full nodes on the way up.
+    /// on failure (allocation) the tree is unchanged apart from node shape and `tmp` is still
+    /// owned by the caller.
+    iterator insert_slot(Leaf *leaf, usize pos, slot_type *tmp) {
+        if (root_ == nullptr) {
+            leaf  = new_leaf();
+            root_ = leftmost_ = rightmost_ = leaf;
+            pos                            = 0;
+        } else if (leaf->count == N) {
+            make_room(leaf, pos);
+        }
+
+        move_slots(leaf, pos + 1, leaf, pos, leaf->count - pos);
+        place(leaf, pos, tmp);
+        ++leaf->count;
+        ++size_;
+        return iterator(leaf, pos);
+    }
+
+    /// split the full `node` so that position `pos` has room, updating both to where the
+    /// insert now goes. splits the parent first when it is full too.
+    void make_room(Leaf *&node, usize &pos) {
+        if (node->parent == nullptr) {
+            Inner *root       = new_inner();
+            root->children[0] = node;
+            node->parent      = root;
+            node->position    = 0;
+            root_             = root;
+        } else if (node->parent->count == N) {
+            Leaf *parent = node->parent;
+            usize at     = node->position;
+            make_room(parent, at);
+        }
+
+        Leaf *right = split(node, pos);
+        if (pos > node->count) {
+            pos -= node->count + 1;
+            node = right;
+        }
+    }
+
+    /// move the upper part of a full node into a new right sibling and its median into the
+    /// parent, which has room. inserting at either end leaves that side nearly empty and the
+    /// other full, so sorted input packs nodes instead of leaving them half full.
+    Leaf *split(Leaf *node, usize pos) {
+        Leaf       *right = node->leaf ? static_cast<Leaf *>(new_leaf()) : new_inner();
+        const usize n     = node->count;
+        const usize rc    = pos == 0 ? n - 1 : (pos == n ? 0 : n / 2);
+        const usize lc    = n - rc - 1;
+
+        move_slots(right, 0, node, lc + 1, rc);
+        if (!node->leaf) {
+            for (usize j = 0; j <= rc; ++j) {
+                adopt(right, j, child(node, lc + 1 + j));
+            }
+        }
+        right->count = static_cast<u16>(rc);
+        node->count  = static_cast<u16>(lc);
+
+        Inner      *parent = inner(node->parent);
+        const usize at     = node->position;
+        move_slots(parent, at + 1, parent, at, parent->count - at);
+        for (usize j = parent->count + 1; j > at + 1; --j) {
+            adopt(parent, j, parent->children[j - 1]);
+        }
+        place(parent, at, node->slots + lc);
+        adopt(parent, at + 1, right);
+        ++parent->count;
+
+        pad(node);
+        if (node == rightmost_) {
+            rightmost_ = right;
+        }
+        return right;
+    }
+
+    // --- erase rebalancing ---
+
+    /// restore the minimum fill from `node` upward after an erase: borrow from a sibling that
+    /// can spare an element, else merge with one. `next` is kept pointing at the same spot in
+    /// the element order.
+    void rebalance(Leaf *node, Spot &next) noexcept {
+        while (node != root_ && node->count < min) {
+            Inner      *parent = inner(node->parent);
+            const usize i      = node->position;
+            Leaf       *left   = i > 0 ? parent->children[i - 1] : nullptr;
+            Leaf       *right  = i < parent->count ? parent->children[i + 1] : nullptr;
+
+            if (left != nullptr && left->count > min) {
+                rotate_right(parent, i - 1, left, node);
+                if (next.node == node) {
+                    ++next.pos;
+                }
+                return;
+            }
+            if (right != nullptr && right->count > min) {
+                rotate_left(parent, i, node, right);
+                return;
+            }
+
+            if (left != nullptr) {
+                const usize lc = left->count;
+                merge(parent, i - 1, left, node);
+                if (next.node == node) {
+                    next = {left, next.pos + lc + 1, false};
+                }
+            } else {
+                merge(parent, i, node, right);
+            }
+            node = parent;
+        }
+
+        if (node == root_ && root_->count == 0) {
+            if (root_->leaf) {
+                free_node(root_);
+                root_ = leftmost_ = rightmost_ = nullptr;
+            } else {
+                Leaf *only = child(root_, 0);
+                free_node(root_);
+                only->parent   = nullptr;
+                only->position = 0;
+                root_          = only;
+            }
+        }
+    }
+
+    /// separator down to the front of `node`, last of `left` up.
+    void rotate_right(Inner *parent, usize sep, Leaf *left, Leaf *node) noexcept {
+        move_slots(node, 1, node, 0, node->count);
+        place(node, 0, parent->slots + sep);
+        place(parent, sep, left->slots + left->count - 1);
+        if (!node->leaf) {
+            for (usize j = node->count + 1; j > 0; --j) {
+                adopt(node, j, child(node, j - 1));
+            }
+            adopt(node, 0, child(left, left->count));
+        }
+        --left->count;
+        ++node->count;
+        pad(left);
+    }
+
+    /// separator down to the end of `node`, first of `right` up.
+    void rotate_left(Inner *parent, usize sep, Leaf *node, Leaf *right) noexcept {
+        place(node, node->count, parent->slots + sep);
+        place(parent, sep, right->slots);
+        move_slots(right, 0, right, 1, right->count - 1);
+        if (!node->leaf) {
+            adopt(node, node->count + 1, child(right, 0));
+            for (usize j = 0; j < right->count; ++j) {
+                adopt(right, j, child(right, j + 1));
+            }
+        }
+        ++node->count;
+        --right->count;
+        pad(right);
+    }
+
+    /// `left` takes the separator and everything in `right`, which is freed.
+    void merge(Inner *parent, usize sep, Leaf *left, Leaf *right) noexcept {
+        const usize lc = left->count;
+        place(left, lc, parent->slots + sep);
+        move_slots(left, lc + 1, right, 0, right->count);
+        if (!left->leaf) {
+            for (usize j = 0; j <= right->count; ++j) {
+                adopt(left, lc + 1 + j, child(right, j));
+            }
+        }
+        left->count = static_cast<u16>(lc + 1 + right->count);
+
+        move_slots(parent, sep, parent, sep + 1, parent->count - sep - 1);
+        for (usize j = sep + 1; j < parent->count; ++j) {
+            adopt(parent, j, parent->children[j + 1]);
+        }
+        --parent->count;
+        pad(parent);
+
+        if (right == rightmost_) {
+            rightmost_ = left;
+        }
+        free_node(right);
+    }
+
+    // --- slots ---
+
+    /// move `n` elements between nodes (or within one; the ranges may overlap).
+    void move_slots(Leaf *dst, usize di, Leaf *src, usize si, usize n) noexcept {
+        if (n == 0) {
+            return;
+        }
+        if constexpr (Policy::trivially_relocatable) {
+            libcxx::memmove(static_cast<void *>(dst->slots + di),
+                            static_cast<const void *>(src->slots + si),
+                            n * sizeof(slot_type));
+        } else if (dst != src || di < si) {
+            for (usize k = 0; k < n; ++k) {
+                Policy::transfer(alloc_, dst->slots + di + k, src->slots + si + k);
+            }
+        } else {
+            for (usize k = n; k-- > 0;) {
+                Policy::transfer(alloc_, dst->slots + di + k, src->slots + si + k);
+            }
+        }
+        if constexpr (mirror) {
+            libcxx::memmove(dst->mirror.keys + di, src->mirror.keys + si, n * sizeof(key_type));
+        }
+    }
+
+    /// move one element into an empty slot.
+    void place(Leaf *dst, usize i, slot_type *src) noexcept {
+        Policy::transfer(alloc_, dst->slots + i, src);
+        if constexpr (mirror) {
+            dst->mirror.keys[i] = Policy::key(dst->slots + i);
+        }
+    }
+
+    /// refill the key copies past the count with the largest key, which no search counts.
+    static void pad(Leaf *n) noexcept {
+        if constexpr (mirror) {
+            for (usize i = n->count; i < N; ++i) {
+                n->mirror.keys[i] = (libcxx::numeric_limits<key_type>::max)();
+            }
+        }
+    }
+
+    static void adopt(Leaf *parent, usize i, Leaf *c) noexcept {
+        inner(parent)->children[i] = c;
+        c->parent                  = parent;
+        c->position                = static_cast<u16>(i);
+    }
+
+    // --- nodes ---
+
+    Leaf *new_leaf() {
+        leaf_alloc a(alloc_);
+        Leaf      *n = leaf_traits::allocate(a, 1);
+        ::new (static_cast<void *>(n)) Leaf();
+        pad(n);
+        return n;
+    }
+
+    Inner *new_inner() {
+        inner_alloc a(alloc_);
+        Inner      *n = inner_traits::allocate(a, 1);
+        ::new (static_cast<void *>(n)) Inner();
+        n->leaf = false;
+        pad(n);
+        return n;
+    }
+
+    void free_node(Leaf *n) noexcept {
+        if (n->leaf) {
+            leaf_alloc a(alloc_);
+            n->~Leaf();
+            leaf_traits::deallocate(a, n, 1);
+        } else {
+            inner_alloc a(alloc_);
+            inner(n)->~Inner();
+            inner_traits::deallocate(a, inner(n), 1);
+        }
+    }
+
+    void destroy_below(Leaf *n) noexcept {
+        if (!n->leaf) {
+            for (usize i = 0; i <= n->count; ++i) {
+                destroy_below(child(n, i));
+            }
+        }
+        if constexpr (!Policy::trivial_destroy) {
+            for (usize i = 0; i < n->count; ++i) {
+                Policy::destroy(alloc_, n->slots + i);
+            }
+        }
+        free_node(n);
+    }
+
+    static usize bytes_below(const Leaf *n) noexcept {
+        if (n->leaf) {
+            return sizeof(Leaf);
+        }
+        usize out = sizeof(Inner);
+        for (usize i = 0; i <= n->count; ++i) {
+            out += bytes_below(static_cast<const Inner *>(n)->children[i]);
+        }
+        return out;
+    }
+
+    void copy_from(const Tree &other) {
+        for (const auto &v : other) {
+            append(v);
+        }
+    }
+
+    void steal(Tree &other) noexcept {
+        root_      = libcxx::exchange(other.root_, nullptr);
+        leftmost_  = libcxx::exchange(other.leftmost_, nullptr);
+        rightmost_ = libcxx::exchange(other.rightmost_, nullptr);
+        size_      = libcxx::exchange(other.size_, 0);
+    }
+
+    Leaf *root_{nullptr};
+    Leaf *leftmost_{nullptr};
+    Leaf *rightmost_{nullptr};
+    usize size_{0};
+
+    [[no_unique_address]] Compare comp_{};
+    [[no_unique_address]] Alloc   alloc_{};
+};
+}  // namespace __btree
+
+///
+/// \brief Ordered map stored as a B-tree: each node holds up to KAIRO_BTREE_NODE_BYTES of
+///        elements side by side instead of one heap node per element, so it uses a fraction of
+///        std::map's memory and a lookup touches a handful of cache lines. Integral keys under
+///        the default order are searched within a node with SIMD compares.
+///
+/// It has the std::map interface, with one difference: inserting or erasing may move other
+/// elements, which invalidates iterators and references (std::map keeps them). Defining
+/// KAIRO_BTREE_MAP adds a top-level `btree_map` alias next to `map`, which stays std::map.
+///
+/// \code
+///   btree_map<u64, Symbol> table(sorted_unique, sorted.begin(), sorted.end());  // bulk load
+///   for (auto it = table.lower_bound(lo); it != table.end() && it->first < hi; ++it) { ... }
+/// \endcode
+///
+template <typename K, typename V, typename Compare, typename Alloc>
+class btree_map : public __maping::MapApi<
+                      __btree::Tree<__maping::FlatMapPolicy<K, V>, Compare, Alloc>> {
+    using base =
+        __maping::MapApi<__btree::Tree<__maping::FlatMapPolicy<K, V>, Compare, Alloc>>;
+
+  public:
+    using mapped_type = V;
+
+    using base::base;
+    using base::operator=;
+
+    btree_map() = default;
+};
+
+/// \brief Ordered set stored as a B-tree; see btree_map.
+template <typename T, typename Compare, typename Alloc>
+class btree_set
+    : public __maping::SetApi<__btree::Tree<__maping::FlatSetPolicy<T>, Compare, Alloc>> {
+    using base = __maping::SetApi<__btree::Tree<__maping::FlatSetPolicy<T>, Compare, Alloc>>;
+
+  public:
+    using base::base;
+    using base::operator=;
+
+    btree_set() = default;
+};
+
+template <typename K, typename V, typename C, typename A, typename Pred>
+usize erase_if(btree_map<K, V, C, A> &map, Pred pred) {
+    usize out = 0;
+    for (auto it = map.begin(); it != map.end();) {
+        if (pred(*it)) {
+            it = map.erase(it);
+            ++out;
+        } else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+template <typename T, typename C, typename A, typename Pred>
+usize erase_if(btree_set<T, C, A> &set, Pred pred) {
+    usize out = 0;
+    for (auto it = set.begin(); it != set.end();) {
+        if (pred(*it)) {
+            it = set.erase(it);
+            ++out;
+        } else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+namespace Memory {
+/// nodes point at each other, never at the tree object.
+template <typename K, typename V, typename C, typename A>
+struct is_trivially_relocatable<btree_map<K, V, C, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<C> && is_trivially_relocatable_v<A>> {};
+
+template <typename T, typename C, typename A>
+struct is_trivially_relocatable<btree_set<T, C, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<C> && is_trivially_relocatable_v<A>> {};
+}  // namespace Memory
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M5BTREE
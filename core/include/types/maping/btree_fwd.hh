@@ -0,0 +1,38 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M9BTREE_FWD
+#define _$_HX_CORE_M9BTREE_FWD
+
+#include <include/config/config.hh>
+
+#include <functional>
+#include <memory>
+#include <utility>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// see types/maping/btree.hh. declared here so primitives.hh can alias it as `btree_map` when
+/// KAIRO_BTREE_MAP is defined.
+template <typename K,
+          typename V,
+          typename Compare = libcxx::less<K>,
+          typename Alloc   = libcxx::allocator<libcxx::pair<const K, V>>>
+class btree_map;
+
+template <typename T, typename Compare = libcxx::less<T>, typename Alloc = libcxx::allocator<T>>
+class btree_set;
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M9BTREE_FWD
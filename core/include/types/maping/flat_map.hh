@@ -0,0 +1,951 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M8FLAT_MAP
+#define _$_HX_CORE_M8FLAT_MAP
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/runtime/__memory/relocate.hh>
+#include <include/types/maping/key_search.hh>
+#include <include/types/maping/map_api.hh>
+#include <include/types/maping/slot_policy.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace __flat {
+/// random-access iterator over the two columns of a flat_map. like std::flat_map's, it yields
+/// a pair of references rather than a reference to a stored pair.
+template <typename K, typename V, bool Const>
+class MapIterator {
+    template <typename, typename, bool>
+    friend class MapIterator;
+
+    using mapped_ptr = libcxx::conditional_t<Const, const V *, V *>;
+
+  public:
+    using iterator_category = libcxx::input_iterator_tag;
+    using iterator_concept  = libcxx::random_access_iterator_tag;
+    using value_type        = libcxx::pair<K, V>;
+    using difference_type   = libcxx::ptrdiff_t;
+    using reference = libcxx::pair<const K &, libcxx::conditional_t<Const, const V &, V &>>;
+
+    struct pointer {
+        reference        ref;
+        const reference *operator->() const noexcept { return libcxx::addressof(ref); }
+    };
+
+    MapIterator() noexcept = default;
+
+    MapIterator(const K *key, mapped_ptr value) noexcept
+        : key_(key)
+        , value_(value) {}
+
+    template <bool C = Const>
+        requires C
+    MapIterator(const MapIterator<K, V, false> &other) noexcept  // NOLINT
+        : key_(other.key_)
+        , value_(other.value_) {}
+
+    reference operator*() const noexcept { return {*key_, *value_}; }
+    pointer   operator->() const noexcept { return {**this}; }
+    reference operator[](difference_type n) const noexcept { return {key_[n], value_[n]}; }
+
+    MapIterator &operator++() noexcept {
+        ++key_;
+        ++value_;
+        return *this;
+    }
+
+    MapIterator &operator--() noexcept {
+        --key_;
+        --value_;
+        return *this;
+    }
+
+    MapIterator operator++(int) noexcept {
+        MapIterator out = *this;
+        ++*this;
+        return out;
+    }
+
+    MapIterator operator--(int) noexcept {
+        MapIterator out = *this;
+        --*this;
+        return out;
+    }
+
+    MapIterator &operator+=(difference_type n) noexcept {
+        key_ += n;
+        value_ += n;
+        return *this;
+    }
+
+    MapIterator &operator-=(difference_type n) noexcept { return *this += -n; }
+
+    friend MapIterator operator+(MapIterator it, difference_type n) noexcept { return it += n; }
+    friend MapIterator operator+(difference_type n, MapIterator it) noexcept { return it += n; }
+    friend MapIterator operator-(MapIterator it, difference_type n) noexcept { return it -= n; }
+
+    friend difference_type operator-(const MapIterator &a, const MapIterator &b) noexcept {
+        return a.key_ - b.key_;
+    }
+
+    friend bool operator==(const MapIterator &a, const MapIterator &b) noexcept {
+        return a.key_ == b.key_;
+    }
+
+    friend auto operator<=>(const MapIterator &a, const MapIterator &b) noexcept {
+        return a.key_ <=> b.key_;
+    }
+
+    /// position in the columns.
+    const K *key_ptr() const noexcept { return key_; }
+
+  private:
+    const K   *key_{nullptr};
+    mapped_ptr value_{nullptr};
+};
+
+///
+/// \brief The storage and search behind flat_map (V is the mapped type) and flat_set (V is
+///        void): the keys in one sorted array and the mapped values in a parallel array, both
+///        carved out of a single allocation. A lookup reads only the key column.
+///
+/// Short ranges of integral keys are searched with a vector scan (see key_search.hh) and
+/// everything else with a branchless binary search, which narrows integral keys to a short
+/// range before scanning it.
+///
+/// Inserting and erasing shift the columns, so elements must be nothrow move constructible;
+/// in exchange every insert gives the strong guarantee.
+///
+template <typename K, typename V, typename Compare, typename Alloc>
+class Table {
+  public:
+    static constexpr bool is_map = !libcxx::is_void_v<V>;
+
+  private:
+    // sets still name a mapped type so the members below type-check; it is never stored
+    using mapped = libcxx::conditional_t<is_map, V, char>;
+
+    static_assert(libcxx::is_nothrow_move_constructible_v<K> &&
+                      libcxx::is_nothrow_move_constructible_v<mapped>,
+                  "flat containers shift elements; they must be nothrow move constructible");
+
+  public:
+    using key_type        = K;
+    using value_type      = libcxx::conditional_t<is_map, libcxx::pair<K, mapped>, K>;
+    using key_compare     = Compare;
+    using allocator_type  = Alloc;
+    using size_type       = usize;
+    using difference_type = libcxx::ptrdiff_t;
+
+    using iterator =
+        libcxx::conditional_t<is_map, MapIterator<K, mapped, false>, const K *>;
+    using const_iterator =
+        libcxx::conditional_t<is_map, MapIterator<K, mapped, true>, const K *>;
+    using reverse_iterator       = libcxx::reverse_iterator<iterator>;
+    using const_reverse_iterator = libcxx::reverse_iterator<const_iterator>;
+
+    static constexpr bool transparent = requires { typename Compare::is_transparent; };
+
+    template <typename Kx>
+    using key_arg = typename __maping::KeyArg<transparent>::template type<Kx, key_type>;
+
+    Table() noexcept(noexcept(Compare()) && noexcept(Alloc())) = default;
+
+    explicit Table(const Compare &comp, const Alloc &alloc = Alloc())
+        : comp_(comp)
+        , alloc_(alloc) {}
+
+    explicit Table(const Alloc &alloc)
+        : alloc_(alloc) {}
+
+    /// sorts and drops duplicate keys (the first one wins), like inserting one at a time but in
+    /// O(n log n) with one allocation.
+    template <typename InputIt>
+    Table(InputIt        first,
+          InputIt        last,
+          const Compare &comp  = Compare(),
+          const Alloc   &alloc = Alloc())
+        : Table(comp, alloc) {
+        insert(first, last);
+    }
+
+    /// input already sorted and free of duplicates is copied in without comparisons.
+    template <typename InputIt>
+    Table(sorted_unique_t,
+          InputIt        first,
+          InputIt        last,
+          const Compare &comp  = Compare(),
+          const Alloc   &alloc = Alloc())
+        : Table(comp, alloc) {
+        insert(sorted_unique, first, last);
+    }
+
+    Table(libcxx::initializer_list<value_type> init,
+          const Compare                       &comp  = Compare(),
+          const Alloc                         &alloc = Alloc())
+        : Table(init.begin(), init.end(), comp, alloc) {}
+
+    Table(const Table &other)
+        : Table(other, traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    Table(const Table &other, const Alloc &alloc)
+        : comp_(other.comp_)
+        , alloc_(alloc) {
+        copy_from(other);
+    }
+
+    Table(Table &&other) noexcept
+        : comp_(libcxx::move(other.comp_))
+        , alloc_(libcxx::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ~Table() {
+        clear();
+        release();
+    }
+
+    Table &operator=(const Table &other) {
+        if (this != &other) {
+            clear();
+            if constexpr (traits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != other.alloc_) {
+                    release();
+                }
+                alloc_ = other.alloc_;
+            }
+            comp_ = other.comp_;
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    Table &operator=(Table &&other) noexcept(
+        traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        clear();
+        comp_ = libcxx::move(other.comp_);
+
+        if constexpr (traits::propagate_on_container_move_assignment::value ||
+                      traits::is_always_equal::value) {
+            release();
+            if constexpr (traits::propagate_on_container_move_assignment::value) {
+                alloc_ = libcxx::move(other.alloc_);
+            }
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                release();
+                steal(other);
+            } else {
+                insert(sorted_unique,
+                       libcxx::make_move_iterator(other.begin()),
+                       libcxx::make_move_iterator(other.end()));
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // --- iteration ---
+
+    iterator begin() noexcept { return iter_at(0); }
+    iterator end() noexcept { return iter_at(size_); }
+    const_iterator begin() const noexcept { return const_cast<Table *>(this)->begin(); }
+    const_iterator end() const noexcept { return const_cast<Table *>(this)->end(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end()); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    /// the sorted key column.
+    libcxx::span<const K> keys() const noexcept { return {keys_, size_}; }
+
+    /// the mapped values, in key order.
+    libcxx::span<mapped> values() noexcept
+        requires is_map
+    {
+        return {values_, size_};
+    }
+
+    libcxx::span<const mapped> values() const noexcept
+        requires is_map
+    {
+        return {values_, size_};
+    }
+
+    // --- capacity ---
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    usize              size() const noexcept { return size_; }
+    usize              capacity() const noexcept { return cap_; }
+    usize              max_size() const noexcept {
+        return (libcxx::numeric_limits<usize>::max)() /
+               (sizeof(K) + (is_map ? sizeof(mapped) : 0));
+    }
+
+    void reserve(usize count) {
+        if (count > cap_) {
+            reallocate(count);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (size_ == 0) {
+            release();
+        } else if (size_ < cap_) {
+            reallocate(size_);
+        }
+    }
+
+    // --- lookup ---
+
+    template <typename Kx = key_type>
+    iterator find(const key_arg<Kx> &key) {
+        const usize i = lower_index(key);
+        return i < size_ && !comp_(key, keys_[i]) ? iter_at(i) : end();
+    }
+
+    template <typename Kx = key_type>
+    const_iterator find(const key_arg<Kx> &key) const {
+        return const_cast<Table *>(this)->template find<Kx>(key);
+    }
+
+    template <typename Kx = key_type>
+    bool contains(const key_arg<Kx> &key) const {
+        const usize i = lower_index(key);
+        return i < size_ && !comp_(key, keys_[i]);
+    }
+
+    template <typename Kx = key_type>
+    usize count(const key_arg<Kx> &key) const {
+        return contains<Kx>(key) ? 1 : 0;
+    }
+
+    template <typename Kx = key_type>
+    iterator lower_bound(const key_arg<Kx> &key) {
+        return iter_at(lower_index(key));
+    }
+
+    template <typename Kx = key_type>
+    const_iterator lower_bound(const key_arg<Kx> &key) const {
+        return const_cast<Table *>(this)->iter_at(lower_index(key));
+    }
+
+    template <typename Kx = key_type>
+    iterator upper_bound(const key_arg<Kx> &key) {
+        return iter_at(upper_index(key));
+    }
+
+    template <typename Kx = key_type>
+    const_iterator upper_bound(const key_arg<Kx> &key) const {
+        return const_cast<Table *>(this)->iter_at(upper_index(key));
+    }
+
+    template <typename Kx = key_type>
+    libcxx::pair<iterator, iterator> equal_range(const key_arg<Kx> &key) {
+        const usize i = lower_index(key);
+        return {iter_at(i), iter_at(i < size_ && !comp_(key, keys_[i]) ? i + 1 : i)};
+    }
+
+    template <typename Kx = key_type>
+    libcxx::pair<const_iterator, const_iterator> equal_range(const key_arg<Kx> &key) const {
+        auto r = const_cast<Table *>(this)->template equal_range<Kx>(key);
+        return {r.first, r.second};
+    }
+
+    // --- modifiers ---
+
+    template <typename... Args>
+    libcxx::pair<iterator, bool> emplace(Args &&...args) {
+        value_type value(std::Memory::forward<Args>(args)...);
+        const usize i = lower_index(key_of(value));
+        if (i < size_ && !comp_(key_of(value), keys_[i])) {
+            return {iter_at(i), false};
+        }
+        return {insert_at(i, libcxx::move(value)), true};
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator hint, Args &&...args) {
+        value_type  value(std::Memory::forward<Args>(args)...);
+        const usize i = hinted_index(hint, key_of(value));
+        if (i < size_ && !comp_(key_of(value), keys_[i])) {
+            return iter_at(i);
+        }
+        return insert_at(i, libcxx::move(value));
+    }
+
+    /// builds the element from `args` only when `key` is absent.
+    template <typename Kx, typename... Args>
+    libcxx::pair<iterator, bool> emplace_key(const Kx &key, Args &&...args) {
+        const usize i = lower_index(key);
+        if (i < size_ && !comp_(key, keys_[i])) {
+            return {iter_at(i), false};
+        }
+        return {insert_at(i, value_type(std::Memory::forward<Args>(args)...)), true};
+    }
+
+    template <typename Kx, typename... Args>
+    libcxx::pair<iterator, bool> emplace_key_hint(const_iterator hint,
+                                                  const Kx      &key,
+                                                  Args &&...args) {
+        const usize i = hinted_index(hint, key);
+        if (i < size_ && !comp_(key, keys_[i])) {
+            return {iter_at(i), false};
+        }
+        return {insert_at(i, value_type(std::Memory::forward<Args>(args)...)), true};
+    }
+
+    /// sorts the new elements, drops duplicate keys (earlier ones win, including those already
+    /// present), then merges them in with one pass and at most one allocation.
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        libcxx::vector<value_type> fresh(first, last);
+
+        // order positions rather than elements: each swap moves an index, not a value_type
+        libcxx::vector<usize> order(fresh.size());
+        libcxx::iota(order.begin(), order.end(), usize{0});
+        libcxx::stable_sort(order.begin(), order.end(), [&](usize a, usize b) {
+            return comp_(key_of(fresh[a]), key_of(fresh[b]));
+        });
+        auto same = [&](usize a, usize b) { return !comp_(key_of(fresh[a]), key_of(fresh[b])); };
+        order.erase(libcxx::unique(order.begin(), order.end(), same), order.end());
+
+        merge_in(order.size(), [&](usize j) -> value_type & { return fresh[order[j]]; });
+    }
+
+    template <typename InputIt>
+    void insert(sorted_unique_t, InputIt first, InputIt last) {
+        if (size_ != 0) {
+            libcxx::vector<value_type> fresh(first, last);
+            merge_in(fresh.size(), [&](usize j) -> value_type & { return fresh[j]; });
+            return;
+        }
+        // the common case, a bulk load: no comparisons at all
+        if constexpr (libcxx::forward_iterator<InputIt>) {
+            reserve(static_cast<usize>(libcxx::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            insert_at(size_, value_type(*first));
+        }
+    }
+
+    iterator erase(const_iterator pos) noexcept { return erase(pos, libcxx::next(pos)); }
+
+    iterator erase(iterator pos) noexcept
+        requires is_map
+    {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        const usize i = index_of(first);
+        const usize n = index_of(last) - i;
+        if (n == 0) {
+            return iter_at(i);
+        }
+        destroy(keys_ + i, n);
+        shift(keys_ + i, keys_ + i + n, size_ - i - n);
+        if constexpr (is_map) {
+            destroy(values_ + i, n);
+            shift(values_ + i, values_ + i + n, size_ - i - n);
+        }
+        size_ -= n;
+        return iter_at(i);
+    }
+
+    template <typename Kx = key_type>
+    usize erase(const key_arg<Kx> &key) {
+        const usize i = lower_index(key);
+        if (i == size_ || comp_(key, keys_[i])) {
+            return 0;
+        }
+        erase(const_iterator(iter_at(i)));
+        return 1;
+    }
+
+    /// destroys the elements and keeps the block.
+    void clear() noexcept {
+        destroy(keys_, size_);
+        if constexpr (is_map) {
+            destroy(values_, size_);
+        }
+        size_ = 0;
+    }
+
+    void swap(Table &other) noexcept {
+        using libcxx::swap;
+        swap(keys_, other.keys_);
+        swap(values_, other.values_);
+        swap(size_, other.size_);
+        swap(cap_, other.cap_);
+        swap(comp_, other.comp_);
+        if constexpr (traits::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
+    }
+
+    friend void swap(Table &a, Table &b) noexcept { a.swap(b); }
+
+    key_compare    key_comp() const { return comp_; }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    friend bool operator==(const Table &a, const Table &b) {
+        return a.size() == b.size() && libcxx::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend auto operator<=>(const Table &a, const Table &b)
+        requires libcxx::three_way_comparable<value_type>
+    {
+        return libcxx::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+  private:
+    using traits = libcxx::allocator_traits<Alloc>;
+
+    static constexpr usize align = alignof(K) > alignof(mapped) ? alignof(K) : alignof(mapped);
+
+    struct alignas(align) Unit {
+        unsigned char bytes[align];
+    };
+    using unit_alloc  = typename traits::template rebind_alloc<Unit>;
+    using unit_traits = libcxx::allocator_traits<unit_alloc>;
+
+    /// integral keys: binary search down to one cache line of keys, then scan it. wider scans
+    /// measured slower from 8 keys up; narrower ones add unpredictable steps.
+    static constexpr usize linear = 64 / sizeof(K);
+
+    static const K &key_of(const value_type &v) noexcept {
+        if constexpr (is_map) {
+            return v.first;
+        } else {
+            return v;
+        }
+    }
+
+    iterator iter_at(usize i) noexcept {
+        if constexpr (is_map) {
+            return iterator(keys_ + i, values_ + i);
+        } else {
+            return keys_ + i;
+        }
+    }
+
+    usize index_of(const_iterator it) const noexcept {
+        if constexpr (is_map) {
+            return static_cast<usize>(it.key_ptr() - keys_);
+        } else {
+            return static_cast<usize>(it - keys_);
+        }
+    }
+
+    template <typename Kx>
+    usize lower_index(const Kx &key) const {
+        if constexpr (__maping::simd_keys<K, Compare> && libcxx::is_same_v<Kx, K>) {
+            const K *base = keys_;
+            usize    n    = size_;
+            while (n > linear) {
+                const usize half = n / 2;
+                base             = base[half] < key ? base + half : base;
+                n -= half;
+            }
+            return static_cast<usize>(base - keys_) + __maping::count_keys<true>(base, n, key);
+        } else {
+            return __maping::partition_point(
+                keys_, size_, [&](const K &x) { return comp_(x, key); });
+        }
+    }
+
+    template <typename Kx>
+    usize upper_index(const Kx &key) const {
+        if constexpr (__maping::simd_keys<K, Compare> && libcxx::is_same_v<Kx, K>) {
+            const K *base = keys_;
+            usize    n    = size_;
+            while (n > linear) {
+                const usize half = n / 2;
+                base             = key < base[half] ? base : base + half;
+                n -= half;
+            }
+            return static_cast<usize>(base - keys_) + __maping::count_keys<false>(base, n, key);
+        } else {
+            return __maping::partition_point(
+                keys_, size_, [&](const K &x) { return !comp_(key, x); });
+        }
+    }
+
+    /// where `key` goes: the hint's index when it falls between its neighbours, else a search.
+    template <typename Kx>
+    usize hinted_index(const_iterator hint, const Kx &key) const {
+        const usize i = index_of(hint);
+        if ((i == 0 || comp_(keys_[i - 1], key)) && (i == size_ || !comp_(keys_[i], key))) {
+            return i;
+        }
+        return lower_index(key);
+    }
+
+    /// move `value` in at index `i`. moves cannot throw, so once `value` exists nothing can
+    /// fail but the allocation, which happens before anything is touched.
+    iterator insert_at(usize i, value_type &&value) {
+        if (size_ == cap_) {
+            grow_with_gap(i);
+        } else {
+            shift(keys_ + i + 1, keys_ + i, size_ - i);
+            if constexpr (is_map) {
+                shift(values_ + i + 1, values_ + i, size_ - i);
+            }
+        }
+
+        emplace_raw(keys_, values_, i, libcxx::move(value));
+        ++size_;
+        return iter_at(i);
+    }
+
+    /// move in the `n` sorted, unique elements `fresh(0) .. fresh(n - 1)`; keys already present
+    /// keep their value. merges backward in place when they fit, else forward into one new
+    /// block.
+    template <typename At>
+    void merge_in(usize n, At fresh) {
+        if (size_ == 0) {
+            reserve(n);
+            for (usize j = 0; j < n; ++j) {
+                emplace_raw(keys_, values_, size_++, libcxx::move(fresh(j)));
+            }
+            return;
+        }
+
+        usize added = 0;
+        for (usize i = 0, j = 0; j < n; ++j) {
+            const K &k = key_of(fresh(j));
+            for (; i < size_ && comp_(keys_[i], k); ++i) {}
+            added += static_cast<usize>(i == size_ || comp_(k, keys_[i]));
+        }
+        if (added == 0) {
+            return;
+        }
+
+        if (size_ + added > cap_) {
+            Block block = allocate(next_capacity(size_ + added));
+            usize out   = 0;
+            usize i     = 0;
+            for (usize j = 0; j < n; ++j) {
+                value_type &v = fresh(j);
+                for (; i < size_ && comp_(keys_[i], key_of(v)); ++i, ++out) {
+                    shift_one(block.keys, block.values, out, i);
+                }
+                if (i == size_ || comp_(key_of(v), keys_[i])) {
+                    emplace_raw(block.keys, block.values, out, libcxx::move(v));
+                    ++out;
+                }
+            }
+            for (; i < size_; ++i, ++out) {
+                shift_one(block.keys, block.values, out, i);
+            }
+
+            deallocate(keys_, cap_);
+            keys_   = block.keys;
+            values_ = block.values;
+            cap_    = block.cap;
+            size_   = out;
+            return;
+        }
+
+        // [i, out) is the unconstructed gap, which closes exactly when the last new key lands
+        usize out = size_ + added;
+        usize i   = size_;
+        for (usize j = n; j-- > 0 && out != i;) {
+            const K &k = key_of(fresh(j));
+            for (; i > 0 && comp_(k, keys_[i - 1]); --i) {
+                --out;
+                shift_one(keys_, values_, out, i - 1);
+            }
+            if (i == 0 || comp_(keys_[i - 1], k)) {
+                --out;
+                emplace_raw(keys_, values_, out, libcxx::move(fresh(j)));
+            }
+        }
+        size_ += added;
+    }
+
+    // --- storage ---
+
+    struct Block {
+        K      *keys;
+        mapped *values;
+        usize   cap;
+    };
+
+    /// the value column starts after the key column, rounded up to its alignment.
+    static usize values_offset(usize cap) noexcept {
+        const usize bytes = cap * sizeof(K);
+        return (bytes + alignof(mapped) - 1) / alignof(mapped) * alignof(mapped);
+    }
+
+    static usize units_for(usize cap) noexcept {
+        const usize bytes = is_map ? values_offset(cap) + cap * sizeof(mapped) : cap * sizeof(K);
+        return (bytes + sizeof(Unit) - 1) / sizeof(Unit);
+    }
+
+    Block allocate(usize cap) {
+        if (cap > max_size()) {
+            throw libcxx::length_error("flat container: capacity overflow");
+        }
+        unit_alloc a(alloc_);
+        auto *raw = reinterpret_cast<unsigned char *>(unit_traits::allocate(a, units_for(cap)));
+        return {reinterpret_cast<K *>(raw),
+                is_map ? reinterpret_cast<mapped *>(raw + values_offset(cap)) : nullptr,
+                cap};
+    }
+
+    void deallocate(K *keys, usize cap) noexcept {
+        if (keys != nullptr) {
+            unit_alloc a(alloc_);
+            unit_traits::deallocate(a, reinterpret_cast<Unit *>(keys), units_for(cap));
+        }
+    }
+
+    void release() noexcept {
+        deallocate(keys_, cap_);
+        keys_   = nullptr;
+        values_ = nullptr;
+        cap_    = 0;
+    }
+
+    usize next_capacity(usize need) const noexcept {
+        const usize grown = cap_ * 2 > 4 ? cap_ * 2 : 4;
+        return grown > need ? grown : need;
+    }
+
+    void reallocate(usize cap) {
+        Block fresh = allocate(cap);
+        Memory::relocate(fresh.keys, keys_, size_);
+        if constexpr (is_map) {
+            Memory::relocate(fresh.values, values_, size_);
+        }
+        deallocate(keys_, cap_);
+        keys_   = fresh.keys;
+        values_ = fresh.values;
+        cap_    = fresh.cap;
+    }
+
+    /// grow, leaving index `i` unconstructed in the new block.
+    void grow_with_gap(usize i) {
+        Block fresh = allocate(next_capacity(size_ + 1));
+        Memory::relocate(fresh.keys, keys_, i);
+        Memory::relocate(fresh.keys + i + 1, keys_ + i, size_ - i);
+        if constexpr (is_map) {
+            Memory::relocate(fresh.values, values_, i);
+            Memory::relocate(fresh.values + i + 1, values_ + i, size_ - i);
+        }
+        deallocate(keys_, cap_);
+        keys_   = fresh.keys;
+        values_ = fresh.values;
+        cap_    = fresh.cap;
+    }
+
+    /// relocate element `i` to index `at` of the given columns, in this block or a new one.
+    void shift_one(K *keys, mapped *values, usize at, usize i) noexcept {
+        shift(keys + at, keys_ + i, 1);
+        if constexpr (is_map) {
+            shift(values + at, values_ + i, 1);
+        }
+    }
+
+    /// move `v` into the unconstructed index `at` of the given columns.
+    static void emplace_raw(K *keys, mapped *values, usize at, value_type &&v) noexcept {
+        if constexpr (is_map) {
+            ::new (static_cast<void *>(keys + at)) K(libcxx::move(v.first));
+            ::new (static_cast<void *>(values + at)) V(libcxx::move(v.second));
+        } else {
+            ::new (static_cast<void *>(keys + at)) K(libcxx::move(v));
+        }
+    }
+
+    /// relocate `n` elements from `src` to `dst` within a column; the ranges may overlap.
+    template <typename T>
+    static void shift(T *dst, T *src, usize n) noexcept {
+        if (n == 0 || dst == src) {
+            return;
+        }
+        if constexpr (Memory::is_trivially_relocatable_v<T>) {
+            libcxx::memmove(static_cast<void *>(dst), static_cast<const void *>(src),
+                            n * sizeof(T));
+        } else if (dst < src) {
+            for (usize j = 0; j < n; ++j) {
+                ::new (static_cast<void *>(dst + j)) T(libcxx::move(src[j]));
+                src[j].~T();
+            }
+        } else {
+            for (usize j = n; j-- > 0;) {
+                ::new (static_cast<void *>(dst + j)) T(libcxx::move(src[j]));
+                src[j].~T();
+            }
+        }
+    }
+
+    template <typename T>
+    static void destroy(T *first, usize n) noexcept {
+        if constexpr (!libcxx::is_trivially_destructible_v<T>) {
+            for (usize j = 0; j < n; ++j) {
+                first[j].~T();
+            }
+        }
+    }
+
+    void copy_from(const Table &other) {
+        if (other.size_ == 0) {
+            return;
+        }
+        reserve(other.size_);
+        usize done = 0;
+        try {
+            for (; done < other.size_; ++done) {
+                ::new (static_cast<void *>(keys_ + done)) K(other.keys_[done]);
+                if constexpr (is_map) {
+                    try {
+                        ::new (static_cast<void *>(values_ + done)) V(other.values_[done]);
+                    } catch (...) {
+                        keys_[done].~K();
+                        throw;
+                    }
+                }
+            }
+        } catch (...) {
+            size_ = done;
+            clear();
+            throw;
+        }
+        size_ = other.size_;
+    }
+
+    void steal(Table &other) noexcept {
+        keys_   = libcxx::exchange(other.keys_, nullptr);
+        values_ = libcxx::exchange(other.values_, nullptr);
+        size_   = libcxx::exchange(other.size_, 0);
+        cap_    = libcxx::exchange(other.cap_, 0);
+    }
+
+    K      *keys_{nullptr};
+    mapped *values_{nullptr};
+    usize   size_{0};
+    usize   cap_{0};
+
+    [[no_unique_address]] Compare comp_{};
+    [[no_unique_address]] Alloc   alloc_{};
+};
+}  // namespace __flat
+
+///
+/// \brief Sorted-array map for small, read-mostly tables: keys in one sorted array, values in a
+///        parallel one, both in a single allocation. Lookups touch only the key array, search it
+///        without branches (with SIMD compares for integral keys), and iteration is a linear
+///        walk; inserting or erasing in the middle shifts the elements after it.
+///
+/// It has the std::map lookup and insert interface. As with std::flat_map, iterators yield a
+/// pair of references and are invalidated by any insert or erase. Build it in one go when you
+/// can; the range constructor sorts once instead of shifting per element:
+/// \code
+///   flat_map<cstring, cstring, libcxx::less<>> env(pairs.begin(), pairs.end());
+///   if (env.contains(libcxx::string_view(name, len))) { ... }  // no string built
+/// \endcode
+///
+template <typename K,
+          typename V,
+          typename Compare = libcxx::less<K>,
+          typename Alloc   = libcxx::allocator<libcxx::pair<K, V>>>
+class flat_map : public __maping::MapApi<__flat::Table<K, V, Compare, Alloc>> {
+    using base = __maping::MapApi<__flat::Table<K, V, Compare, Alloc>>;
+
+  public:
+    using base::base;
+    using base::operator=;
+
+    flat_map() = default;
+};
+
+/// \brief Sorted-array set; see flat_map.
+template <typename T, typename Compare = libcxx::less<T>, typename Alloc = libcxx::allocator<T>>
+class flat_set : public __maping::SetApi<__flat::Table<T, void, Compare, Alloc>> {
+    using base = __maping::SetApi<__flat::Table<T, void, Compare, Alloc>>;
+
+  public:
+    using base::base;
+    using base::operator=;
+
+    flat_set() = default;
+};
+
+/// removes matching elements in one pass, shifting the rest down once.
+template <typename K, typename V, typename C, typename A, typename Pred>
+usize erase_if(flat_map<K, V, C, A> &map, Pred pred) {
+    auto  keys   = map.keys();
+    auto  values = map.values();
+    usize out    = 0;
+    for (usize i = 0; i < keys.size(); ++i) {
+        if (!pred(libcxx::pair<const K &, V &>(keys[i], values[i]))) {
+            if (out != i) {
+                const_cast<K &>(keys[out]) = libcxx::move(const_cast<K &>(keys[i]));
+                values[out]                = libcxx::move(values[i]);
+            }
+            ++out;
+        }
+    }
+    const usize removed = keys.size() - out;
+    map.erase(map.begin() + static_cast<libcxx::ptrdiff_t>(out), map.end());
+    return removed;
+}
+
+template <typename T, typename C, typename A, typename Pred>
+usize erase_if(flat_set<T, C, A> &set, Pred pred) {
+    auto  keys = set.keys();
+    usize out  = 0;
+    for (usize i = 0; i < keys.size(); ++i) {
+        if (!pred(keys[i])) {
+            if (out != i) {
+                const_cast<T &>(keys[out]) = libcxx::move(const_cast<T &>(keys[i]));
+            }
+            ++out;
+        }
+    }
+    const usize removed = keys.size() - out;
+    set.erase(set.begin() + static_cast<libcxx::ptrdiff_t>(out), set.end());
+    return removed;
+}
+
+namespace Memory {
+/// one block, owned through plain pointers.
+template <typename K, typename V, typename C, typename A>
+struct is_trivially_relocatable<flat_map<K, V, C, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<C> && is_trivially_relocatable_v<A>> {};
+
+template <typename T, typename C, typename A>
+struct is_trivially_relocatable<flat_set<T, C, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<C> && is_trivially_relocatable_v<A>> {};
+}  // namespace Memory
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M8FLAT_MAP
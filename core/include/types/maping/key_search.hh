@@ -0,0 +1,107 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M10KEY_SEARCH
+#define _$_HX_CORE_M10KEY_SEARCH
+
+#include <include/config/config.hh>
+
+#include <bit>
+
+#include <include/c++/libc++.hh>
+#include <include/types/builtins/builtins.hh>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define _KAIRO_KEYS_SSE2 1
+#   include <emmintrin.h>
+#   if defined(__SSE4_2__)
+#       include <nmmintrin.h>
+#   endif
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace __maping {
+/// keys a sorted container can search with vector compares: 32- and 64-bit integers under
+/// their natural order.
+template <typename K, typename Compare>
+inline constexpr bool simd_keys =
+    libcxx::is_integral_v<K> && !libcxx::is_same_v<K, bool> && (sizeof(K) == 4 || sizeof(K) == 8) &&
+    (libcxx::is_same_v<Compare, libcxx::less<K>> || libcxx::is_same_v<Compare, libcxx::less<>>);
+
+/// how many of the sorted `keys[0, n)` are below `k` (Strict) or not above it, which is the
+/// lower (upper) bound. a linear scan with no data-dependent branches: on short arrays it beats
+/// a binary search, whose every step is a mispredicted branch or a dependent load.
+template <bool Strict, typename K>
+inline usize count_keys(const K *keys, usize n, K k) noexcept {
+    usize out = 0;
+    usize i   = 0;
+#if defined(_KAIRO_KEYS_SSE2)
+    if constexpr (sizeof(K) == 4) {
+        // signed compares; unsigned keys are shifted into signed range first
+        const __m128i bias   = _mm_set1_epi32(libcxx::is_signed_v<K> ? 0 : INT32_MIN);
+        const __m128i needle = _mm_xor_si128(_mm_set1_epi32(static_cast<i32>(k)), bias);
+        for (; i + 4 <= n; i += 4) {
+            const __m128i v =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), bias);
+            const __m128i hit = Strict ? _mm_cmplt_epi32(v, needle) : _mm_cmpgt_epi32(v, needle);
+            out += static_cast<usize>(
+                libcxx::popcount(static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(hit)))));
+        }
+        if constexpr (!Strict) {
+            out = i - out;  // counted the keys above k
+        }
+    }
+#   if defined(__SSE4_2__)
+    if constexpr (sizeof(K) == 8) {
+        const __m128i bias   = _mm_set1_epi64x(libcxx::is_signed_v<K> ? 0 : INT64_MIN);
+        const __m128i needle = _mm_xor_si128(_mm_set1_epi64x(static_cast<i64>(k)), bias);
+        for (; i + 2 <= n; i += 2) {
+            const __m128i v =
+                _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i)), bias);
+            const __m128i hit = Strict ? _mm_cmpgt_epi64(needle, v) : _mm_cmpgt_epi64(v, needle);
+            out += static_cast<usize>(
+                libcxx::popcount(static_cast<u32>(_mm_movemask_pd(_mm_castsi128_pd(hit)))));
+        }
+        if constexpr (!Strict) {
+            out = i - out;
+        }
+    }
+#   endif
+#endif
+    for (; i < n; ++i) {
+        out += static_cast<usize>(Strict ? keys[i] < k : !(k < keys[i]));
+    }
+    return out;
+}
+
+/// binary search whose halving step compiles to a conditional move rather than a branch, so
+/// the loop runs exactly log2(n) times whatever the keys. `before(x)` says whether x is ordered
+/// before the bound; the result is the number of leading keys for which it holds.
+template <typename K, typename Before>
+inline usize partition_point(const K *keys, usize n, Before before) {
+    const K *base = keys;
+    while (n > 1) {
+        const usize half = n / 2;
+        base             = before(base[half]) ? base + half : base;
+        n -= half;
+    }
+    return static_cast<usize>(base - keys) + static_cast<usize>(n == 1 && before(*base));
+}
+}  // namespace __maping
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#undef _KAIRO_KEYS_SSE2
+
+#endif  // _$_HX_CORE_M10KEY_SEARCH
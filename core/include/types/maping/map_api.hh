@@ -0,0 +1,224 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M7MAP_API
+#define _$_HX_CORE_M7MAP_API
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// tag for constructors and inserts whose input is already sorted by the container's order and
+/// free of duplicates; the container trusts it and skips the comparisons.
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+namespace __maping {
+///
+/// the key/value half of the std::map interface (at, operator[], try_emplace, ...) on top of any
+/// table that provides:
+///
+///   key_type, value_type, iterator, const_iterator, key_arg<K>, transparent
+///   find<K>(key), clear(), insert(first, last), emplace(args...)
+///   emplace_key(key, args...)              -> pair<iterator, bool>
+///   emplace_key_hint(hint, key, args...)   -> pair<iterator, bool>
+///
+/// emplace_key builds the element from `args` only when `key` is absent.
+///
+template <typename Table>
+class MapApi : public Table {
+    /// an iterator in the key position is a hint: those calls go to the hinted overloads.
+    template <typename K>
+    static constexpr bool is_hint =
+        libcxx::is_convertible_v<K &&, typename Table::const_iterator> ||
+        libcxx::is_convertible_v<K &&, typename Table::iterator>;
+
+  public:
+    using typename Table::const_iterator;
+    using typename Table::iterator;
+    using typename Table::key_type;
+    using typename Table::value_type;
+    using mapped_type = typename value_type::second_type;
+
+    template <typename K>
+    using key_arg = typename Table::template key_arg<K>;
+
+    using Table::Table;
+    using Table::emplace;
+    using Table::erase;
+    using Table::insert;
+
+    MapApi &operator=(libcxx::initializer_list<value_type> init) {
+        this->clear();
+        insert(init.begin(), init.end());
+        return *this;
+    }
+
+    // --- element access ---
+
+    template <typename K = key_type>
+    mapped_type &at(const key_arg<K> &key) {
+        auto it = this->template find<K>(key);
+        if (it == this->end()) {
+            throw libcxx::out_of_range("map::at: key not found");
+        }
+        return it->second;
+    }
+
+    template <typename K = key_type>
+    const mapped_type &at(const key_arg<K> &key) const {
+        return const_cast<MapApi *>(this)->template at<K>(key);
+    }
+
+    mapped_type &operator[](const key_type &key) { return try_emplace(key).first->second; }
+    mapped_type &operator[](key_type &&key) {
+        return try_emplace(libcxx::move(key)).first->second;
+    }
+
+    /// heterogeneous operator[]: only builds a key_type when the key is new.
+    template <typename K>
+        requires(Table::transparent && !libcxx::is_same_v<libcxx::remove_cvref_t<K>, key_type>)
+    mapped_type &operator[](K &&key) {
+        return try_emplace(std::Memory::forward<K>(key)).first->second;
+    }
+
+    // --- modifiers ---
+
+    libcxx::pair<iterator, bool> insert(const value_type &value) {
+        return this->emplace_key(value.first, value);
+    }
+
+    libcxx::pair<iterator, bool> insert(value_type &&value) {
+        return this->emplace_key(value.first, libcxx::move(value));
+    }
+
+    template <typename P>
+        requires libcxx::is_constructible_v<value_type, P &&>
+    libcxx::pair<iterator, bool> insert(P &&value) {
+        return emplace(std::Memory::forward<P>(value));
+    }
+
+    iterator insert(const_iterator hint, const value_type &value) {
+        return this->emplace_key_hint(hint, value.first, value).first;
+    }
+
+    iterator insert(const_iterator hint, value_type &&value) {
+        return this->emplace_key_hint(hint, value.first, libcxx::move(value)).first;
+    }
+
+    void insert(libcxx::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+
+    /// construct the mapped value from `args` only if `key` is absent; otherwise nothing is
+    /// moved from.
+    template <typename K = key_type, typename... Args>
+        requires(!is_hint<K>)
+    libcxx::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+        return this->emplace_key(key,
+                                 libcxx::piecewise_construct,
+                                 libcxx::forward_as_tuple(std::Memory::forward<K>(key)),
+                                 libcxx::forward_as_tuple(std::Memory::forward<Args>(args)...));
+    }
+
+    template <typename K = key_type, typename... Args>
+    iterator try_emplace(const_iterator hint, K &&key, Args &&...args) {
+        return this
+            ->emplace_key_hint(hint,
+                               key,
+                               libcxx::piecewise_construct,
+                               libcxx::forward_as_tuple(std::Memory::forward<K>(key)),
+                               libcxx::forward_as_tuple(std::Memory::forward<Args>(args)...))
+            .first;
+    }
+
+    template <typename K = key_type, typename M>
+        requires(!is_hint<K>)
+    libcxx::pair<iterator, bool> insert_or_assign(K &&key, M &&value) {
+        auto res = try_emplace(std::Memory::forward<K>(key), std::Memory::forward<M>(value));
+        if (!res.second) {
+            res.first->second = std::Memory::forward<M>(value);
+        }
+        return res;
+    }
+
+    template <typename K = key_type, typename M>
+    iterator insert_or_assign(const_iterator hint, K &&key, M &&value) {
+        auto res = this->emplace_key_hint(
+            hint,
+            key,
+            libcxx::piecewise_construct,
+            libcxx::forward_as_tuple(std::Memory::forward<K>(key)),
+            libcxx::forward_as_tuple(std::Memory::forward<M>(value)));
+        if (!res.second) {
+            res.first->second = std::Memory::forward<M>(value);
+        }
+        return res.first;
+    }
+};
+
+/// the set half: insert by value, with the element itself as the key.
+template <typename Table>
+class SetApi : public Table {
+  public:
+    using typename Table::const_iterator;
+    using typename Table::iterator;
+    using typename Table::key_type;
+    using typename Table::value_type;
+
+    using Table::Table;
+    using Table::emplace;
+    using Table::erase;
+    using Table::insert;
+
+    SetApi &operator=(libcxx::initializer_list<value_type> init) {
+        this->clear();
+        insert(init.begin(), init.end());
+        return *this;
+    }
+
+    libcxx::pair<iterator, bool> insert(const value_type &value) {
+        return this->emplace_key(value, value);
+    }
+
+    libcxx::pair<iterator, bool> insert(value_type &&value) {
+        return this->emplace_key(value, libcxx::move(value));
+    }
+
+    /// heterogeneous insert: builds a value_type only when `value` is new.
+    template <typename K>
+        requires(Table::transparent && !libcxx::is_same_v<libcxx::remove_cvref_t<K>, value_type> &&
+                 libcxx::is_constructible_v<value_type, K &&>)
+    libcxx::pair<iterator, bool> insert(K &&value) {
+        return this->emplace_key(value, std::Memory::forward<K>(value));
+    }
+
+    iterator insert(const_iterator hint, const value_type &value) {
+        return this->emplace_key_hint(hint, value, value).first;
+    }
+
+    iterator insert(const_iterator hint, value_type &&value) {
+        return this->emplace_key_hint(hint, value, libcxx::move(value)).first;
+    }
+
+    void insert(libcxx::initializer_list<value_type> init) { insert(init.begin(), init.end()); }
+};
+}  // namespace __maping
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M7MAP_API
@@ -14,8 +14,116 @@
 
 #include <include/config/config.hh>
 
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/types/maping/btree.hh>
+#include <include/types/maping/flat_map.hh>
+#include <include/types/maping/map_api.hh>
+#include <include/types/maping/swiss_table.hh>
+
 H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+///
+/// \brief Open-addressing hash map (a "Swiss table"). Elements live inline in one flat slot
+///        array; a lookup hashes once, compares the hash's low 7 bits against 16 control bytes
+///        at a time (SSE2 on x86-64) and compares keys only on a byte match, so a miss usually
+///        costs one cache line of control bytes and no key comparisons.
+///
+/// It has the std::unordered_map interface except that rehashing moves elements: pointers and
+/// references to elements are invalidated by any insert that grows the table. Use
+/// node_hash_map when they must stay put.
+///
+/// String keys get StringHash / StringEq by default, which are transparent, as is any pair of
+/// hasher and equality that both declare is_transparent:
+/// \code
+///   hash_map<string, i32> ids;
+///   ids.reserve(names.size());
+///   ids.try_emplace(L"main", 0);
+///   if (auto it = ids.find(token.slice()); it != ids.end()) { ... }  // no string built
+/// \endcode
+///
+template <typename K,
+          typename V,
+          typename Hash  = typename __swiss::hash_eq<K>::hash,
+          typename Eq    = typename __swiss::hash_eq<K>::eq,
+          typename Alloc = libcxx::allocator<libcxx::pair<const K, V>>>
+class hash_map : public __maping::MapApi<
+                     __swiss::RawTable<__maping::FlatMapPolicy<K, V>, Hash, Eq, Alloc>> {
+    using base =
+        __maping::MapApi<__swiss::RawTable<__maping::FlatMapPolicy<K, V>, Hash, Eq, Alloc>>;
+
+  public:
+    using base::base;
+    using base::operator=;
+
+    hash_map() = default;
+};
+
+///
+/// \brief hash_map whose elements are allocated one by one, so pointers and references to
+///        them stay valid until the element is erased. Lookups work the same way; the slot
+///        array holds pointers.
+///
+template <typename K,
+          typename V,
+          typename Hash  = typename __swiss::hash_eq<K>::hash,
+          typename Eq    = typename __swiss::hash_eq<K>::eq,
+          typename Alloc = libcxx::allocator<libcxx::pair<const K, V>>>
+class node_hash_map : public __maping::MapApi<
+                          __swiss::RawTable<__maping::NodeMapPolicy<K, V>, Hash, Eq, Alloc>> {
+    using base =
+        __maping::MapApi<__swiss::RawTable<__maping::NodeMapPolicy<K, V>, Hash, Eq, Alloc>>;
+
+  public:
+    using base::base;
+    using base::operator=;
+
+    node_hash_map() = default;
+};
+
+template <typename K, typename V, typename H, typename E, typename A, typename Pred>
+usize erase_if(hash_map<K, V, H, E, A> &map, Pred pred) {
+    usize out = 0;
+    for (auto it = map.begin(); it != map.end();) {
+        if (pred(*it)) {
+            it = map.erase(it);
+            ++out;
+        } else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+template <typename K, typename V, typename H, typename E, typename A, typename Pred>
+usize erase_if(node_hash_map<K, V, H, E, A> &map, Pred pred) {
+    usize out = 0;
+    for (auto it = map.begin(); it != map.end();) {
+        if (pred(*it)) {
+            it = map.erase(it);
+            ++out;
+        } else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+namespace Memory {
+/// the table owns its storage through plain pointers; nothing points back into the object.
+template <typename K, typename V, typename H, typename E, typename A>
+struct is_trivially_relocatable<hash_map<K, V, H, E, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<H> && is_trivially_relocatable_v<E> &&
+                            is_trivially_relocatable_v<A>> {};
+
+template <typename K, typename V, typename H, typename E, typename A>
+struct is_trivially_relocatable<node_hash_map<K, V, H, E, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<H> && is_trivially_relocatable_v<E> &&
+                            is_trivially_relocatable_v<A>> {};
+}  // namespace Memory
 
+H_STD_NAMESPACE_END
 H_NAMESPACE_END
 
 #endif  // _$_HX_CORE_M6MAPING
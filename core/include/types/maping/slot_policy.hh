@@ -0,0 +1,181 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M11SLOT_POLICY
+#define _$_HX_CORE_M11SLOT_POLICY
+
+#include <include/config/config.hh>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/runtime/__memory/relocate.hh>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+///
+/// how the containers in types/maping keep an element in a slot. a policy provides key_type,
+/// value_type, slot_type, element(slot), key(slot), construct(alloc, slot, args...),
+/// destroy(alloc, slot) and transfer(alloc, dst, src) (move into an empty slot, leaving src
+/// empty), plus `trivial_destroy` and `trivially_relocatable`, which let a table skip destructor
+/// loops and move slots with memcpy.
+///
+namespace __maping {
+/// the parameter type of a lookup: the caller's own type when the table is transparent, else
+/// key_type. an alias that names K directly keeps K deducible.
+template <bool Transparent>
+struct KeyArg {
+    template <typename K, typename Key>
+    using type = Key;
+};
+
+template <>
+struct KeyArg<true> {
+    template <typename K, typename Key>
+    using type = K;
+};
+
+/// elements stored inline in the slot array. the slot is a union so that a rehash or a node split
+/// can move the key out of a pair<const K, V> (the same layout, viewed as pair<K, V>).
+template <typename K, typename V>
+struct FlatMapPolicy {
+    using key_type   = K;
+    using value_type = libcxx::pair<const K, V>;
+
+    union slot_type {
+        slot_type() {}
+        ~slot_type() {}
+
+        value_type           value;
+        libcxx::pair<K, V>   mutable_value;
+    };
+
+    static constexpr bool trivial_destroy = libcxx::is_trivially_destructible_v<value_type>;
+    static constexpr bool trivially_relocatable =
+        Memory::is_trivially_relocatable_v<libcxx::pair<K, V>>;
+
+    static value_type       &element(slot_type *s) noexcept { return s->value; }
+    static const value_type &element(const slot_type *s) noexcept { return s->value; }
+    static const K    &key(const slot_type *s) noexcept { return s->value.first; }
+
+    template <typename A, typename... Args>
+    static void construct(A &alloc, slot_type *s, Args &&...args) {
+        libcxx::allocator_traits<A>::construct(alloc, libcxx::addressof(s->value),
+                                               std::Memory::forward<Args>(args)...);
+    }
+
+    template <typename A>
+    static void destroy(A &alloc, slot_type *s) noexcept {
+        libcxx::allocator_traits<A>::destroy(alloc, libcxx::addressof(s->value));
+    }
+
+    template <typename A>
+    static void transfer(A &alloc, slot_type *dst, slot_type *src) {
+        if constexpr (trivially_relocatable) {
+            libcxx::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                           sizeof(slot_type));
+        } else {
+            libcxx::allocator_traits<A>::construct(
+                alloc, libcxx::addressof(dst->mutable_value),
+                libcxx::move(*libcxx::launder(libcxx::addressof(src->mutable_value))));
+            destroy(alloc, src);
+        }
+    }
+};
+
+/// elements in their own allocation; the slot holds a pointer, so rehashing never moves an
+/// element and references stay valid until it is erased.
+template <typename K, typename V>
+struct NodeMapPolicy {
+    using key_type   = K;
+    using value_type = libcxx::pair<const K, V>;
+    using slot_type  = value_type *;
+
+    static constexpr bool trivial_destroy       = false;
+    static constexpr bool trivially_relocatable = true;
+
+    static value_type       &element(slot_type *s) noexcept { return **s; }
+    static const value_type &element(const slot_type *s) noexcept { return **s; }
+    static const K    &key(const slot_type *s) noexcept { return (*s)->first; }
+
+    template <typename A, typename... Args>
+    static void construct(A &alloc, slot_type *s, Args &&...args) {
+        using traits = libcxx::allocator_traits<A>;
+        value_type *node = traits::allocate(alloc, 1);
+        try {
+            traits::construct(alloc, node, std::Memory::forward<Args>(args)...);
+        } catch (...) {
+            traits::deallocate(alloc, node, 1);
+            throw;
+        }
+        *s = node;
+    }
+
+    template <typename A>
+    static void destroy(A &alloc, slot_type *s) noexcept {
+        using traits = libcxx::allocator_traits<A>;
+        traits::destroy(alloc, *s);
+        traits::deallocate(alloc, *s, 1);
+    }
+
+    template <typename A>
+    static void transfer(A & /*alloc*/, slot_type *dst, slot_type *src) noexcept {
+        *dst = *src;
+    }
+};
+
+/// set elements stored inline; the element is its own key and is never handed out mutable.
+template <typename T>
+struct FlatSetPolicy {
+    using key_type   = T;
+    using value_type = T;
+
+    union slot_type {
+        slot_type() {}
+        ~slot_type() {}
+
+        T value;
+    };
+
+    static constexpr bool trivial_destroy       = libcxx::is_trivially_destructible_v<T>;
+    static constexpr bool trivially_relocatable = Memory::is_trivially_relocatable_v<T>;
+
+    static const T &element(const slot_type *s) noexcept { return s->value; }
+    static const T &key(const slot_type *s) noexcept { return s->value; }
+
+    template <typename A, typename... Args>
+    static void construct(A &alloc, slot_type *s, Args &&...args) {
+        libcxx::allocator_traits<A>::construct(alloc, libcxx::addressof(s->value),
+                                               std::Memory::forward<Args>(args)...);
+    }
+
+    template <typename A>
+    static void destroy(A &alloc, slot_type *s) noexcept {
+        libcxx::allocator_traits<A>::destroy(alloc, libcxx::addressof(s->value));
+    }
+
+    template <typename A>
+    static void transfer(A &alloc, slot_type *dst, slot_type *src) {
+        if constexpr (trivially_relocatable) {
+            libcxx::memcpy(static_cast<void *>(dst), static_cast<const void *>(src),
+                           sizeof(slot_type));
+        } else {
+            construct(alloc, dst, libcxx::move(src->value));
+            destroy(alloc, src);
+        }
+    }
+};
+}  // namespace __maping
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M11SLOT_POLICY
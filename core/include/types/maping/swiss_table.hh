@@ -0,0 +1,976 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M11SWISS_TABLE
+#define _$_HX_CORE_M11SWISS_TABLE
+
+#include <include/config/config.hh>
+
+#include <bit>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/runtime/__memory/relocate.hh>
+#include <include/types/maping/slot_policy.hh>
+#include <include/types/string/basic.hh>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define _KAIRO_SWISS_SSE2 1
+#   include <emmintrin.h>
+#endif
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace __swiss {
+template <typename CharT>
+using view = libcxx::basic_string_view<CharT>;
+
+/// anything that names a run of CharT: Kairo strings and slices (raw() + size()), std strings,
+/// string views and C strings.
+template <typename S, typename CharT>
+concept string_like = requires(const S &s) {
+    { s.raw() } -> libcxx::convertible_to<const CharT *>;
+    { s.size() } -> libcxx::convertible_to<usize>;
+} || libcxx::convertible_to<const S &, view<CharT>>;
+
+template <typename CharT, typename S>
+constexpr view<CharT> as_view(const S &s) noexcept {
+    if constexpr (requires { s.raw(); }) {
+        return view<CharT>(s.raw(), s.size());
+    } else {
+        return view<CharT>(s);
+    }
+}
+}  // namespace __swiss
+
+///
+/// \brief Transparent hasher for every string type of one character width. It hashes the
+///        characters exactly as std::hash<std::basic_string_view> does, so a table keyed by
+///        `string` can be probed with a slice, a std string or a literal without building a
+///        temporary string.
+///
+template <typename CharT>
+struct StringHash {
+    using is_transparent = void;
+
+    template <__swiss::string_like<CharT> S>
+    usize operator()(const S &s) const noexcept {
+        return libcxx::hash<__swiss::view<CharT>>{}(__swiss::as_view<CharT>(s));
+    }
+};
+
+/// \brief Transparent equality to go with StringHash.
+template <typename CharT>
+struct StringEq {
+    using is_transparent = void;
+
+    template <__swiss::string_like<CharT> A, __swiss::string_like<CharT> B>
+    bool operator()(const A &a, const B &b) const noexcept {
+        return __swiss::as_view<CharT>(a) == __swiss::as_view<CharT>(b);
+    }
+};
+
+namespace __swiss {
+template <typename K>
+struct string_char {
+    using type = void;
+};
+
+template <typename C, typename T>
+struct string_char<String::basic<C, T>> {
+    using type = C;
+};
+
+template <typename C, typename T>
+struct string_char<String::slice<C, T>> {
+    using type = C;
+};
+
+template <typename C, typename T, typename A>
+struct string_char<libcxx::basic_string<C, T, A>> {
+    using type = C;
+};
+
+template <typename C, typename T>
+struct string_char<libcxx::basic_string_view<C, T>> {
+    using type = C;
+};
+
+/// hasher and equality a table uses when none is given: the transparent string pair for string
+/// keys, std::hash and std::equal_to otherwise.
+template <typename K, typename C = typename string_char<K>::type>
+struct hash_eq {
+    using hash = StringHash<C>;
+    using eq   = StringEq<C>;
+};
+
+template <typename K>
+struct hash_eq<K, void> {
+    using hash = libcxx::hash<K>;
+    using eq   = libcxx::equal_to<K>;
+};
+
+// ---------------------------------------------------------------- control bytes ---
+//
+// every slot has one control byte: Empty, Deleted (a tombstone), or, when full, the low 7 bits
+// of its hash (h2). the bytes sit in one array ahead of the slots, followed by a Sentinel that
+// stops iteration and a copy of the first `width - 1` bytes, so a 16-byte load starting at any
+// slot never wraps. a lookup compares h2 against 16 control bytes at once and only touches the
+// slots whose byte matched.
+
+using ctrl_t = i8;
+
+inline constexpr ctrl_t Empty    = -128;
+inline constexpr ctrl_t Deleted  = -2;
+inline constexpr ctrl_t Sentinel = -1;
+
+inline constexpr usize width  = 16;
+inline constexpr usize cloned = width - 1;
+
+constexpr bool is_full(ctrl_t c) noexcept { return c >= 0; }
+
+/// control bytes of every table without storage: lookups run the ordinary probe and stop on
+/// the first group, so no path needs a capacity check.
+alignas(16) inline constexpr ctrl_t empty_group[width] = {
+    Sentinel, Empty, Empty, Empty, Empty, Empty, Empty, Empty,
+    Empty,    Empty, Empty, Empty, Empty, Empty, Empty, Empty};
+
+/// spread a hash over all 64 bits. std::hash of an integer is the integer itself, which would
+/// leave h2 and the probe start equal for every small key.
+inline u64 mix(usize h) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 m = static_cast<unsigned __int128>(h) * 0x9E3779B97F4A7C15ull;
+    return static_cast<u64>(m) ^ static_cast<u64>(m >> 64);
+#else
+    u64 x = h;
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    return x ^ (x >> 33);
+#endif
+}
+
+/// one bit per control byte of a group, lowest bit first. iterating yields the set positions.
+struct BitMask {
+    u32 bits;
+
+    explicit operator bool() const noexcept { return bits != 0; }
+    u32 lowest() const noexcept { return static_cast<u32>(libcxx::countr_zero(bits)); }
+    u32 leading_zeros() const noexcept {
+        return static_cast<u32>(libcxx::countl_zero(static_cast<u16>(bits)));
+    }
+
+    BitMask   begin() const noexcept { return *this; }
+    BitMask   end() const noexcept { return BitMask{0}; }
+    u32       operator*() const noexcept { return lowest(); }
+    BitMask  &operator++() noexcept {
+        bits &= bits - 1;
+        return *this;
+    }
+    bool operator!=(const BitMask &other) const noexcept { return bits != other.bits; }
+};
+
+/// sixteen control bytes, compared in one instruction each with SSE2 (the x86-64 baseline) and
+/// as two 64-bit words elsewhere.
+struct Group {
+#if defined(_KAIRO_SWISS_SSE2)
+    __m128i ctrl;
+
+    explicit Group(const ctrl_t *pos) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pos))) {}
+
+    BitMask match(ctrl_t h) const noexcept { return bits(_mm_cmpeq_epi8(_mm_set1_epi8(h), ctrl)); }
+    BitMask mask_empty() const noexcept { return match(Empty); }
+    BitMask mask_empty_or_deleted() const noexcept {
+        return bits(_mm_cmpgt_epi8(_mm_set1_epi8(Sentinel), ctrl));
+    }
+
+  private:
+    static BitMask bits(__m128i v) noexcept {
+        return BitMask{static_cast<u32>(_mm_movemask_epi8(v))};
+    }
+
+  public:
+#else
+    // two 8-byte words, tested a byte at a time with carry-free bit tricks
+    u64 lo;
+    u64 hi;
+
+    explicit Group(const ctrl_t *pos) noexcept
+        : lo(load(pos))
+        , hi(load(pos + 8)) {}
+
+    /// may also report a byte just above a true match; callers compare keys anyway.
+    BitMask match(ctrl_t h) const noexcept {
+        constexpr u64 lsbs = 0x0101010101010101ull;
+        const u64     x    = lsbs * static_cast<u8>(h);
+        return gather(((lo ^ x) - lsbs) & ~(lo ^ x), ((hi ^ x) - lsbs) & ~(hi ^ x));
+    }
+
+    /// exact: the high bit is set only for special bytes, and bit 1 is clear only in Empty.
+    BitMask mask_empty() const noexcept { return gather(lo & ~(lo << 6), hi & ~(hi << 6)); }
+
+    /// exact: bit 0 is clear in Empty and Deleted, set in Sentinel.
+    BitMask mask_empty_or_deleted() const noexcept {
+        return gather(lo & ~(lo << 7), hi & ~(hi << 7));
+    }
+
+  private:
+    static u64 load(const ctrl_t *p) noexcept {
+        u64 w;
+        libcxx::memcpy(&w, p, sizeof(w));
+        if constexpr (libcxx::endian::native == libcxx::endian::big) {
+            // byte 0 in the low bits, as on little-endian
+            w = ((w & 0x00FF00FF00FF00FFull) << 8) | ((w >> 8) & 0x00FF00FF00FF00FFull);
+            w = ((w & 0x0000FFFF0000FFFFull) << 16) | ((w >> 16) & 0x0000FFFF0000FFFFull);
+            w = (w << 32) | (w >> 32);
+        }
+        return w;
+    }
+
+    /// the high bit of each byte of both words, packed into 16 bits
+    static BitMask gather(u64 a, u64 b) noexcept {
+        constexpr u64 msbs = 0x8080808080808080ull;
+        constexpr u64 pack = 0x0102040810204080ull;
+        const u64     ia   = (((a & msbs) >> 7) * pack) >> 56;
+        const u64     ib   = (((b & msbs) >> 7) * pack) >> 56;
+        return BitMask{static_cast<u32>(ia | (ib << 8))};
+    }
+
+  public:
+#endif
+
+    /// empty or deleted bytes before the first full one (or the sentinel).
+    u32 count_leading_empty_or_deleted() const noexcept {
+        return static_cast<u32>(libcxx::countr_one(mask_empty_or_deleted().bits));
+    }
+};
+
+/// triangular probing over groups: visits every group of a power-of-two table once.
+struct Probe {
+    usize mask;
+    usize offset;
+    usize index{0};
+
+    Probe(usize h1, usize mask) noexcept
+        : mask(mask)
+        , offset(h1 & mask) {}
+
+    usize at(usize i) const noexcept { return (offset + i) & mask; }
+    void  next() noexcept {
+        index += width;
+        offset = (offset + index) & mask;
+    }
+};
+
+/// elements a table of `cap` slots holds before it grows: 7/8 full, and never so full that a
+/// probe could miss an empty slot.
+constexpr usize growth_for(usize cap) noexcept {
+    return cap == 0 ? 0 : cap - (cap / 8 > 1 ? cap / 8 : 1);
+}
+
+/// smallest capacity (2^k - 1) that holds `n` elements without growing.
+constexpr usize capacity_for(usize n) noexcept {
+    if (n == 0) {
+        return 0;
+    }
+    usize cap = 3;
+    while (growth_for(cap) < n) {
+        cap = cap * 2 + 1;
+    }
+    return cap;
+}
+
+///
+/// \brief The open-addressing table behind hash_map, node_hash_map, hash_set and
+///        node_hash_set. `Policy` says what a slot holds and how to build, destroy and move
+///        one:
+///
+///   key_type, value_type, slot_type
+///   static value_type      &element(slot_type *)
+///   static const key_type  &key(const slot_type *)
+///   static void construct(Alloc &, slot_type *, Args &&...)
+///   static void destroy(Alloc &, slot_type *)
+///   static void transfer(Alloc &, slot_type *dst, slot_type *src)   // move + destroy source
+///
+/// Storage is one allocation: control bytes, then slots. Erasing writes a tombstone only when
+/// some probe may have passed over the slot; otherwise the slot goes straight back to empty, so
+/// erase-heavy workloads do not fill the table with tombstones. When growth runs out while most
+/// of the used slots are tombstones, the table is rebuilt at the same size instead of doubling.
+///
+template <typename Policy, typename Hash, typename Eq, typename Alloc>
+class RawTable {
+  public:
+    using key_type        = typename Policy::key_type;
+    using value_type      = typename Policy::value_type;
+    using slot_type       = typename Policy::slot_type;
+    using hasher          = Hash;
+    using key_equal       = Eq;
+    using allocator_type  = Alloc;
+    using size_type       = usize;
+    using difference_type = libcxx::ptrdiff_t;
+    using reference       = value_type &;
+    using const_reference = const value_type &;
+
+    /// lookups accept any type the hasher and equality accept, without converting it to
+    /// key_type first, when both declare is_transparent.
+    static constexpr bool transparent = requires {
+        typename Hash::is_transparent;
+        typename Eq::is_transparent;
+    };
+
+    template <typename K>
+    using key_arg = typename __maping::KeyArg<transparent>::template type<K, key_type>;
+
+  private:
+    using traits = libcxx::allocator_traits<Alloc>;
+
+    struct alignas(alignof(slot_type)) Unit {
+        unsigned char bytes[alignof(slot_type)];
+    };
+    using unit_alloc  = typename traits::template rebind_alloc<Unit>;
+    using unit_traits = libcxx::allocator_traits<unit_alloc>;
+
+    template <bool Const>
+    class basic_iterator {
+        friend class RawTable;
+
+      public:
+        using iterator_category = libcxx::forward_iterator_tag;
+        using value_type        = RawTable::value_type;
+        using difference_type   = libcxx::ptrdiff_t;
+        // sets only hand out const elements
+        using reference = libcxx::conditional_t<
+            Const,
+            const value_type &,
+            decltype(Policy::element(libcxx::declval<slot_type *>()))>;
+        using pointer = libcxx::add_pointer_t<reference>;
+
+        basic_iterator() noexcept = default;
+
+        template <bool C = Const>
+            requires C
+        basic_iterator(const basic_iterator<false> &other) noexcept  // NOLINT
+            : ctrl_(other.ctrl_)
+            , slot_(other.slot_) {}
+
+        reference operator*() const noexcept { return Policy::element(slot_); }
+        pointer   operator->() const noexcept { return libcxx::addressof(**this); }
+
+        basic_iterator &operator++() noexcept {
+            ++ctrl_;
+            ++slot_;
+            skip();
+            return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+            basic_iterator out = *this;
+            ++*this;
+            return out;
+        }
+
+        friend bool operator==(const basic_iterator &a, const basic_iterator &b) noexcept {
+            return a.ctrl_ == b.ctrl_;
+        }
+
+      private:
+        basic_iterator(ctrl_t *ctrl, slot_type *slot) noexcept
+            : ctrl_(ctrl)
+            , slot_(slot) {}
+
+        /// move to the next full slot, or the sentinel (end)
+        void skip() noexcept {
+            while (*ctrl_ < Sentinel) {
+                const u32 n = Group(ctrl_).count_leading_empty_or_deleted();
+                ctrl_ += n;
+                slot_ += n;
+            }
+        }
+
+        ctrl_t    *ctrl_{nullptr};
+        slot_type *slot_{nullptr};
+    };
+
+  public:
+    using iterator       = basic_iterator<false>;
+    using const_iterator = basic_iterator<true>;
+
+    RawTable() noexcept(noexcept(Hash()) && noexcept(Eq()) && noexcept(Alloc())) = default;
+
+    explicit RawTable(usize bucket_count,
+                      const Hash  &hash  = Hash(),
+                      const Eq    &eq    = Eq(),
+                      const Alloc &alloc = Alloc())
+        : hash_(hash)
+        , eq_(eq)
+        , alloc_(alloc) {
+        if (bucket_count != 0) {
+            allocate(capacity_for(bucket_count));
+        }
+    }
+
+    explicit RawTable(const Alloc &alloc)
+        : alloc_(alloc) {}
+
+    template <typename InputIt>
+    RawTable(InputIt      first,
+             InputIt      last,
+             usize        bucket_count = 0,
+             const Hash  &hash         = Hash(),
+             const Eq    &eq           = Eq(),
+             const Alloc &alloc        = Alloc())
+        : RawTable(bucket_count, hash, eq, alloc) {
+        insert(first, last);
+    }
+
+    RawTable(libcxx::initializer_list<value_type> init,
+             usize                                bucket_count = 0,
+             const Hash                          &hash         = Hash(),
+             const Eq                            &eq           = Eq(),
+             const Alloc                         &alloc        = Alloc())
+        : RawTable(bucket_count != 0 ? bucket_count : init.size(), hash, eq, alloc) {
+        insert(init.begin(), init.end());
+    }
+
+    RawTable(const RawTable &other)
+        : RawTable(other, traits::select_on_container_copy_construction(other.alloc_)) {}
+
+    RawTable(const RawTable &other, const Alloc &alloc)
+        : hash_(other.hash_)
+        , eq_(other.eq_)
+        , alloc_(alloc) {
+        copy_from(other);
+    }
+
+    RawTable(RawTable &&other) noexcept
+        : hash_(libcxx::move(other.hash_))
+        , eq_(libcxx::move(other.eq_))
+        , alloc_(libcxx::move(other.alloc_)) {
+        steal(other);
+    }
+
+    ~RawTable() {
+        destroy_all();
+        release();
+    }
+
+    RawTable &operator=(const RawTable &other) {
+        if (this != &other) {
+            clear();
+            if constexpr (traits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != other.alloc_) {
+                    release();
+                }
+                alloc_ = other.alloc_;
+            }
+            hash_ = other.hash_;
+            eq_   = other.eq_;
+            copy_from(other);
+        }
+        return *this;
+    }
+
+    RawTable &operator=(RawTable &&other) noexcept(
+        traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        hash_ = libcxx::move(other.hash_);
+        eq_   = libcxx::move(other.eq_);
+
+        if constexpr (traits::propagate_on_container_move_assignment::value ||
+                      traits::is_always_equal::value) {
+            destroy_all();
+            release();
+            if constexpr (traits::propagate_on_container_move_assignment::value) {
+                alloc_ = libcxx::move(other.alloc_);
+            }
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                destroy_all();
+                release();
+                steal(other);
+            } else {
+                clear();
+                reserve(other.size());
+                for (auto &v : other) {
+                    emplace(libcxx::move(v));
+                }
+                other.clear();
+            }
+        }
+        return *this;
+    }
+
+    // --- iteration ---
+
+    iterator begin() noexcept {
+        iterator it(ctrl_, slots_);
+        it.skip();
+        return it;
+    }
+    const_iterator begin() const noexcept { return const_cast<RawTable *>(this)->begin(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator       end() noexcept { return iterator(ctrl_ + cap_, nullptr); }
+    const_iterator end() const noexcept { return const_cast<RawTable *>(this)->end(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    // --- capacity ---
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    usize              size() const noexcept { return size_; }
+    usize              max_size() const noexcept {
+        return (libcxx::numeric_limits<usize>::max)() / 2;
+    }
+
+    /// slots allocated; the table grows once size() reaches 7/8 of it.
+    usize capacity() const noexcept { return cap_; }
+    usize bucket_count() const noexcept { return cap_; }
+    float load_factor() const noexcept {
+        return cap_ == 0 ? 0.0F : static_cast<float>(size_) / static_cast<float>(cap_);
+    }
+    float max_load_factor() const noexcept { return 0.875F; }
+    /// fixed at 7/8; accepted for std::unordered_map compatibility.
+    void  max_load_factor(float /*unused*/) noexcept {}
+
+    /// make room for `n` elements in total without growing again.
+    void reserve(usize n) {
+        if (n > size_ + growth_left_) {
+            resize(capacity_for(n));
+        }
+    }
+
+    /// at least `n` slots, and enough for size(). rehash(0) shrinks to fit.
+    void rehash(usize n) {
+        const usize want = capacity_for(n > size_ ? n : size_);
+        if (want == 0) {
+            release();
+        } else if (want != cap_) {
+            resize(want);
+        }
+    }
+
+    void shrink_to_fit() { rehash(0); }
+
+    // --- lookup ---
+
+    template <typename K = key_type>
+    iterator find(const key_arg<K> &key) {
+        slot_type *slot = find_slot(key, hash_of(key));
+        return slot != nullptr ? iterator_at(index_of(slot)) : end();
+    }
+
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K> &key) const {
+        return const_cast<RawTable *>(this)->template find<K>(key);
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K> &key) const {
+        return find_slot(key, hash_of(key)) != nullptr;
+    }
+
+    template <typename K = key_type>
+    usize count(const key_arg<K> &key) const {
+        return contains<K>(key) ? 1 : 0;
+    }
+
+    template <typename K = key_type>
+    libcxx::pair<iterator, iterator> equal_range(const key_arg<K> &key) {
+        iterator it = find<K>(key);
+        if (it == end()) {
+            return {it, it};
+        }
+        iterator next = it;
+        return {it, ++next};
+    }
+
+    template <typename K = key_type>
+    libcxx::pair<const_iterator, const_iterator> equal_range(const key_arg<K> &key) const {
+        auto r = const_cast<RawTable *>(this)->template equal_range<K>(key);
+        return {r.first, r.second};
+    }
+
+    // --- modifiers ---
+
+    /// build the element, then place it if its key is new. use the keyed paths (try_emplace,
+    /// insert) when the key is at hand; they skip building a duplicate.
+    template <typename... Args>
+    libcxx::pair<iterator, bool> emplace(Args &&...args) {
+        alignas(slot_type) unsigned char buf[sizeof(slot_type)];  // NOLINT
+        auto *tmp = reinterpret_cast<slot_type *>(buf);
+        Policy::construct(alloc_, tmp, std::Memory::forward<Args>(args)...);
+
+        try {
+            const Insertion ins = find_or_prepare_insert(Policy::key(tmp));
+            if (!ins.fresh) {
+                Policy::destroy(alloc_, tmp);
+                return {iterator_at(ins.index), false};
+            }
+            Policy::transfer(alloc_, slots_ + ins.index, tmp);
+            commit_insert(ins.index, ins.hash);
+            return {iterator_at(ins.index), true};
+        } catch (...) {
+            Policy::destroy(alloc_, tmp);
+            throw;
+        }
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator /*hint*/, Args &&...args) {
+        return emplace(std::Memory::forward<Args>(args)...).first;
+    }
+
+    /// look `key` up and, only if it is absent, construct the element from `args` in place.
+    template <typename K, typename... Args>
+    libcxx::pair<iterator, bool> emplace_key(const K &key, Args &&...args) {
+        const Insertion ins = find_or_prepare_insert(key);
+        if (ins.fresh) {
+            Policy::construct(alloc_, slots_ + ins.index, std::Memory::forward<Args>(args)...);
+            commit_insert(ins.index, ins.hash);
+        }
+        return {iterator_at(ins.index), ins.fresh};
+    }
+
+    /// hash tables have no use for a position hint; accepted for std compatibility.
+    template <typename K, typename... Args>
+    libcxx::pair<iterator, bool> emplace_key_hint(const_iterator /*hint*/,
+                                                  const K &key,
+                                                  Args &&...args) {
+        return emplace_key(key, std::Memory::forward<Args>(args)...);
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        if constexpr (libcxx::is_base_of_v<
+                          libcxx::forward_iterator_tag,
+                          typename libcxx::iterator_traits<InputIt>::iterator_category>) {
+            reserve(size_ + static_cast<usize>(libcxx::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace(*first);
+        }
+    }
+
+    iterator erase(const_iterator pos) noexcept {
+        iterator it(pos.ctrl_, pos.slot_);
+        iterator next = it;
+        ++next;
+        erase_at(index_of(it.slot_));
+        return next;
+    }
+
+    iterator erase(iterator pos) noexcept { return erase(const_iterator(pos)); }
+
+    iterator erase(const_iterator first, const_iterator last) noexcept {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last.ctrl_, last.slot_);
+    }
+
+    template <typename K = key_type>
+    usize erase(const key_arg<K> &key) {
+        slot_type *slot = find_slot(key, hash_of(key));
+        if (slot == nullptr) {
+            return 0;
+        }
+        erase_at(index_of(slot));
+        return 1;
+    }
+
+    /// destroy every element. small tables keep their storage; large ones give it back.
+    void clear() noexcept {
+        destroy_all();
+        if (cap_ > 127) {
+            release();
+        } else if (cap_ != 0) {
+            size_ = 0;
+            reset_ctrl();
+        }
+    }
+
+    void swap(RawTable &other) noexcept {
+        using libcxx::swap;
+        swap(ctrl_, other.ctrl_);
+        swap(slots_, other.slots_);
+        swap(cap_, other.cap_);
+        swap(size_, other.size_);
+        swap(growth_left_, other.growth_left_);
+        swap(hash_, other.hash_);
+        swap(eq_, other.eq_);
+        if constexpr (traits::propagate_on_container_swap::value) {
+            swap(alloc_, other.alloc_);
+        }
+    }
+
+    friend void swap(RawTable &a, RawTable &b) noexcept { a.swap(b); }
+
+    /// same elements, in any order. walks the smaller table and probes the other.
+    friend bool operator==(const RawTable &a, const RawTable &b) {
+        if (a.size_ != b.size_) {
+            return false;
+        }
+        const RawTable *outer = a.cap_ <= b.cap_ ? &a : &b;
+        const RawTable *inner = outer == &a ? &b : &a;
+
+        for (usize i = 0; i != outer->cap_; ++i) {
+            if (is_full(outer->ctrl_[i])) {
+                const slot_type *mine  = outer->slots_ + i;
+                const auto      &key   = Policy::key(mine);
+                const slot_type *other = inner->find_slot(key, inner->hash_of(key));
+                if (other == nullptr || !(Policy::element(other) == Policy::element(mine))) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    hasher         hash_function() const { return hash_; }
+    key_equal      key_eq() const { return eq_; }
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+  protected:
+    struct Insertion {
+        usize index;
+        usize hash;
+        bool  fresh;
+    };
+
+    template <typename K>
+    usize hash_of(const K &key) const {
+        return static_cast<usize>(mix(static_cast<usize>(hash_(key))));
+    }
+
+    /// probe start. salted with the storage address so that copying one table into another in
+    /// iteration order does not pile every key into the same run of groups.
+    usize h1(usize hash) const noexcept {
+        return (hash >> 7) ^ (reinterpret_cast<uintptr_t>(ctrl_) >> 12);
+    }
+    static ctrl_t h2(usize hash) noexcept { return static_cast<ctrl_t>(hash & 0x7F); }
+
+    iterator  iterator_at(usize i) noexcept { return iterator(ctrl_ + i, slots_ + i); }
+    usize     index_of(const slot_type *slot) const noexcept {
+        return static_cast<usize>(slot - slots_);
+    }
+
+    template <typename K>
+    slot_type *find_slot(const K &key, usize hash) const {
+        Probe        seq(h1(hash), cap_);
+        const ctrl_t h = h2(hash);
+
+        while (true) {
+            Group g(ctrl_ + seq.offset);
+            for (u32 i : g.match(h)) {
+                slot_type *slot = slots_ + seq.at(i);
+                if (eq_(Policy::key(slot), key)) {
+                    return slot;
+                }
+            }
+            if (g.mask_empty()) {
+                return nullptr;
+            }
+            seq.next();
+        }
+    }
+
+    /// the slot `key` lives in, or the slot a new element with that key should be built in. a
+    /// fresh slot is not claimed until commit_insert, so a throwing constructor leaves the
+    /// table as it was.
+    template <typename K>
+    Insertion find_or_prepare_insert(const K &key) {
+        const usize hash = hash_of(key);
+        if (slot_type *slot = find_slot(key, hash)) {
+            return {index_of(slot), hash, false};
+        }
+        return {prepare_insert(hash), hash, true};
+    }
+
+    usize prepare_insert(usize hash) {
+        usize target = find_first_non_full(hash);
+        if (growth_left_ == 0 && ctrl_[target] != Deleted) {
+            rehash_and_grow();
+            target = find_first_non_full(hash);
+        }
+        return target;
+    }
+
+    void commit_insert(usize i, usize hash) noexcept {
+        growth_left_ -= ctrl_[i] == Empty ? 1 : 0;
+        set_ctrl(i, h2(hash));
+        ++size_;
+    }
+
+    void erase_at(usize i) noexcept {
+        Policy::destroy(alloc_, slots_ + i);
+        erase_meta(i);
+    }
+
+  private:
+    usize find_first_non_full(usize hash) const noexcept {
+        Probe seq(h1(hash), cap_);
+        while (true) {
+            if (BitMask m = Group(ctrl_ + seq.offset).mask_empty_or_deleted()) {
+                return seq.at(m.lowest());
+            }
+            seq.next();
+        }
+    }
+
+    /// write a control byte and its clone past the sentinel.
+    void set_ctrl(usize i, ctrl_t h) noexcept {
+        ctrl_[i]                                      = h;
+        ctrl_[((i - cloned) & cap_) + (cloned & cap_)] = h;
+    }
+
+    /// a probe only continues past a group with no empty byte, so a slot can go straight back
+    /// to empty when every 16-byte window covering it still has one. tables smaller than a
+    /// group are always scanned whole.
+    void erase_meta(usize i) noexcept {
+        --size_;
+
+        bool never_full = true;
+        if (cap_ >= width) {
+            const BitMask after  = Group(ctrl_ + i).mask_empty();
+            const BitMask before = Group(ctrl_ + ((i - width) & cap_)).mask_empty();
+            never_full           = after && before &&
+                         libcxx::countr_zero(after.bits) + before.leading_zeros() < width;
+        }
+
+        set_ctrl(i, never_full ? Empty : Deleted);
+        growth_left_ += never_full ? 1 : 0;
+    }
+
+    void rehash_and_grow() {
+        if (cap_ >= width && size_ * 32 <= cap_ * 25) {
+            // mostly tombstones: rebuild at the same size
+            resize(cap_);
+        } else {
+            resize(cap_ == 0 ? 3 : cap_ * 2 + 1);
+        }
+    }
+
+    static usize slot_offset(usize cap) noexcept {
+        constexpr usize align = alignof(slot_type);
+        return (cap + 1 + cloned + align - 1) & ~(align - 1);
+    }
+
+    static usize units_for(usize cap) noexcept {
+        return (slot_offset(cap) + cap * sizeof(slot_type) + sizeof(Unit) - 1) / sizeof(Unit);
+    }
+
+    void allocate(usize cap) {
+        unit_alloc ua(alloc_);
+        Unit      *mem = unit_traits::allocate(ua, units_for(cap));
+        ctrl_          = reinterpret_cast<ctrl_t *>(mem);
+        slots_         = reinterpret_cast<slot_type *>(reinterpret_cast<unsigned char *>(mem) +
+                                               slot_offset(cap));
+        cap_           = cap;
+        reset_ctrl();
+    }
+
+    void deallocate(ctrl_t *ctrl, usize cap) noexcept {
+        if (cap == 0) {
+            return;
+        }
+        unit_alloc ua(alloc_);
+        unit_traits::deallocate(ua, reinterpret_cast<Unit *>(ctrl), units_for(cap));
+    }
+
+    void reset_ctrl() noexcept {
+        libcxx::memset(ctrl_, static_cast<unsigned char>(Empty), cap_ + 1 + cloned);
+        ctrl_[cap_]  = Sentinel;
+        growth_left_ = growth_for(cap_) - size_;
+    }
+
+    /// move every element into fresh storage of `cap` slots. hashing and moving are assumed
+    /// not to throw here, as std::hash and relocation do not.
+    void resize(usize cap) {
+        ctrl_t    *old_ctrl  = ctrl_;
+        slot_type *old_slots = slots_;
+        const usize old_cap  = cap_;
+
+        allocate(cap);
+        for (usize i = 0; i != old_cap; ++i) {
+            if (is_full(old_ctrl[i])) {
+                const usize hash   = hash_of(Policy::key(old_slots + i));
+                const usize target = find_first_non_full(hash);
+                set_ctrl(target, h2(hash));
+                Policy::transfer(alloc_, slots_ + target, old_slots + i);
+            }
+        }
+        deallocate(old_ctrl, old_cap);
+    }
+
+    void copy_from(const RawTable &other) {
+        reserve(other.size_);
+        for (usize i = 0; i != other.cap_; ++i) {
+            if (is_full(other.ctrl_[i])) {
+                const usize hash   = hash_of(Policy::key(other.slots_ + i));
+                const usize target = find_first_non_full(hash);
+                Policy::construct(alloc_, slots_ + target, Policy::element(other.slots_ + i));
+                commit_insert(target, hash);
+            }
+        }
+    }
+
+    void destroy_all() noexcept {
+        if constexpr (!Policy::trivial_destroy) {
+            for (usize i = 0; i != cap_; ++i) {
+                if (is_full(ctrl_[i])) {
+                    Policy::destroy(alloc_, slots_ + i);
+                }
+            }
+        }
+    }
+
+    void release() noexcept {
+        deallocate(ctrl_, cap_);
+        ctrl_        = const_cast<ctrl_t *>(empty_group);
+        slots_       = nullptr;
+        cap_         = 0;
+        size_        = 0;
+        growth_left_ = 0;
+    }
+
+    void steal(RawTable &other) noexcept {
+        ctrl_        = libcxx::exchange(other.ctrl_, const_cast<ctrl_t *>(empty_group));
+        slots_       = libcxx::exchange(other.slots_, nullptr);
+        cap_         = libcxx::exchange(other.cap_, 0);
+        size_        = libcxx::exchange(other.size_, 0);
+        growth_left_ = libcxx::exchange(other.growth_left_, 0);
+    }
+
+    ctrl_t    *ctrl_{const_cast<ctrl_t *>(empty_group)};
+    slot_type *slots_{nullptr};
+    usize      cap_{0};
+    usize      size_{0};
+    usize      growth_left_{0};
+
+    [[no_unique_address]] Hash  hash_{};
+    [[no_unique_address]] Eq    eq_{};
+    [[no_unique_address]] Alloc alloc_{};
+};
+}  // namespace __swiss
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#undef _KAIRO_SWISS_SSE2
+
+#endif  // _$_HX_CORE_M11SWISS_TABLE
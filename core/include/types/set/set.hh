@@ -14,8 +14,541 @@
 
 #include <include/config/config.hh>
 
+#include <bit>
+
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/types/maping/map_api.hh>
+#include <include/types/maping/slot_policy.hh>
+#include <include/types/maping/swiss_table.hh>
+
+#if defined(__AVX2__)
+#   define _KAIRO_DENSE_AVX2 1
+#   include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define _KAIRO_DENSE_SSE2 1
+#   include <emmintrin.h>
+#endif
+
 H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+///
+/// \brief Open-addressing hash set; the set counterpart of hash_map, with the same table
+///        (control bytes probed 16 at a time, elements inline in one slot array) and the same
+///        transparent defaults for string elements.
+///
+/// It has the std::unordered_set interface; growing the table moves elements, so an insert
+/// can invalidate pointers and references to them.
+/// \code
+///   hash_set<string> seen;
+///   seen.reserve(words.size());
+///   for (auto &w : words) {
+///       if (!seen.insert(w).second) { ... }  // duplicate
+///   }
+/// \endcode
+///
+template <typename T,
+          typename Hash  = typename __swiss::hash_eq<T>::hash,
+          typename Eq    = typename __swiss::hash_eq<T>::eq,
+          typename Alloc = libcxx::allocator<T>>
+class hash_set : public __maping::SetApi<
+                     __swiss::RawTable<__maping::FlatSetPolicy<T>, Hash, Eq, Alloc>> {
+    using base =
+        __maping::SetApi<__swiss::RawTable<__maping::FlatSetPolicy<T>, Hash, Eq, Alloc>>;
+
+  public:
+    using base::base;
+    using base::operator=;
+
+    hash_set() = default;
+};
+
+template <typename T, typename H, typename E, typename A, typename Pred>
+usize erase_if(hash_set<T, H, E, A> &set, Pred pred) {
+    usize out = 0;
+    for (auto it = set.begin(); it != set.end();) {
+        if (pred(*it)) {
+            it = set.erase(it);
+            ++out;
+        } else {
+            ++it;
+        }
+    }
+    return out;
+}
+
+namespace __dense {
+/// one page covers 2^16 consecutive values: 8 KiB of bits plus a count.
+inline constexpr usize page_shift = 16;
+inline constexpr usize page_bits  = usize{1} << page_shift;
+inline constexpr usize page_words = page_bits / 64;
+
+struct alignas(64) Page {
+    u64 words[page_words];
+    u32 count;
+};
+
+enum class Op : u8 { Or, And, AndNot };
+
+/// dst = dst op src over a whole page, 128 or 256 bits at a time; returns the popcount of the
+/// result, which becomes the page's count.
+template <Op O>
+inline u32 combine(u64 *dst, const u64 *src) noexcept {
+    usize i = 0;
+#if defined(_KAIRO_DENSE_AVX2)
+    for (; i < page_words; i += 4) {
+        const __m256i a = _mm256_load_si256(reinterpret_cast<const __m256i *>(dst + i));
+        const __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i *>(src + i));
+        __m256i       r;
+        if constexpr (O == Op::Or) {
+            r = _mm256_or_si256(a, b);
+        } else if constexpr (O == Op::And) {
+            r = _mm256_and_si256(a, b);
+        } else {
+            r = _mm256_andnot_si256(b, a);
+        }
+        _mm256_store_si256(reinterpret_cast<__m256i *>(dst + i), r);
+    }
+#elif defined(_KAIRO_DENSE_SSE2)
+    for (; i < page_words; i += 2) {
+        const __m128i a = _mm_load_si128(reinterpret_cast<const __m128i *>(dst + i));
+        const __m128i b = _mm_load_si128(reinterpret_cast<const __m128i *>(src + i));
+        __m128i       r;
+        if constexpr (O == Op::Or) {
+            r = _mm_or_si128(a, b);
+        } else if constexpr (O == Op::And) {
+            r = _mm_and_si128(a, b);
+        } else {
+            r = _mm_andnot_si128(b, a);
+        }
+        _mm_store_si128(reinterpret_cast<__m128i *>(dst + i), r);
+    }
+#endif
+    for (; i < page_words; ++i) {
+        if constexpr (O == Op::Or) {
+            dst[i] |= src[i];
+        } else if constexpr (O == Op::And) {
+            dst[i] &= src[i];
+        } else {
+            dst[i] &= ~src[i];
+        }
+    }
+
+    u32 count = 0;
+    for (usize w = 0; w < page_words; ++w) {
+        count += static_cast<u32>(libcxx::popcount(dst[w]));
+    }
+    return count;
+}
+}  // namespace __dense
+
+///
+/// \brief Set of integers stored as a bitmap split into 8 KiB pages of 2^16 values each. A
+///        page is allocated on the first insert into its range and freed when its last value
+///        is erased. Membership is one shift and one bit test. A dense range of ids costs one
+///        bit per possible value: 100M ids in [0, 100M) take 12.5 MB.
+///
+/// Insert, erase and contains are O(1). size() is kept from per-page counts, which the bulk
+/// operations recompute with popcount. Union, intersection and difference combine page by page
+/// with SIMD and skip absent pages. Iteration is in ascending order.
+///
+/// The page directory spans from the lowest to the highest page in use, so the set suits ids
+/// that cluster (anywhere in T's range, negative values included); a few values scattered
+/// across a 64-bit range would need a directory entry for every page between them.
+/// \code
+///   dense_set<u32> live;
+///   for (u32 id : batch) {
+///       if (!live.insert(id)) { ... }  // seen before
+///   }
+///   live &= allowed;
+///   for (u32 id : live) { ... }  // ascending
+/// \endcode
+///
+template <typename T>
+    requires(libcxx::is_integral_v<T> && !libcxx::is_same_v<T, bool>)
+class dense_set {
+    using U    = libcxx::make_unsigned_t<T>;
+    using Page = __dense::Page;
+
+    static constexpr U sign = libcxx::is_signed_v<T> ? U(U(1) << (sizeof(T) * 8 - 1)) : U(0);
+
+  public:
+    using key_type        = T;
+    using value_type      = T;
+    using size_type       = usize;
+    using difference_type = libcxx::ptrdiff_t;
+
+    /// ascending iteration over the set bits; yields values, not references.
+    class iterator {
+        friend class dense_set;
+
+      public:
+        using iterator_category = libcxx::input_iterator_tag;
+        using iterator_concept  = libcxx::forward_iterator_tag;
+        using value_type        = T;
+        using difference_type   = libcxx::ptrdiff_t;
+        using reference         = T;
+
+        iterator() noexcept = default;
+
+        T operator*() const noexcept { return set_->value_at(pos_); }
+
+        iterator &operator++() noexcept {
+            pos_ = set_->next_from(pos_ + 1);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept {
+            iterator out = *this;
+            ++*this;
+            return out;
+        }
+
+        friend bool operator==(const iterator &a, const iterator &b) noexcept {
+            return a.pos_ == b.pos_;
+        }
+
+      private:
+        iterator(const dense_set *set, u64 pos) noexcept
+            : set_(set)
+            , pos_(pos) {}
+
+        const dense_set *set_{nullptr};
+        u64              pos_{0};  // bit index from the start of the directory
+    };
+
+    using const_iterator = iterator;
+
+    dense_set() noexcept = default;
+
+    dense_set(libcxx::initializer_list<T> init) { insert(init.begin(), init.end()); }
+
+    template <typename InputIt>
+    dense_set(InputIt first, InputIt last) {
+        insert(first, last);
+    }
+
+    dense_set(const dense_set &other)
+        : base_(other.base_)
+        , size_(other.size_) {
+        pages_.reserve(other.pages_.size());
+        for (const auto &page : other.pages_) {
+            pages_.push_back(page ? libcxx::make_unique<Page>(*page) : nullptr);
+        }
+    }
+
+    dense_set(dense_set &&other) noexcept
+        : pages_(libcxx::move(other.pages_))
+        , base_(other.base_)
+        , size_(libcxx::exchange(other.size_, 0)) {}
+
+    dense_set &operator=(const dense_set &other) {
+        if (this != &other) {
+            dense_set copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    dense_set &operator=(dense_set &&other) noexcept {
+        if (this != &other) {
+            pages_ = libcxx::move(other.pages_);
+            base_  = other.base_;
+            size_  = libcxx::exchange(other.size_, 0);
+            other.pages_.clear();
+        }
+        return *this;
+    }
+
+    ~dense_set() = default;
 
+    // --- iteration ---
+
+    iterator begin() const noexcept { return iterator(this, next_from(0)); }
+    iterator end() const noexcept { return iterator(this, limit()); }
+    iterator cbegin() const noexcept { return begin(); }
+    iterator cend() const noexcept { return end(); }
+
+    // --- capacity ---
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    usize              size() const noexcept { return size_; }
+
+    /// bytes held by pages and the directory.
+    usize bytes_used() const noexcept {
+        usize out = pages_.capacity() * sizeof(pages_[0]);
+        for (const auto &page : pages_) {
+            out += page ? sizeof(Page) : 0;
+        }
+        return out;
+    }
+
+    // --- lookup ---
+
+    bool contains(T value) const noexcept {
+        const Page *page = find_page(encode(value));
+        return page != nullptr && test(*page, encode(value));
+    }
+
+    usize count(T value) const noexcept { return contains(value) ? 1 : 0; }
+
+    /// first element not below `value`.
+    iterator lower_bound(T value) const noexcept {
+        const u64 page = encode(value) >> __dense::page_shift;
+        if (pages_.empty() || page < base_) {
+            return begin();
+        }
+        if (page - base_ >= pages_.size()) {
+            return end();
+        }
+        const u64 pos = ((page - base_) << __dense::page_shift) |
+                        (encode(value) & (__dense::page_bits - 1));
+        return iterator(this, next_from(pos));
+    }
+
+    // --- modifiers ---
+
+    /// true when `value` was not already present.
+    bool insert(T value) {
+        const U   u    = encode(value);
+        Page     &page = make_page(u);
+        u64      &word = page.words[(u & (__dense::page_bits - 1)) >> 6];
+        const u64 bit  = u64{1} << (u & 63);
+        if ((word & bit) != 0) {
+            return false;
+        }
+        word |= bit;
+        ++page.count;
+        ++size_;
+        return true;
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            insert(static_cast<T>(*first));
+        }
+    }
+
+    void insert(libcxx::initializer_list<T> init) { insert(init.begin(), init.end()); }
+
+    usize erase(T value) noexcept {
+        const U u    = encode(value);
+        Page   *page = find_page(u);
+        if (page == nullptr || !test(*page, u)) {
+            return 0;
+        }
+        page->words[(u & (__dense::page_bits - 1)) >> 6] &= ~(u64{1} << (u & 63));
+        --size_;
+        if (--page->count == 0) {
+            pages_[(u >> __dense::page_shift) - base_].reset();
+        }
+        return 1;
+    }
+
+    /// frees every page.
+    void clear() noexcept {
+        pages_.clear();
+        size_ = 0;
+    }
+
+    void swap(dense_set &other) noexcept {
+        pages_.swap(other.pages_);
+        libcxx::swap(base_, other.base_);
+        libcxx::swap(size_, other.size_);
+    }
+
+    friend void swap(dense_set &a, dense_set &b) noexcept { a.swap(b); }
+
+    // --- set algebra ---
+
+    /// union: adds every element of `other`.
+    dense_set &operator|=(const dense_set &other) {
+        if (&other == this) {
+            return *this;  // make_page() below may reshape the directory being read
+        }
+        for (usize i = 0; i < other.pages_.size(); ++i) {
+            const Page *src = other.pages_[i].get();
+            if (src == nullptr) {
+                continue;
+            }
+            const u64 page = other.base_ + i;
+            Page     &dst  = make_page(static_cast<U>(page << __dense::page_shift));
+            size_ -= dst.count;
+            if (dst.count == 0) {
+                dst = *src;
+            } else {
+                dst.count = __dense::combine<__dense::Op::Or>(dst.words, src->words);
+            }
+            size_ += dst.count;
+        }
+        return *this;
+    }
+
+    /// intersection: keeps the elements also in `other`.
+    dense_set &operator&=(const dense_set &other) noexcept {
+        for (usize i = 0; i < pages_.size(); ++i) {
+            if (!pages_[i]) {
+                continue;
+            }
+            const Page *src = other.page_at(base_ + i);
+            if (src == nullptr) {
+                drop(i);
+            } else {
+                restate(i, __dense::combine<__dense::Op::And>(pages_[i]->words, src->words));
+            }
+        }
+        return *this;
+    }
+
+    /// difference: removes the elements in `other`.
+    dense_set &operator-=(const dense_set &other) noexcept {
+        for (usize i = 0; i < pages_.size(); ++i) {
+            const Page *src = pages_[i] ? other.page_at(base_ + i) : nullptr;
+            if (src != nullptr) {
+                restate(i, __dense::combine<__dense::Op::AndNot>(pages_[i]->words, src->words));
+            }
+        }
+        return *this;
+    }
+
+    friend dense_set operator|(dense_set a, const dense_set &b) { return a |= b; }
+    friend dense_set operator&(dense_set a, const dense_set &b) { return a &= b; }
+    friend dense_set operator-(dense_set a, const dense_set &b) { return a -= b; }
+
+    friend bool operator==(const dense_set &a, const dense_set &b) noexcept {
+        if (a.size_ != b.size_) {
+            return false;
+        }
+        for (usize i = 0; i < a.pages_.size(); ++i) {
+            const Page *x = a.pages_[i].get();
+            const Page *y = b.page_at(a.base_ + i);
+            if ((x == nullptr) != (y == nullptr)) {
+                return false;
+            }
+            if (x != nullptr && (x->count != y->count ||
+                                 libcxx::memcmp(x->words, y->words, sizeof(x->words)) != 0)) {
+                return false;
+            }
+        }
+        return true;  // equal sizes, so b has no page a lacks
+    }
+
+  private:
+    /// signed values are offset so that the unsigned order matches theirs.
+    static U encode(T value) noexcept { return static_cast<U>(static_cast<U>(value) ^ sign); }
+    static T decode(U bits) noexcept { return static_cast<T>(static_cast<U>(bits ^ sign)); }
+
+    static bool test(const Page &page, U u) noexcept {
+        return ((page.words[(u & (__dense::page_bits - 1)) >> 6] >> (u & 63)) & 1) != 0;
+    }
+
+    u64 limit() const noexcept { return static_cast<u64>(pages_.size()) << __dense::page_shift; }
+
+    T value_at(u64 pos) const noexcept {
+        return decode(static_cast<U>(((base_ + (pos >> __dense::page_shift))
+                                      << __dense::page_shift) |
+                                     (pos & (__dense::page_bits - 1))));
+    }
+
+    const Page *page_at(u64 page) const noexcept {
+        return page >= base_ && page - base_ < pages_.size() ? pages_[page - base_].get()
+                                                             : nullptr;
+    }
+
+    Page *find_page(U u) const noexcept {
+        return const_cast<Page *>(page_at(static_cast<u64>(u) >> __dense::page_shift));
+    }
+
+    /// the page holding `u`, allocating it (and widening the directory) when absent.
+    Page &make_page(U u) {
+        const u64 page = static_cast<u64>(u) >> __dense::page_shift;
+        if (pages_.empty()) {
+            base_ = page;
+        }
+        if (page < base_) {
+            // widen to the left: append the empty entries, then rotate them to the front
+            const usize used = pages_.size();
+            pages_.resize(used + static_cast<usize>(base_ - page));
+            libcxx::rotate(pages_.begin(), pages_.begin() + static_cast<libcxx::ptrdiff_t>(used),
+                           pages_.end());
+            base_ = page;
+        } else if (page - base_ >= pages_.size()) {
+            pages_.resize(static_cast<usize>(page - base_ + 1));
+        }
+
+        auto &slot = pages_[static_cast<usize>(page - base_)];
+        if (!slot) {
+            slot = libcxx::make_unique<Page>();
+        }
+        return *slot;
+    }
+
+    void drop(usize i) noexcept {
+        size_ -= pages_[i]->count;
+        pages_[i].reset();
+    }
+
+    /// take the count a bulk operation computed; empty pages go.
+    void restate(usize i, u32 count) noexcept {
+        size_ = size_ - pages_[i]->count + count;
+        pages_[i]->count = count;
+        if (count == 0) {
+            pages_[i].reset();
+        }
+    }
+
+    /// the first set bit at or after `pos`, or limit().
+    u64 next_from(u64 pos) const noexcept {
+        usize page = static_cast<usize>(pos >> __dense::page_shift);
+        usize word = static_cast<usize>((pos & (__dense::page_bits - 1)) >> 6);
+        u64   mask = ~u64{0} << (pos & 63);
+
+        for (; page < pages_.size(); ++page, word = 0, mask = ~u64{0}) {
+            const Page *p = pages_[page].get();
+            if (p == nullptr) {
+                continue;
+            }
+            for (; word < __dense::page_words; ++word, mask = ~u64{0}) {
+                const u64 bits = p->words[word] & mask;
+                if (bits != 0) {
+                    return (static_cast<u64>(page) << __dense::page_shift) | (word << 6) |
+                           static_cast<u64>(libcxx::countr_zero(bits));
+                }
+            }
+        }
+        return limit();
+    }
+
+    libcxx::vector<libcxx::unique_ptr<Page>> pages_;
+    u64                                      base_{0};  // page number of pages_[0]
+    usize                                    size_{0};
+};
+
+template <typename T, typename Pred>
+usize erase_if(dense_set<T> &set, Pred pred) {
+    dense_set<T> drop;
+    for (T value : set) {
+        if (pred(value)) {
+            drop.insert(value);
+        }
+    }
+    set -= drop;
+    return drop.size();
+}
+
+namespace Memory {
+template <typename T, typename H, typename E, typename A>
+struct is_trivially_relocatable<hash_set<T, H, E, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<H> && is_trivially_relocatable_v<E> &&
+                            is_trivially_relocatable_v<A>> {};
+}  // namespace Memory
+
+H_STD_NAMESPACE_END
 H_NAMESPACE_END
 
+#undef _KAIRO_DENSE_AVX2
+#undef _KAIRO_DENSE_SSE2
+
 #endif  // _$_HX_CORE_M3SET
@@ -15,6 +15,7 @@
 #include <include/config/config.hh>
 #include <include/meta/__interfaces/casting.hh>
 #include <include/runtime/__memory/forwarding.hh>
+#include <include/runtime/__memory/relocate.hh>
 #include <include/types/string/char_traits.hh>
 #include <include/types/string/slice.hh>
 
@@ -264,6 +265,15 @@ class basic {
 };
 }  // namespace String
 
+#if defined(_LIBCPP_VERSION)
+namespace Memory {
+/// libc++'s std::string keeps no pointer into itself, so neither does basic. (libstdc++'s points
+/// at its own small-string buffer and must be moved properly.)
+template <typename CharT, typename Traits>
+struct is_trivially_relocatable<String::basic<CharT, Traits>> : libcxx::true_type {};
+}  // namespace Memory
+#endif
+
 H_STD_NAMESPACE_END
 
 using nstring  = std::String::basic<char>;
@@ -276,28 +286,28 @@ namespace std {
 template <>
 struct hash<kairo::string> {
     size_t operator()(const kairo::string &s) const noexcept {
-        return std::hash<std::wstring>{}(std::wstring(s.raw(), s.size()));
+        return std::hash<std::wstring_view>{}(std::wstring_view(s.raw(), s.size()));
     }
 };
 
 template <>
 struct hash<kairo::nstring> {
     size_t operator()(const kairo::nstring &s) const noexcept {
-        return std::hash<std::string>{}(std::string(s.raw(), s.size()));
+        return std::hash<std::string_view>{}(std::string_view(s.raw(), s.size()));
     }
 };
 
 template <>
 struct hash<kairo::string::slice> {
     size_t operator()(const kairo::string::slice &s) const noexcept {
-        return std::hash<std::wstring>{}(std::wstring(s.raw(), s.size()));
+        return std::hash<std::wstring_view>{}(std::wstring_view(s.raw(), s.size()));
     }
 };
 
 template <>
 struct hash<kairo::nstring::slice> {
     size_t operator()(const kairo::nstring::slice &s) const noexcept {
-        return std::hash<std::string>{}(std::string(s.raw(), s.size()));
+        return std::hash<std::string_view>{}(std::string_view(s.raw(), s.size()));
     }
 };
 }  // namespace std
@@ -137,14 +137,14 @@ namespace std {
 template <>
 struct hash<kairo::std::String::slice<wchar_t>> {
     size_t operator()(const kairo::std::String::slice<wchar_t> &s) const noexcept {
-        return std::hash<std::wstring>{}(std::wstring(s.raw(), s.size()));
+        return std::hash<std::wstring_view>{}(std::wstring_view(s.raw(), s.size()));
     }
 };
 
 template <>
 struct hash<kairo::std::String::slice<char>> {
     size_t operator()(const kairo::std::String::slice<char> &s) const noexcept {
-        return std::hash<std::string>{}(std::string(s.raw(), s.size()));
+        return std::hash<std::string_view>{}(std::string_view(s.raw(), s.size()));
     }
 };
 }  // namespace std
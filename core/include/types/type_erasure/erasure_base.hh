@@ -15,6 +15,7 @@
 #include <include/config/config.hh>
 
 #include <include/c++/libc++.hh>
+#include <include/runtime/__memory/small_alloc.hh>
 
 H_NAMESPACE_BEGIN
 H_STD_NAMESPACE_BEGIN
@@ -130,17 +131,27 @@ class TypeErasure {
 /// // safely destroying the object
 /// erased.destroy();
 /// \endcode
+///
+/// ### Ownership
+/// The wrapped object is owned by the wrapper. `TypeErasureImpl(obj)` takes an object made with
+/// `new`; `TypeErasureImpl(Memory::small_owned, obj)` takes one made with `Memory::small_new<T>`.
+/// Copies and clones are made in the small-object pool, as is the wrapper itself (panic frames
+/// and their clones are the hot users).
 template <typename T>
-class TypeErasureImpl : public TypeErasure {
+class TypeErasureImpl : public TypeErasure, public Memory::SmallObject {
   private:
     T                       *object;
     const libcxx::type_info *type;
     bool                     is_destroyed = false;  // Guard against double deletion
+    bool                     pooled       = false;  // object came from Memory::small_new
+
+    void release() noexcept;
 
   public:
     // Constructors
     TypeErasureImpl(const TypeErasureImpl &other);
     explicit TypeErasureImpl(T *obj);
+    TypeErasureImpl(Memory::small_owned_t, T *obj);
 
     // Assignment Operators
     TypeErasureImpl &operator=(const TypeErasureImpl &other);
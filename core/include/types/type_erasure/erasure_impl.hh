@@ -23,17 +23,18 @@ H_STD_NAMESPACE_BEGIN
 
 template <typename T>
 inline TypeErasureImpl<T>::TypeErasureImpl(const TypeErasureImpl &other)
-    : object(new T(*other.object))
+    : object(Memory::small_new<T>(*other.object))
     , type(other.type)
-    , is_destroyed(other.is_destroyed) {}
+    , is_destroyed(other.is_destroyed)
+    , pooled(true) {}
 
 template <typename T>
 inline TypeErasureImpl<T> &TypeErasureImpl<T>::operator=(const TypeErasureImpl &other) {
     if (this != &other) {
-        if (object != nullptr) {  // NOLINT(readability-delete-null-pointer)
-            delete object;
-        }
-        object       = new T(*other.object);  // NOLINT(cppcoreguidelines-owning-memory)
+        T *copy = Memory::small_new<T>(*other.object);
+        release();
+        object       = copy;
+        pooled       = true;
         is_destroyed = other.is_destroyed;
         type         = other.type;
     }
@@ -44,7 +45,8 @@ template <typename T>
 inline TypeErasureImpl<T>::TypeErasureImpl(TypeErasureImpl &&other) noexcept
     : object(other.object)
     , type(other.type)
-    , is_destroyed(other.is_destroyed) {
+    , is_destroyed(other.is_destroyed)
+    , pooled(other.pooled) {
     other.object       = nullptr;
     other.is_destroyed = true;
 }
@@ -52,10 +54,9 @@ inline TypeErasureImpl<T>::TypeErasureImpl(TypeErasureImpl &&other) noexcept
 template <typename T>
 inline TypeErasureImpl<T> &TypeErasureImpl<T>::operator=(TypeErasureImpl &&other) noexcept {
     if (this != &other) {
-        if (object != nullptr) {  // NOLINT(readability-delete-null-pointer)
-            delete object;
-        }
+        release();
         object             = other.object;
+        pooled             = other.pooled;
         is_destroyed       = other.is_destroyed;
         other.object       = nullptr;
         other.is_destroyed = true;
@@ -69,10 +70,25 @@ inline TypeErasureImpl<T>::TypeErasureImpl(T *obj)
     : object(obj)
     , type(&typeid(T)) {}
 
+template <typename T>
+inline TypeErasureImpl<T>::TypeErasureImpl(Memory::small_owned_t, T *obj)
+    : object(obj)
+    , type(&typeid(T))
+    , pooled(true) {}
+
+template <typename T>
+inline void TypeErasureImpl<T>::release() noexcept {
+    if (pooled) {
+        Memory::small_delete(object);
+    } else {
+        delete object;  // NOLINT(cppcoreguidelines-owning-memory)
+    }
+}
+
 template <typename T>
 inline void TypeErasureImpl<T>::destroy() {
     if (!is_destroyed && object != nullptr) {
-        delete object;
+        release();
         object       = nullptr;
         is_destroyed = true;
     }
@@ -93,7 +109,8 @@ inline TypeErasure *TypeErasureImpl<T>::clone() const {
     if (object == nullptr) {
         throw std::Error::RuntimeError(L"Cannot clone a null object.");
     }
-    return new TypeErasureImpl<T>(new T(*object));  // NOLINT(cppcoreguidelines-owning-memory)
+    // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+    return new TypeErasureImpl<T>(Memory::small_owned, Memory::small_new<T>(*object));
 }
 
 template <typename T>
@@ -30,7 +30,9 @@ H_STD_NAMESPACE_BEGIN
 /// for working with heterogeneous collections or dynamic polymorphism.
 ///
 /// ### Parameters
-/// - `obj`: A pointer to the object to be type-erased.
+/// - `obj`: A pointer to the object to be type-erased, allocated with `new`. Ownership passes
+///   to the wrapper. Objects made with `Memory::small_new<T>` go through the
+///   `erase_type(Memory::small_owned, obj)` overload instead.
 ///
 /// ### Returns
 /// A `TypeErasure` pointer that wraps the object, providing type-erased access.
@@ -45,6 +47,13 @@ template <typename T>
     return new TypeErasureImpl<T>(obj);  // NOLINT(cppcoreguidelines-owning-memory)
 }
 
+/// erase_type for an object made with `Memory::small_new<T>`; it is released with
+/// `Memory::small_delete`.
+template <typename T>
+[[nodiscard]] TypeErasure *erase_type(Memory::small_owned_t tag, T *obj) {
+    return new TypeErasureImpl<T>(tag, obj);  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
 H_STD_NAMESPACE_END
 H_NAMESPACE_END
 
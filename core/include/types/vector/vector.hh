@@ -14,7 +14,789 @@
 
 #include <include/config/config.hh>
 
+#include <include/c++/libc++.hh>
+#include <include/runtime/__memory/forwarding.hh>
+#include <include/runtime/__memory/relocate.hh>
+#include <include/types/vector/vector_fwd.hh>
+
+#if defined(__linux__)
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+/// buffers of at least this many bytes are mmap'd and grown with mremap (linux only), so a large
+/// vector never copies its contents when it grows. fixed at compile time: it decides how every
+/// live buffer was allocated.
+#ifndef KAIRO_VEC_MMAP_THRESHOLD
+#   define KAIRO_VEC_MMAP_THRESHOLD (usize(1) << 20)
+#endif
+
 H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+namespace __vector {
+/// growth factor in percent, see set_vector_growth.
+inline libcxx::atomic<u32> growth_percent{200};
+
+/// byte-level storage for trivially relocatable elements under the default allocator: malloc
+/// and realloc below the mmap threshold, mmap and mremap above it.
+struct RawStorage {
+    static bool mapped(usize bytes) noexcept {
+#if defined(__linux__)
+        return bytes >= KAIRO_VEC_MMAP_THRESHOLD;
+#else
+        (void)bytes;
+        return false;
+#endif
+    }
+
+    static usize page() noexcept {
+#if defined(__linux__)
+        static const usize size = static_cast<usize>(::sysconf(_SC_PAGESIZE));
+        return size;
+#else
+        return 4096;
+#endif
+    }
+
+    static usize map_length(usize bytes) noexcept { return (bytes + page() - 1) & ~(page() - 1); }
+
+    /// element count to actually allocate for a request of `count`: a mapped buffer uses the
+    /// rest of its last page.
+    static usize round_capacity(usize count, usize elem) noexcept {
+        usize bytes = count * elem;
+        return mapped(bytes) ? map_length(bytes) / elem : count;
+    }
+
+    static void *allocate(usize bytes) {
+#if defined(__linux__)
+        if (mapped(bytes)) {
+            void *p = ::mmap(nullptr, map_length(bytes), PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw libcxx::bad_alloc();
+            }
+            return p;
+        }
+#endif
+        void *p = libcxx::malloc(bytes != 0 ? bytes : 1);
+        if (p == nullptr) {
+            throw libcxx::bad_alloc();
+        }
+        return p;
+    }
+
+    static void deallocate(void *ptr, usize bytes) noexcept {
+        if (ptr == nullptr) {
+            return;
+        }
+#if defined(__linux__)
+        if (mapped(bytes)) {
+            ::munmap(ptr, map_length(bytes));
+            return;
+        }
+#endif
+        libcxx::free(ptr);
+    }
+
+    /// resize a block holding `used` live bytes, moving it if needed.
+    static void *resize(void *ptr, usize old_bytes, usize new_bytes, usize used) {
+        if (ptr == nullptr) {
+            return allocate(new_bytes);
+        }
+
+        const bool was = mapped(old_bytes);
+        const bool now = mapped(new_bytes);
+
+        if (!was && !now) {
+            void *p = libcxx::realloc(ptr, new_bytes != 0 ? new_bytes : 1);
+            if (p == nullptr) {
+                throw libcxx::bad_alloc();
+            }
+            return p;
+        }
+
+#if defined(__linux__)
+        if (was && now) {
+            // the kernel moves page table entries; the contents are never copied
+            void *p = ::mremap(ptr, map_length(old_bytes), map_length(new_bytes), MREMAP_MAYMOVE);
+            if (p == MAP_FAILED) {
+                throw libcxx::bad_alloc();
+            }
+            return p;
+        }
+#endif
+
+        // crossing the threshold: one copy between the two kinds of block
+        void *p = allocate(new_bytes);
+        libcxx::memcpy(p, ptr, used);
+        deallocate(ptr, old_bytes);
+        return p;
+    }
+};
+}  // namespace __vector
+
+/// growth factor applied when a Vector runs out of room, clamped to [1.125, 4]. lower factors
+/// waste less memory; realloc/mremap growth makes them cheaper than they are for std::vector.
+inline void set_vector_growth(double factor) noexcept {
+    factor = factor < 1.125 ? 1.125 : (factor > 4.0 ? 4.0 : factor);
+    __vector::growth_percent.store(static_cast<u32>(factor * 100.0), libcxx::memory_order_relaxed);
+}
+
+inline double vector_growth() noexcept {
+    return __vector::growth_percent.load(libcxx::memory_order_relaxed) / 100.0;
+}
+
+///
+/// \brief Kairo's growable array. It has the std::vector interface (it is what `vec` names
+///        when KAIRO_NATIVE_VEC is defined), plus:
+///
+/// - growth that never runs element constructors for trivially relocatable types (see
+///   Memory::is_trivially_relocatable): under the default allocator their buffer is grown with
+///   realloc, and above KAIRO_VEC_MMAP_THRESHOLD with mremap, which extends in place or moves
+///   pages without copying them;
+/// - a process-wide growth factor (set_vector_growth);
+/// - reserve_exact(), and unchecked_push()/unchecked_emplace() for loops that reserved first;
+/// - extend() from any range, including Kairo generators.
+///
+/// \code
+///   Vector<Token> toks;
+///   toks.reserve_exact(estimate);
+///   for (auto &t : lexer.tokens()) {
+///       toks.unchecked_push(t);  // caller guarantees capacity
+///   }
+///   toks.extend(lexer.trailing());  // a $generator<Token>
+/// \endcode
+///
+template <typename T, typename A>
+class Vector {
+    using traits = libcxx::allocator_traits<A>;
+
+    /// raw byte storage (realloc / mremap) applies only when it is indistinguishable from the
+    /// allocator: the default one, with an element type that moves bytewise.
+    static constexpr bool raw = libcxx::is_same_v<A, libcxx::allocator<T>> &&
+                                Memory::is_trivially_relocatable_v<T> &&
+                                alignof(T) <= alignof(libcxx::max_align_t);
+
+  public:
+    using value_type             = T;
+    using allocator_type         = A;
+    using size_type              = usize;
+    using difference_type        = libcxx::ptrdiff_t;
+    using reference              = T &;
+    using const_reference        = const T &;
+    using pointer                = T *;
+    using const_pointer          = const T *;
+    using iterator               = T *;
+    using const_iterator         = const T *;
+    using reverse_iterator       = libcxx::reverse_iterator<iterator>;
+    using const_reverse_iterator = libcxx::reverse_iterator<const_iterator>;
+
+    Vector() noexcept(noexcept(A())) = default;
+    explicit Vector(const A &alloc) noexcept
+        : alloc_(alloc) {}
+
+    explicit Vector(usize count, const A &alloc = A())
+        : alloc_(alloc) {
+        resize(count);
+    }
+
+    Vector(usize count, const T &value, const A &alloc = A())
+        : alloc_(alloc) {
+        assign(count, value);
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    Vector(It first, It last, const A &alloc = A())
+        : alloc_(alloc) {
+        assign(first, last);
+    }
+
+    Vector(libcxx::initializer_list<T> init, const A &alloc = A())
+        : alloc_(alloc) {
+        assign(init.begin(), init.end());
+    }
+
+#if defined(__cpp_lib_containers_ranges)
+    template <typename R>
+    Vector(libcxx::from_range_t /*unused*/, R &&range, const A &alloc = A())
+        : alloc_(alloc) {
+        extend(std::Memory::forward<R>(range));
+    }
+#endif
+
+    Vector(const Vector &other)
+        : alloc_(traits::select_on_container_copy_construction(other.alloc_)) {
+        assign(other.begin(), other.end());
+    }
+
+    Vector(Vector &&other) noexcept
+        : begin_(libcxx::exchange(other.begin_, nullptr))
+        , end_(libcxx::exchange(other.end_, nullptr))
+        , cap_(libcxx::exchange(other.cap_, nullptr))
+        , alloc_(libcxx::move(other.alloc_)) {}
+
+    Vector &operator=(const Vector &other) {
+        if (this != &other) {
+            if constexpr (traits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != other.alloc_) {
+                    clear();
+                    release();
+                }
+                alloc_ = other.alloc_;
+            }
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    Vector &operator=(Vector &&other) noexcept(
+        traits::propagate_on_container_move_assignment::value || traits::is_always_equal::value) {
+        if (this == &other) {
+            return *this;
+        }
+
+        if constexpr (traits::propagate_on_container_move_assignment::value ||
+                      traits::is_always_equal::value) {
+            clear();
+            release();
+            if constexpr (traits::propagate_on_container_move_assignment::value) {
+                alloc_ = libcxx::move(other.alloc_);
+            }
+            steal(other);
+        } else {
+            if (alloc_ == other.alloc_) {
+                clear();
+                release();
+                steal(other);
+            } else {
+                assign(libcxx::make_move_iterator(other.begin()),
+                       libcxx::make_move_iterator(other.end()));
+            }
+        }
+        return *this;
+    }
+
+    Vector &operator=(libcxx::initializer_list<T> init) {
+        assign(init.begin(), init.end());
+        return *this;
+    }
+
+    ~Vector() {
+        clear();
+        release();
+    }
+
+    void assign(usize count, const T &value) {
+        if (&value >= begin_ && &value < end_) {
+            T copy(value);  // clear() would destroy it
+            assign(count, copy);
+            return;
+        }
+
+        clear();
+        reserve_exact(count);
+        for (usize i = 0; i < count; ++i) {
+            construct(end_, value);
+            ++end_;
+        }
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    void assign(It first, It last) {
+        clear();
+        if constexpr (libcxx::is_base_of_v<
+                          libcxx::forward_iterator_tag,
+                          typename libcxx::iterator_traits<It>::iterator_category>) {
+            reserve_exact(static_cast<usize>(libcxx::distance(first, last)));
+            for (; first != last; ++first) {
+                construct(end_, *first);
+                ++end_;
+            }
+        } else {
+            for (; first != last; ++first) {
+                emplace_back(*first);
+            }
+        }
+    }
+
+    void assign(libcxx::initializer_list<T> init) { assign(init.begin(), init.end()); }
+
+    template <typename R>
+    void assign_range(R &&range) {
+        clear();
+        extend(std::Memory::forward<R>(range));
+    }
+
+    A get_allocator() const noexcept { return alloc_; }
+
+    // element access
+
+    T       &operator[](usize i) noexcept { return begin_[i]; }
+    const T &operator[](usize i) const noexcept { return begin_[i]; }
+
+    T &at(usize i) {
+        if (i >= size()) {
+            throw libcxx::out_of_range("Vector::at: index " + libcxx::to_string(i) +
+                                       " >= size " + libcxx::to_string(size()));
+        }
+        return begin_[i];
+    }
+
+    const T &at(usize i) const { return const_cast<Vector *>(this)->at(i); }
+
+    T       &front() noexcept { return *begin_; }
+    const T &front() const noexcept { return *begin_; }
+    T       &back() noexcept { return end_[-1]; }
+    const T &back() const noexcept { return end_[-1]; }
+
+    T       *data() noexcept { return begin_; }
+    const T *data() const noexcept { return begin_; }
+
+    // iterators
+
+    iterator       begin() noexcept { return begin_; }
+    const_iterator begin() const noexcept { return begin_; }
+    const_iterator cbegin() const noexcept { return begin_; }
+    iterator       end() noexcept { return end_; }
+    const_iterator end() const noexcept { return end_; }
+    const_iterator cend() const noexcept { return end_; }
+
+    reverse_iterator       rbegin() noexcept { return reverse_iterator(end_); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end_); }
+    const_reverse_iterator crbegin() const noexcept { return const_reverse_iterator(end_); }
+    reverse_iterator       rend() noexcept { return reverse_iterator(begin_); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin_); }
+    const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin_); }
+
+    // capacity
+
+    bool  empty() const noexcept { return begin_ == end_; }
+    bool  is_empty() const noexcept { return begin_ == end_; }
+    usize size() const noexcept { return static_cast<usize>(end_ - begin_); }
+    usize capacity() const noexcept { return static_cast<usize>(cap_ - begin_); }
+
+    usize max_size() const noexcept {
+        usize by_alloc = traits::max_size(alloc_);
+        usize by_bytes = usize(libcxx::numeric_limits<libcxx::ptrdiff_t>::max()) / sizeof(T);
+        return by_alloc < by_bytes ? by_alloc : by_bytes;
+    }
+
+    /// room for at least `count` elements. grows geometrically like push_back does, so calling
+    /// it before every batch of appends stays amortized O(1); use reserve_exact() when the
+    /// final size is known.
+    void reserve(usize count) { reserve_for(count); }
+
+    /// room for exactly `count` elements (rounded up to a whole page for mmap'd buffers).
+    void reserve_exact(usize count) {
+        if (count > capacity()) {
+            reallocate(count);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (capacity() > size()) {
+            if (empty()) {
+                release();
+            } else {
+                reallocate(size());
+            }
+        }
+    }
+
+    // modifiers
+
+    void clear() noexcept {
+        destroy(begin_, end_);
+        end_ = begin_;
+    }
+
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(libcxx::move(value)); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        if (end_ == cap_) [[unlikely]] {
+            return grow_emplace_back(std::Memory::forward<Args>(args)...);
+        }
+
+        construct(end_, std::Memory::forward<Args>(args)...);
+        return *end_++;
+    }
+
+    /// push without a capacity check; the caller has reserved room.
+    void unchecked_push(const T &value) { unchecked_emplace(value); }
+    void unchecked_push(T &&value) { unchecked_emplace(libcxx::move(value)); }
+
+    template <typename... Args>
+    T &unchecked_emplace(Args &&...args) {
+        assert(end_ != cap_ && "Vector::unchecked_emplace: no capacity left");
+        construct(end_, std::Memory::forward<Args>(args)...);
+        return *end_++;
+    }
+
+    void pop_back() noexcept {
+        --end_;
+        destroy(end_, end_ + 1);
+    }
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args &&...args) {
+        const usize at = static_cast<usize>(pos - begin_);
+        if (begin_ + at == end_) {
+            emplace_back(std::Memory::forward<Args>(args)...);
+            return begin_ + at;
+        }
+
+        if constexpr (Memory::is_trivially_relocatable_v<T>) {
+            // build the value first (args may refer into the buffer), then open a gap with one
+            // memmove and relocate it in
+            alignas(T) unsigned char tmp[sizeof(T)];  // NOLINT
+            T *value = ::new (static_cast<void *>(tmp)) T(std::Memory::forward<Args>(args)...);
+
+            if (end_ == cap_) {
+                try {
+                    reallocate(next_capacity(size() + 1));
+                } catch (...) {
+                    value->~T();
+                    throw;
+                }
+            }
+
+            libcxx::memmove(static_cast<void *>(begin_ + at + 1),
+                            static_cast<void *>(begin_ + at), (size() - at) * sizeof(T));
+            libcxx::memcpy(static_cast<void *>(begin_ + at), tmp, sizeof(T));
+            ++end_;
+        } else {
+            emplace_back(std::Memory::forward<Args>(args)...);
+            libcxx::rotate(begin_ + at, end_ - 1, end_);
+        }
+        return begin_ + at;
+    }
+
+    iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+    iterator insert(const_iterator pos, T &&value) { return emplace(pos, libcxx::move(value)); }
+
+    iterator insert(const_iterator pos, usize count, const T &value) {
+        const usize at = static_cast<usize>(pos - begin_);
+        T           copy(value);
+        reserve_for(size() + count);
+        for (usize i = 0; i < count; ++i) {
+            construct(end_, copy);
+            ++end_;
+        }
+        libcxx::rotate(begin_ + at, end_ - count, end_);
+        return begin_ + at;
+    }
+
+    template <typename It>
+        requires(!libcxx::is_integral_v<It>)
+    iterator insert(const_iterator pos, It first, It last) {
+        const usize at  = static_cast<usize>(pos - begin_);
+        const usize old = size();
+        if constexpr (libcxx::is_base_of_v<
+                          libcxx::forward_iterator_tag,
+                          typename libcxx::iterator_traits<It>::iterator_category>) {
+            reserve_for(old + static_cast<usize>(libcxx::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        libcxx::rotate(begin_ + at, begin_ + old, end_);
+        return begin_ + at;
+    }
+
+    iterator insert(const_iterator pos, libcxx::initializer_list<T> init) {
+        return insert(pos, init.begin(), init.end());
+    }
+
+    template <typename R>
+    iterator insert_range(const_iterator pos, R &&range) {
+        const usize at  = static_cast<usize>(pos - begin_);
+        const usize old = size();
+        extend(std::Memory::forward<R>(range));
+        libcxx::rotate(begin_ + at, begin_ + old, end_);
+        return begin_ + at;
+    }
+
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        T *from = begin_ + (first - begin_);
+        T *to   = begin_ + (last - begin_);
+        if (from == to) {
+            return from;
+        }
+
+        if constexpr (Memory::is_trivially_relocatable_v<T>) {
+            destroy(from, to);
+            libcxx::memmove(static_cast<void *>(from), static_cast<void *>(to),
+                            static_cast<usize>(end_ - to) * sizeof(T));
+            end_ -= (to - from);
+        } else {
+            T *tail = libcxx::move(to, end_, from);
+            destroy(tail, end_);
+            end_ = tail;
+        }
+        return from;
+    }
+
+    void resize(usize count) {
+        if (count <= size()) {
+            destroy(begin_ + count, end_);
+            end_ = begin_ + count;
+            return;
+        }
+
+        reserve_for(count);
+        for (T *stop = begin_ + count; end_ != stop; ++end_) {
+            construct(end_);
+        }
+    }
+
+    void resize(usize count, const T &value) {
+        if (count <= size()) {
+            resize(count);
+            return;
+        }
+
+        T copy(value);
+        reserve_for(count);
+        for (T *stop = begin_ + count; end_ != stop; ++end_) {
+            construct(end_, copy);
+        }
+    }
+
+    /// append every element of `range`: a container, a view, or a $generator. sized ranges
+    /// reserve once up front.
+    template <typename R>
+    Vector &extend(R &&range) {
+        if constexpr (libcxx::ranges::sized_range<R>) {
+            reserve_for(size() + static_cast<usize>(libcxx::ranges::size(range)));
+        }
+        for (auto &&item : range) {
+            emplace_back(std::Memory::forward<decltype(item)>(item));
+        }
+        return *this;
+    }
+
+    template <typename R>
+    void append_range(R &&range) {
+        extend(std::Memory::forward<R>(range));
+    }
+
+    void swap(Vector &other) noexcept {
+        libcxx::swap(begin_, other.begin_);
+        libcxx::swap(end_, other.end_);
+        libcxx::swap(cap_, other.cap_);
+        if constexpr (traits::propagate_on_container_swap::value) {
+            libcxx::swap(alloc_, other.alloc_);
+        }
+    }
+
+    friend void swap(Vector &a, Vector &b) noexcept { a.swap(b); }
+
+    operator libcxx::span<T>() noexcept { return {begin_, size()}; }              // NOLINT
+    operator libcxx::span<const T>() const noexcept { return {begin_, size()}; }  // NOLINT
+
+    friend bool operator==(const Vector &a, const Vector &b) {
+        return a.size() == b.size() && libcxx::equal(a.begin(), a.end(), b.begin());
+    }
+
+    friend auto operator<=>(const Vector &a, const Vector &b)
+        requires libcxx::three_way_comparable<T>
+    {
+        return libcxx::lexicographical_compare_three_way(a.begin(), a.end(), b.begin(), b.end());
+    }
+
+  private:
+    template <typename... Args>
+    void construct(T *at, Args &&...args) {
+        traits::construct(alloc_, at, std::Memory::forward<Args>(args)...);
+    }
+
+    void destroy(T *first, T *last) noexcept {
+        if constexpr (!libcxx::is_trivially_destructible_v<T>) {
+            for (; first != last; ++first) {
+                traits::destroy(alloc_, first);
+            }
+        }
+    }
+
+    usize next_capacity(usize need) const {
+        if (need > max_size()) {
+            throw libcxx::length_error("Vector: capacity overflow");
+        }
+
+        const usize cap    = capacity();
+        const u64   factor = __vector::growth_percent.load(libcxx::memory_order_relaxed);
+        usize       grown  = static_cast<usize>(cap * factor / 100);
+        usize       floor  = sizeof(T) < 64 ? 64 / sizeof(T) : 1;  // first block: a cache line
+
+        grown = grown > max_size() ? max_size() : grown;
+        grown = grown > need ? grown : need;
+        return grown > floor ? grown : floor;
+    }
+
+    /// make room for `count` elements, growing geometrically.
+    void reserve_for(usize count) {
+        if (count > capacity()) {
+            reallocate(next_capacity(count));
+        }
+    }
+
+    /// move the elements into a block of `count` slots (count >= size()).
+    void reallocate(usize count) {
+        if (count > max_size()) {
+            throw libcxx::length_error("Vector: capacity overflow");
+        }
+
+        const usize n = size();
+
+        if constexpr (raw) {
+            count       = __vector::RawStorage::round_capacity(count, sizeof(T));
+            void *block = __vector::RawStorage::resize(begin_, capacity() * sizeof(T),
+                                                       count * sizeof(T), n * sizeof(T));
+            begin_      = static_cast<T *>(block);
+        } else {
+            T *fresh = traits::allocate(alloc_, count);
+            try {
+                move_into(fresh, n);
+            } catch (...) {
+                traits::deallocate(alloc_, fresh, count);
+                throw;
+            }
+            if (begin_ != nullptr) {
+                traits::deallocate(alloc_, begin_, capacity());
+            }
+            begin_ = fresh;
+        }
+
+        end_ = begin_ + n;
+        cap_ = begin_ + count;
+    }
+
+    /// relocate the n current elements into `fresh`. types that are neither trivially
+    /// relocatable nor nothrow-movable are copied when they can be, for the strong guarantee:
+    /// on a throw the copies made so far are destroyed and the caller still owns `fresh`.
+    void move_into(T *fresh, usize n) {
+        if constexpr (Memory::is_trivially_relocatable_v<T> ||
+                      libcxx::is_nothrow_move_constructible_v<T> ||
+                      !libcxx::is_copy_constructible_v<T>) {
+            Memory::relocate(fresh, begin_, n);
+        } else {
+            usize done = 0;
+            try {
+                for (; done < n; ++done) {
+                    traits::construct(alloc_, fresh + done, begin_[done]);
+                }
+            } catch (...) {
+                for (usize i = 0; i < done; ++i) {
+                    traits::destroy(alloc_, fresh + i);
+                }
+                throw;
+            }
+            destroy(begin_, end_);
+        }
+    }
+
+    template <typename... Args>
+    T &grow_emplace_back(Args &&...args) {
+        const usize n = size();
+
+        if constexpr (raw) {
+            // build the value before the buffer moves, since args may refer to an element
+            alignas(T) unsigned char tmp[sizeof(T)];  // NOLINT
+            T *value = ::new (static_cast<void *>(tmp)) T(std::Memory::forward<Args>(args)...);
+
+            try {
+                reallocate(next_capacity(n + 1));
+            } catch (...) {
+                value->~T();
+                throw;
+            }
+            libcxx::memcpy(static_cast<void *>(end_), tmp, sizeof(T));
+            return *end_++;
+        } else {
+            const usize count = next_capacity(n + 1);
+            T          *fresh = traits::allocate(alloc_, count);
+
+            try {
+                traits::construct(alloc_, fresh + n, std::Memory::forward<Args>(args)...);
+            } catch (...) {
+                traits::deallocate(alloc_, fresh, count);
+                throw;
+            }
+
+            try {
+                move_into(fresh, n);
+            } catch (...) {
+                traits::destroy(alloc_, fresh + n);
+                traits::deallocate(alloc_, fresh, count);
+                throw;
+            }
+
+            if (begin_ != nullptr) {
+                traits::deallocate(alloc_, begin_, capacity());
+            }
+            begin_ = fresh;
+            end_   = fresh + n + 1;
+            cap_   = fresh + count;
+            return fresh[n];
+        }
+    }
+
+    void release() noexcept {
+        if (begin_ == nullptr) {
+            return;
+        }
+        if constexpr (raw) {
+            __vector::RawStorage::deallocate(begin_, capacity() * sizeof(T));
+        } else {
+            traits::deallocate(alloc_, begin_, capacity());
+        }
+        begin_ = end_ = cap_ = nullptr;
+    }
+
+    void steal(Vector &other) noexcept {
+        begin_ = libcxx::exchange(other.begin_, nullptr);
+        end_   = libcxx::exchange(other.end_, nullptr);
+        cap_   = libcxx::exchange(other.cap_, nullptr);
+    }
+
+    T *begin_{nullptr};
+    T *end_{nullptr};
+    T *cap_{nullptr};
+
+    [[no_unique_address]] A alloc_{};
+};
+
+template <typename T, typename A, typename U>
+usize erase(Vector<T, A> &v, const U &value) {
+    auto it   = libcxx::remove(v.begin(), v.end(), value);
+    usize out = static_cast<usize>(v.end() - it);
+    v.erase(it, v.end());
+    return out;
+}
+
+template <typename T, typename A, typename Pred>
+usize erase_if(Vector<T, A> &v, Pred pred) {
+    auto it   = libcxx::remove_if(v.begin(), v.end(), pred);
+    usize out = static_cast<usize>(v.end() - it);
+    v.erase(it, v.end());
+    return out;
+}
+
+H_STD_NAMESPACE_END
+
+namespace std::Memory {
+/// a Vector is three pointers into its own heap block.
+template <typename T, typename A>
+struct is_trivially_relocatable<Vector<T, A>>
+    : libcxx::bool_constant<is_trivially_relocatable_v<A>> {};
+}  // namespace std::Memory
 
 H_NAMESPACE_END
 
@@ -0,0 +1,30 @@
+/// --- The Kairo Project -------------------------------------------------- ///
+///
+///   Part of the Kairo Project, under the Apache License v2.0 with the
+///   Kairo Runtime Library Exception.
+///
+///   See: https://www.kairolang.org/LICENSE.txt
+///   SPDX-License-Identifier: Apache-2.0 WITH KAIRO-RUNTIME-EXCEPTION
+///   Copyright (c) 2026 Dhruvan Kartik
+///
+/// ------------------------------------------------------------------------ ///
+
+#ifndef _$_HX_CORE_M10VECTOR_FWD
+#define _$_HX_CORE_M10VECTOR_FWD
+
+#include <include/config/config.hh>
+
+#include <memory>
+
+H_NAMESPACE_BEGIN
+H_STD_NAMESPACE_BEGIN
+
+/// see types/vector/vector.hh. declared here so primitives.hh can point `vec` at it when
+/// KAIRO_NATIVE_VEC is defined.
+template <typename T, typename A = libcxx::allocator<T>>
+class Vector;
+
+H_STD_NAMESPACE_END
+H_NAMESPACE_END
+
+#endif  // _$_HX_CORE_M10VECTOR_FWD